@@ -71,6 +71,11 @@ typedef unsigned int R3D_Flags;
 #define R3D_FLAG_TRANSPARENT_SORTING    (1 << 8)    /**< Back-to-front sorting of transparent objects for correct blending of non-discarded fragments. Be careful, in 'force forward' mode this flag will also sort opaque objects in 'near-to-far' but in the same sorting pass. */
 #define R3D_FLAG_OPAQUE_SORTING         (1 << 9)    /**< Front-to-back sorting of opaque objects to optimize depth testing at the cost of additional sorting. Please note, in 'force forward' mode this flag has no effect, see transparent sorting. */
 #define R3D_FLAG_LOW_PRECISION_BUFFERS  (1 << 10)   /**< Use 32-bit HDR formats like R11G11B10F for intermediate color buffers instead of full 16-bit floats. Saves memory and bandwidth. */
+#define R3D_FLAG_PRESKINNING            (1 << 11)   /**< Skins the animated meshes seen by the camera or by a shadow map once per frame with transform feedback, every pass (G-Buffer, forward, depth, shadows) then reads the skinned vertices like a static mesh. Costs 40 bytes of GPU memory per skinned vertex drawn. */
+#define R3D_FLAG_HALF_PRECISION_BONES   (1 << 12)   /**< Uploads the bone matrices of animated models as 16-bit floats, halving the skinning bandwidth. Translations lose precision far from the model origin. */
+#define R3D_FLAG_INSTANCE_SORTING       (1 << 13)   /**< Draws the instances of transparent instanced draw calls from back to front, by the view depth of their origin. Instances read from GPU particle buffers keep their order. */
+#define R3D_FLAG_SPRITE_BATCHING        (1 << 14)   /**< Gathers the sprites drawn with `R3D_DrawSprite`, `R3D_DrawSpriteEx` and `R3D_DrawSpritePro` by material, each group being drawn with a single instanced draw call in every pass, billboarding being computed by the GPU and the texture coordinates of each frame being sent as instance parameters. Transparent sprites are then only sorted within their group, see `R3D_FLAG_INSTANCE_SORTING`. */
+#define R3D_FLAG_GPU_INSTANCE_CULLING   (1 << 15)   /**< Culls the instances of large instanced draw calls against the camera and shadow frusta with a compute shader, the visible ones being drawn with an indirect draw call without any read back. Requires OpenGL 4.3, ignored otherwise. The instances are uploaded once per frame, each pass only running the culling. Animated instances, packed instances, instances read from GPU buffers and non-opaque instances, whose visible order would not be stable, are drawn without it. */
 
 /**
  * @brief Blend modes for rendering.
@@ -206,6 +211,63 @@ typedef struct R3D_Vertex {
     float weights[4];       /**< Corresponding bone weights (should sum to 1.0). Defines the influence of each bone. */
 } R3D_Vertex;
 
+/**
+ * @brief Represents a contiguous range of indices within a mesh.
+ *
+ * Ranges are created when several source meshes are merged into a single mesh
+ * at load time. Each range keeps its own bounding box so that the parts of a
+ * merged mesh can still be culled individually.
+ */
+typedef struct R3D_MeshRange {
+    int indexOffset;        /**< Offset of the first index of the range in the index buffer. */
+    int indexCount;         /**< Number of indices in the range. */
+    BoundingBox aabb;       /**< Axis-Aligned Bounding Box of the range in local space. */
+} R3D_MeshRange;
+
+/**
+ * @brief Describes a cluster of up to 128 triangles of a mesh.
+ *
+ * Meshlets are contiguous index sub-ranges generated by R3D_GenMeshMeshlets().
+ * Each one keeps a bounding sphere and a normal cone, so that clusters outside
+ * the view or entirely facing away from it can be skipped in every pass.
+ */
+typedef struct R3D_Meshlet {
+    int indexOffset;        /**< Offset of the first index of the meshlet in the index buffer. */
+    int indexCount;         /**< Number of indices in the meshlet (at most 128 triangles). */
+    Vector3 center;         /**< Center of the bounding sphere in local space. */
+    float radius;           /**< Radius of the bounding sphere. */
+    Vector3 coneAxis;       /**< Average direction of the triangle normals. */
+    float coneCutoff;       /**< Sine of the normal cone spread angle, 1 or more disables cone culling. */
+} R3D_Meshlet;
+
+/**
+ * @brief Describes a simplified level of detail of a mesh.
+ *
+ * Levels of detail are generated by R3D_GenMeshLODs(). They index the vertices
+ * of their mesh with their own index buffer, from the finest to the coarsest.
+ * When their mesh is culled per meshlet or per sub-range, each level is partitioned
+ * into its own meshlets so that it is culled the same way.
+ */
+typedef struct R3D_MeshLOD {
+    unsigned int* indices;  /**< Pointer to the array of indices of the level. */
+    int indexCount;         /**< Number of indices of the level. */
+    unsigned int ebo;       /**< Element Buffer Object of the level (GPU handle). */
+    float error;            /**< Geometric error of the level relative to the full mesh, in local units. */
+    R3D_Meshlet* meshlets;  /**< Optional triangle clusters of the level, culled individually when drawn (can be NULL). */
+    int meshletCount;       /**< Number of meshlets of the level. */
+} R3D_MeshLOD;
+
+/**
+ * @brief Bind pose bounds of the vertices influenced by one bone of a skinned mesh.
+ *
+ * Bone bounds are generated by R3D_GenMeshBoneBounds(). Each frame, the bounds are moved
+ * by the skinning matrices of their bone, and their union bounds the animated mesh.
+ */
+typedef struct R3D_BoneBounds {
+    int bone;               /**< Index of the bone in the skinning matrices of the model. */
+    BoundingBox aabb;       /**< Bounds of the vertices weighted by the bone, in bind pose local space. */
+} R3D_BoneBounds;
+
 /**
  * @brief Represents a mesh with its geometry data and GPU buffers.
  *
@@ -223,11 +285,22 @@ typedef struct R3D_Mesh {
     unsigned int ebo;       /**< Element Buffer Object (GPU handle). */
     unsigned int vao;       /**< Vertex Array Object (GPU handle). */
 
-    Matrix* boneMatrices;   /**< Cached animation matrices for all passes. */
-    int boneCount;          /**< Number of bones (and matrices) that affect the mesh. */
+    int boneCount;          /**< Number of bones that affect the mesh. */
 
     BoundingBox aabb;       /**< Axis-Aligned Bounding Box in local space. */
 
+    R3D_MeshRange* ranges;  /**< Optional index sub-ranges, culled individually when drawn (can be NULL). */
+    int rangeCount;         /**< Number of index sub-ranges. */
+
+    R3D_Meshlet* meshlets;  /**< Optional triangle clusters, culled individually when drawn (can be NULL). */
+    int meshletCount;       /**< Number of meshlets. */
+
+    R3D_MeshLOD* lods;      /**< Optional simplified levels of detail, coarser as the index grows (can be NULL). */
+    int lodCount;           /**< Number of simplified levels of detail, the full mesh excluded. */
+
+    R3D_BoneBounds* boneBounds; /**< Optional bounds per influencing bone, bounding the mesh while animated (can be NULL). */
+    int boneBoundsCount;        /**< Number of bone bounds. */
+
 } R3D_Mesh;
 
 /**
@@ -268,37 +341,140 @@ typedef struct R3D_Material {
 
     Vector2 uvOffset;                     /**< UV offset applied to the texture coordinates.
                                            *  For models, this can be set manually.
-                                           *  For sprites, this value is overridden automatically.
+                                           *  For sprites, the current frame is mapped within this transform.
                                            */
 
     Vector2 uvScale;                      /**< UV scale factor applied to the texture coordinates.
                                            *  For models, this can be set manually.
-                                           *  For sprites, this value is overridden automatically.
+                                           *  For sprites, the current frame is mapped within this transform.
                                            */
 
     float alphaCutoff;          /**< Alpha threshold below which fragments are discarded. */
 
 } R3D_Material;
 
+/**
+ * @brief Quantized keys of one transform component of an animated bone.
+ *
+ * The keys of a channel are stored in the key data of their animation, starting at `keyOffset`:
+ * first the frame index of every key, then the quantized values of every key
+ * (3 words per key for translations and scales, 4 signed words per key for rotations).
+ * Values are linearly interpolated between keys.
+ */
+typedef struct R3D_AnimationChannel {
+    int keyCount;           /**< Number of keys of the channel, at least one. */
+    int keyOffset;          /**< Offset of the channel in the key data of the animation, in 16-bit words. */
+    Vector3 offset;         /**< Dequantization offset of translation and scale values. */
+    Vector3 scale;          /**< Dequantization scale of translation and scale values. */
+} R3D_AnimationChannel;
+
+/**
+ * @brief Compressed local transform of an animated bone, relative to its parent bone.
+ */
+typedef struct R3D_AnimationTrack {
+    R3D_AnimationChannel translation;   /**< Translation keys. */
+    R3D_AnimationChannel rotation;      /**< Rotation (quaternion) keys. */
+    R3D_AnimationChannel scale;         /**< Scale keys. */
+} R3D_AnimationTrack;
+
 /**
  * @brief Represents a skeletal animation for a model.
  *
- * This structure holds the animation data for a skinned model,
- * including per-frame bone transformation poses.
+ * This structure holds the animation data for a skinned model. Each bone has a track of
+ * quantized translation, rotation and scale keys relative to its parent bone, from which
+ * redundant keys have been removed at load time. Poses are reconstructed when sampled,
+ * see R3D_GetModelAnimationPose().
+ *
+ * Bone transforms are decomposed into translation, rotation and scale on loading,
+ * a shear in the source animation is dropped (a warning is logged when it happens).
  */
 typedef struct R3D_ModelAnimation {
 
-    int boneCount;          /**< Number of bones in the skeleton affected by this animation. */
-    int frameCount;         /**< Total number of frames in the animation sequence. */
+    int boneCount;                  /**< Number of bones in the skeleton affected by this animation. */
+    int frameCount;                 /**< Total number of frames in the animation sequence. */
+
+    BoneInfo* bones;                /**< Array of bone metadata (name, parent index) that defines the skeleton hierarchy. */
+    int* boneOrder;                 /**< Bone indices sorted so that every parent comes before its children. */
+
+    R3D_AnimationTrack* tracks;     /**< Compressed local transform tracks, one per bone. */
+    unsigned short* keyData;        /**< Frame indices and quantized values of the keys of all tracks. */
+    int keyDataSize;                /**< Number of 16-bit words in the key data. */
 
-    BoneInfo* bones;        /**< Array of bone metadata (name, parent index, etc.) that defines the skeleton hierarchy. */
-    Matrix** framePoses;    /**< 2D array of transformation matrices: [frame][bone].
-                                 Each matrix represents the pose of a bone in a specific frame, typically in local space. */
+    Matrix** framePoses;            /**< Optional poses of every frame: [frame][bone], in model space before the bone offsets.
+                                         NULL until materialized with R3D_LoadModelAnimationFramePoses(). */
 
-    char name[32];          /**< Name identifier for the animation (e.g., "Walk", "Jump", etc.). */
+    char name[32];                  /**< Name identifier for the animation (e.g., "Walk", "Jump", etc.). */
 
 } R3D_ModelAnimation;
 
+/**
+ * @brief One clip contributing to a blended skeletal pose.
+ *
+ * Regular layers are cross-faded together according to their weights.
+ * Additive layers are applied on top of the result as the difference between
+ * the sampled frame and the first frame of their clip, scaled by their weight.
+ * All the layers blended together must share the same skeleton.
+ */
+typedef struct R3D_AnimationLayer {
+    const R3D_ModelAnimation* anim; /**< Animation clip sampled by the layer. */
+    float frame;                    /**< Fractional frame to sample, wrapped around the frame count of the clip. */
+    float weight;                   /**< Blend weight of the layer. */
+    bool additive;                  /**< If true, the layer is added to the other layers instead of being cross-faded. */
+} R3D_AnimationLayer;
+
+/**
+ * @brief Skinning matrices of every frame of a set of animations, stored on the GPU.
+ *
+ * Each clip is baked at its key rate with the bone offsets of a model already applied,
+ * so instances drawn with R3D_DrawModelInstancedAnimated() can each play their own clip
+ * at their own time without any per-instance work on the CPU besides picking the frames.
+ */
+typedef struct R3D_AnimationTexture {
+    unsigned int buffer;            /**< GPU buffer holding `boneCount` matrices per baked frame. */
+    unsigned int texture;           /**< Buffer texture giving the shaders access to the matrices. */
+    int boneCount;                  /**< Number of matrices per baked frame. */
+    int frameCount;                 /**< Total number of baked frames, all clips included. */
+    int clipCount;                  /**< Number of baked clips. */
+    int* clipFirstFrames;           /**< Index of the first baked frame of each clip. */
+    int* clipFrameCounts;           /**< Number of baked frames of each clip. */
+    BoundingBox aabb;               /**< Bounds of the model over every baked frame, from the bone bounds of its meshes. */
+} R3D_AnimationTexture;
+
+/**
+ * @brief Animation state of one instance drawn with R3D_DrawModelInstancedAnimated().
+ */
+typedef struct R3D_InstanceAnimation {
+    int clip;                       /**< Index of the clip in the animation texture. */
+    float frame;                    /**< Fractional frame, wrapped around the frame count of the clip. */
+} R3D_InstanceAnimation;
+
+/**
+ * @brief Positions and normals of every vertex of a model for every frame of a clip, stored on the GPU.
+ *
+ * Vertex animations replace skinning entirely: the shaders only fetch and interpolate the
+ * baked vertices, so crowds drawn with R3D_DrawModelInstancedVertexAnimated() cost about as
+ * much as static meshes. Deformations that cannot be expressed with bones (cloth, foliage,
+ * destruction) can be provided directly with R3D_LoadVertexAnimation().
+ *
+ * Within a frame, the vertices of the meshes of the model follow each other in mesh order.
+ */
+typedef struct R3D_VertexAnimation {
+    unsigned int buffer;            /**< GPU buffer holding a position and a normal per vertex and per frame. */
+    unsigned int texture;           /**< Buffer texture giving the shaders access to the vertices. */
+    int vertexCount;                /**< Number of vertices per frame, all meshes of the model included. */
+    int frameCount;                 /**< Number of baked frames. */
+    BoundingBox aabb;               /**< Bounds of the vertices over every frame. */
+} R3D_VertexAnimation;
+
+/**
+ * @brief Internal state of the animation level of detail of a model.
+ *
+ * Holds the poses evaluated ahead of time for models whose animation is updated
+ * less than every frame, see R3D_SetAnimationLOD(). A model drawn several times per frame
+ * keeps a separate state for each draw, matched by the order of the draws within the frame.
+ */
+typedef struct R3D_AnimationCache R3D_AnimationCache;
+
 /**
  * @brief Represents a complete 3D model with meshes and materials.
  *
@@ -322,6 +498,12 @@ typedef struct R3D_Model {
 
     const R3D_ModelAnimation* anim; /**< Pointer to the currently assigned animation for this model (optional). */
     int animFrame;                  /**< Current animation frame index. Used for sampling bone poses from the animation. */
+    float animTime;                 /**< Fraction of frame added to 'animFrame', interpolating between keys (0 by default). */
+
+    const R3D_AnimationLayer* animLayers;   /**< Optional clips blended together, used instead of 'anim' when set (can be NULL). */
+    int animLayerCount;                     /**< Number of blended animation layers. */
+
+    R3D_AnimationCache* animCache;  /**< Poses cached by the animation level of detail, allocated on load for skinned models (can be NULL). */
 
 } R3D_Model;
 
@@ -361,6 +543,46 @@ typedef struct R3D_Sprite {
     int yFrameCount;        ///< The number of frames along the vertical (Y) axis of the texture.
 } R3D_Sprite;
 
+/**
+ * @brief Texture packing several images, so that materials using them can share a single texture.
+ *
+ * Each image occupies a region of the atlas surrounded by a gutter repeating its border pixels,
+ * so that filtering never blends neighboring regions. A material is pointed to a region
+ * with `R3D_SetMaterialAtlasRegion`, which maps its texture coordinates within the region.
+ */
+typedef struct R3D_TextureAtlas {
+    Texture2D texture;      ///< Texture holding every packed image.
+    Rectangle* regions;     ///< Area of each image in the texture, in pixels and in the order of the packed images. Empty for an image that could not be packed.
+    int regionCount;        ///< Number of regions.
+} R3D_TextureAtlas;
+
+/**
+ * @brief Represents an octahedral impostor of a model.
+ *
+ * An impostor stores views of a model captured from directions spread over an octahedron,
+ * packed in a grid of `frames` x `frames` views. Each texture has the same layout as the
+ * G-Buffer, so distant instances can be rendered as camera-facing quads that write the same
+ * data as the full model.
+ */
+typedef struct R3D_Impostor {
+    Texture2D albedo;       ///< Atlas of the albedo of each view.
+    Texture2D emission;     ///< Atlas of the emission of each view.
+    Texture2D normal;       ///< Atlas of the normals of each view (model space, octahedral encoded).
+    Texture2D orm;          ///< Atlas of the occlusion, roughness and metalness of each view.
+    Texture2D depth;        ///< Atlas of the depth of each view, relative to the bounding sphere (1.0 means empty).
+    int frames;             ///< Number of views along each side of the atlas.
+    Vector3 center;         ///< Center of the bounding sphere of the model, in model space.
+    float radius;           ///< Radius of the bounding sphere of the model.
+} R3D_Impostor;
+
+/**
+ * @brief Number of intervals of the lookup table baked for each interpolation curve.
+ *
+ * The table holds `R3D_CURVE_LUT_RESOLUTION + 1` values, evenly spaced over the normalized time range [0, 1].
+ * Keyframes placed on a multiple of `1 / R3D_CURVE_LUT_RESOLUTION` are reproduced exactly.
+ */
+#define R3D_CURVE_LUT_RESOLUTION 256
+
 /**
  * @brief Represents a keyframe in an interpolation curve.
  *
@@ -378,50 +600,117 @@ typedef struct R3D_Keyframe {
  * This structure contains an array of keyframes and metadata about the array, such as the current number of keyframes
  * and the allocated capacity. The keyframes define a curve that can be used for smooth interpolation between values
  * over a normalized time range (0.0 to 1.0).
+ *
+ * The curve is also baked into a lookup table whenever a keyframe is added, which makes its evaluation
+ * constant time. If the keyframes are modified directly, `R3D_BakeCurve` must be called to update the table.
+ * The table remembers the keyframe array and count it was baked from: copies of the curve that no longer match them,
+ * e.g. after keyframes were added to another copy, ignore the table and are evaluated from their keyframes.
  */
 typedef struct R3D_InterpolationCurve {
     R3D_Keyframe* keyframes;    ///< Dynamic array of keyframes defining the interpolation curve.
     unsigned int capacity;      ///< Allocated size of the keyframes array.
     unsigned int count;         ///< Current number of keyframes in the array.
+    float* lut;                 ///< Values baked over [0, 1], see `R3D_CURVE_LUT_RESOLUTION` (NULL if not baked).
 } R3D_InterpolationCurve;
 
 /**
- * @struct R3D_Particle
- * @brief Represents a particle in a 3D particle system, with properties
- *        such as position, velocity, rotation, and color modulation.
+ * @brief Three-component vectors stored as three separate arrays, one per component.
+ */
+typedef struct R3D_Vector3Array {
+    float* x;   ///< Array of the X components.
+    float* y;   ///< Array of the Y components.
+    float* z;   ///< Array of the Z components.
+} R3D_Vector3Array;
+
+/**
+ * @brief Instance data packed in 32 bytes, instead of the 68 bytes of a matrix and a color.
+ *
+ * The vertex shaders rebuild the transform of the instance from these values. Like the transforms
+ * of particles, the scale is applied along the axes of the parent space, after the rotation.
+ * Use `R3D_PackInstance` to fill it.
+ *
+ * @see R3D_DrawMeshInstancedPacked
+ */
+typedef struct R3D_PackedInstance {
+    Vector3 position;           ///< Translation of the instance.
+    Color color;                ///< Color of the instance, multiplied with the albedo of the material.
+    short rotation[4];          ///< Unit quaternion (x, y, z, w), as signed normalized 16-bit integers.
+    unsigned short scale[4];    ///< Scale (x, y, z) as 16-bit floats, the fourth value is unused.
+} R3D_PackedInstance;
+
+/**
+ * @brief Optional per-instance parameters, varying the material of each instance within a single draw call.
+ *
+ * The texture coordinates of an instance are first transformed by its own UV offset and scale,
+ * within its sprite frame for sprites, then by the UV transform of the material. The factors
+ * multiply the corresponding values of the material. Use `R3D_GetDefaultInstanceParams`
+ * to get parameters leaving the material unchanged.
+ *
+ * @see R3D_DrawMeshInstancedParams
+ * @see R3D_DrawSpriteInstancedParams
+ */
+typedef struct R3D_InstanceParams {
+    Vector2 uvOffset;   ///< Offset of the texture coordinates of the instance. Default: (0, 0).
+    Vector2 uvScale;    ///< Scale of the texture coordinates of the instance, negative values flip the texture. Default: (1, 1).
+    float frame;        ///< Sprite frame of the instance, replacing `R3D_Sprite.currentFrame`. Ignored by meshes. Default: 0.
+    float emission;     ///< Factor of the emission energy of the material. Default: 1.
+    float roughness;    ///< Factor of the roughness of the material. Default: 1.
+    float metalness;    ///< Factor of the metalness of the material. Default: 1.
+} R3D_InstanceParams;
+
+/**
+ * @struct R3D_Particles
+ * @brief Particles of a particle system, stored as a structure of arrays.
+ *
+ * Each array holds one element per particle, up to the capacity of the system, and the
+ * alive particles are the first `count` ones. This layout lets `R3D_UpdateParticleSystem`
+ * process several particles per instruction, and the packed instances are read
+ * directly as instance attributes when the system is drawn.
  */
-typedef struct R3D_Particle {
+typedef struct R3D_Particles {
+
+    float* lifetime;                        ///< Remaining duration of existence of each particle in seconds.
 
-    float lifetime;                 ///< Duration of the particle's existence in seconds.
+    R3D_PackedInstance* instances;          ///< Current transforms and colors, packed on each update.
+    Color* colors;                          ///< Current colors, the alpha channel following the opacity curve.
 
-    Matrix transform;               ///< The particle's current transformation matrix in 3D space.
+    R3D_Vector3Array position;              ///< Current positions in 3D space.
+    R3D_Vector3Array rotation;              ///< Current rotations in radians (Euler angles).
+    R3D_Vector3Array scale;                 ///< Current scales.
 
-    Vector3 position;               ///< The current position of the particle in 3D space.
-    Vector3 rotation;               ///< The current rotation of the particle in 3D space (Euler angles).
-    Vector3 scale;                  ///< The current scale of the particle in 3D space.
-    Color color;                    ///< The current color of the particle, representing its color modulation.
+    R3D_Vector3Array velocity;              ///< Current velocities.
+    R3D_Vector3Array angularVelocity;       ///< Current angular velocities in degrees per second (Euler angles).
 
-    Vector3 velocity;               ///< The current velocity of the particle in 3D space.
-    Vector3 angularVelocity;        ///< The current angular velocity of the particle in radians (Euler angles).
+    R3D_Vector3Array baseScale;             ///< Initial scales.
+    R3D_Vector3Array baseVelocity;          ///< Initial velocities.
+    R3D_Vector3Array baseAngularVelocity;   ///< Initial angular velocities in degrees per second (Euler angles).
+    unsigned char* baseOpacity;             ///< Initial opacities, ranging from 0 (fully transparent) to 255 (fully opaque).
 
-    Vector3 baseScale;              ///< The initial scale of the particle in 3D space.
-    Vector3 baseVelocity;           ///< The initial velocity of the particle in 3D space.
-    Vector3 baseAngularVelocity;    ///< The initial angular velocity of the particle in radians (Euler angles).
-    unsigned char baseOpacity;      ///< The initial opacity of the particle, ranging from 0 (fully transparent) to 255 (fully opaque).
+} R3D_Particles;
 
-} R3D_Particle;
+/**
+ * @brief Opaque simulation state of a particle system updated on the GPU.
+ *
+ * @see R3D_LoadParticleSystemGPU
+ */
+typedef struct R3D_ParticleGPU R3D_ParticleGPU;
 
 /**
- * @brief Represents a CPU-based particle system with various properties and settings.
+ * @brief Represents a particle system with various properties and settings.
  *
  * This structure contains configuration data for a particle system, such as mesh information, initial properties,
  * curves for controlling properties over time, and settings for shadow casting, emission rate, and more.
+ * The particles are simulated on the CPU, or on the GPU for systems loaded with `R3D_LoadParticleSystemGPU`.
  */
 typedef struct R3D_ParticleSystem {
 
-    R3D_Particle* particles;            ///< Pointer to the array of particles in the system.
+    R3D_Particles particles;            ///< Particles of the system, stored as a structure of arrays. Empty for GPU systems.
+    R3D_ParticleGPU* gpu;               ///< GPU simulation state, NULL for systems simulated on the CPU.
     int capacity;                       ///< The maximum number of particles the system can manage.
-    int count;                          ///< The current number of active particles in the system.
+    int count;                          /**< The current number of active particles in the system.
+                                         *   For GPU systems, an upper bound: particles are counted until the largest lifetime
+                                         *   the parameters allow, `lifetime + lifetimeVariance`, has elapsed.
+                                         */
 
     Vector3 position;                   ///< The initial position of the particle system. Default: (0, 0, 0).
     Vector3 gravity;                    ///< The gravity applied to the particles. Default: (0, -9.81, 0).
@@ -453,12 +742,27 @@ typedef struct R3D_ParticleSystem {
     R3D_InterpolationCurve* opacityOverLifetime;            ///< Curve controlling the opacity evolution of the particles over their lifetime. Default: NULL.
     R3D_InterpolationCurve* angularVelocityOverLifetime;    ///< Curve controlling the angular velocity evolution of the particles over their lifetime. Default: NULL.
 
-    BoundingBox aabb;                   ///< For frustum culling. Defaults to a large AABB; compute manually via `R3D_CalculateParticleSystemBoundingBox` after setup.
+    BoundingBox aabb;                   /**< Bounds of the particle positions, for frustum culling. Defaults to a large AABB.
+                                         *   Kept up to date by the updates when `autoBoundingBox` is set, otherwise compute it
+                                         *   via `R3D_CalculateParticleSystemBoundingBox` after setup.
+                                         */
+    float maxScale;                     /**< Largest scale of the particles, the bounds are extended by the mesh scaled by it when drawn.
+                                         *   Maintained along with `aabb`. Default: 0.0f.
+                                         */
+    bool autoBoundingBox;               /**< Indicates whether `R3D_UpdateParticleSystem` maintains `aabb` and `maxScale`. CPU systems track
+                                         *   the alive particles, GPU systems use the bound computed by `R3D_CalculateParticleSystemBoundingBox`,
+                                         *   widened to every position of the emitter over the lifetime of the alive particles. Default: true.
+                                         */
 
     bool autoEmission;                  /**< Indicates whether particle emission is automatic when calling `R3D_UpdateParticleSystem`.
                                          *   If false, emission is manual using `R3D_EmitParticle`. Default: true.
                                          */
 
+    unsigned int seed;                  /**< Seed of the random numbers of the emission, specific to the system.
+                                         *   The same seed and counter always give the same particles. Default: drawn with `GetRandomValue`.
+                                         */
+    unsigned int randomCounter;         ///< Index of the next random number of the sequence, reset it with the seed to replay the system.
+
 } R3D_ParticleSystem;
 
 
@@ -586,6 +890,80 @@ R3DAPI void R3D_SetSceneBounds(BoundingBox sceneBounds);
  */
 R3DAPI void R3D_SetTextureFilter(TextureFilter filter);
 
+/**
+ * @brief Sets the maximum screen-space error allowed for mesh levels of detail.
+ *
+ * For each drawn mesh that has levels of detail (see R3D_GenMeshLODs()), the coarsest
+ * level whose geometric error, projected on screen from the camera given to R3D_Begin(),
+ * stays below this threshold is rendered.
+ *
+ * The default threshold is 1 pixel of the internal resolution.
+ *
+ * @param pixels Maximum projected error in pixels, 0 always renders the full meshes.
+ */
+R3DAPI void R3D_SetLODThreshold(float pixels);
+
+/**
+ * @brief Sets the number of additional levels of detail skipped in shadow passes.
+ *
+ * Shadow maps rarely need the same geometric precision as the view, shadow passes
+ * can therefore render coarser levels than the ones selected for the camera.
+ * The bias only applies to meshes already drawn with a simplified level, meshes
+ * close enough to be rendered in full keep their full geometry in shadows.
+ *
+ * The default bias is 1 level.
+ *
+ * @param levels Number of levels added to the level selected for the camera.
+ */
+R3DAPI void R3D_SetShadowLODBias(int levels);
+
+/**
+ * @brief Sets the range of the dithered cross-fade between levels of detail.
+ *
+ * When a mesh is close to switching to its next level, both levels are rendered with
+ * complementary dither patterns to hide the transition. The range is expressed as a
+ * fraction of the threshold (e.g. 0.5 fades between 1 and 1.5 times the threshold).
+ * The cross-fade only applies to deferred (opaque) meshes.
+ *
+ * The default range is 0 (disabled).
+ *
+ * @param range Fade range relative to the threshold, 0 to disable the cross-fade.
+ */
+R3DAPI void R3D_SetLODFadeRange(float range);
+
+/**
+ * @brief Sets the update rate reduction of skeletal animations with screen size.
+ *
+ * Animated models whose bounding sphere covers fewer than `fullRatePixels` pixels in height
+ * are only sampled every N frames of their animation, N growing as the model shrinks on screen,
+ * up to `maxInterval`. The pose is interpolated between two samples evaluated ahead of time,
+ * and the updates of different models are staggered over the frames.
+ *
+ * Only models using `anim` and `animFrame` / `animTime` are affected, blended layers are evaluated every frame.
+ * A model drawn several times per frame keeps one cached state per draw, the n-th draw of the model
+ * reusing the state of its n-th draw of the previous frame: draw the instances in a stable order.
+ * The default threshold is 0 (disabled) with a maximum interval of 4.
+ *
+ * @param fullRatePixels Projected height in pixels under which updates are throttled, 0 to disable.
+ * @param maxInterval Maximum number of frames between two updates.
+ */
+R3DAPI void R3D_SetAnimationLOD(float fullRatePixels, int maxInterval);
+
+/**
+ * @brief Sets the reduction of skeletons with screen size.
+ *
+ * Animated models whose bounding sphere covers fewer than `pixels` pixels in height stop sampling
+ * the bones closest to the leaves of their skeleton (fingers, facial bones...), which keep their
+ * pose at the first frame of the animation. A level of 1 freezes the leaf bones only, 2 also
+ * freezes their parents when all their children are leaves, and so on.
+ *
+ * The default threshold is 0 (disabled).
+ *
+ * @param pixels Projected height in pixels under which skeletons are reduced, 0 to disable.
+ * @param levels Number of bone levels frozen, counted from the leaves.
+ */
+R3DAPI void R3D_SetAnimationSkeletonLOD(float pixels, int levels);
+
 // --------------------------------------------
 // CORE: Drawing Functions
 // --------------------------------------------
@@ -676,6 +1054,69 @@ R3DAPI void R3D_DrawMeshInstancedPro(const R3D_Mesh* mesh, const R3D_Material* m
                                      const Color* instanceColors, int colorsStride,
                                      int instanceCount);
 
+/**
+ * @brief Draws a mesh with instancing support, reading packed instances.
+ *
+ * This function renders a mesh multiple times using instancing, like `R3D_DrawMeshInstancedPro`,
+ * but each instance is described by a `R3D_PackedInstance` holding its position, rotation, scale
+ * and color, which uploads less than half the data of a matrix and a color per instance.
+ *
+ * @param mesh A pointer to the mesh to render. Cannot be NULL.
+ * @param material A pointer to the material to apply to the mesh. Can be NULL, default material will be used.
+ * @param globalAabb Optional bounding box encompassing all instances, in local space. Used for frustum culling.
+ *                   Can be NULL to disable culling. Will be transformed by the global matrix if necessary.
+ * @param globalTransform The global transformation matrix applied to all instances.
+ * @param instances Pointer to an array of packed instances. Cannot be NULL.
+ * @param instanceCount The number of instances to render. Must be greater than 0.
+ *
+ * @see R3D_PackInstance
+ */
+R3DAPI void R3D_DrawMeshInstancedPacked(const R3D_Mesh* mesh, const R3D_Material* material,
+                                        const BoundingBox* globalAabb, Matrix globalTransform,
+                                        const R3D_PackedInstance* instances, int instanceCount);
+
+/**
+ * @brief Packs the transform and color of an instance.
+ *
+ * @param position The translation of the instance.
+ * @param rotation The rotation of the instance, normalized when packed.
+ * @param scale The scale of the instance, applied after the rotation. Stored as 16-bit floats.
+ * @param color The color of the instance.
+ * @return The packed instance, to be drawn with `R3D_DrawMeshInstancedPacked`.
+ */
+R3DAPI R3D_PackedInstance R3D_PackInstance(Vector3 position, Quaternion rotation, Vector3 scale, Color color);
+
+/**
+ * @brief Draws a mesh with instancing support and per-instance material parameters.
+ *
+ * This function renders a mesh multiple times using instancing, like `R3D_DrawMeshInstancedPro`,
+ * each instance also reading its own texture coordinates transform and material factors,
+ * so instances with different emission or roughness still share a single draw call.
+ *
+ * @param mesh A pointer to the mesh to render. Cannot be NULL.
+ * @param material A pointer to the material to apply to the mesh. Can be NULL, default material will be used.
+ * @param globalAabb Optional bounding box encompassing all instances, in local space. Used for frustum culling.
+ *                   Can be NULL to disable culling. Will be transformed by the global matrix if necessary.
+ * @param globalTransform The global transformation matrix applied to all instances.
+ * @param instanceTransforms Array of transformation matrices for each instance. Cannot be NULL.
+ * @param instanceColors Array of colors for each instance. Can be NULL if no per-instance colors are needed.
+ * @param instanceParams Array of parameters for each instance. Can be NULL, the material is then left unchanged.
+ * @param instanceCount The number of instances to render. Must be greater than 0.
+ *
+ * @see R3D_GetDefaultInstanceParams
+ */
+R3DAPI void R3D_DrawMeshInstancedParams(const R3D_Mesh* mesh, const R3D_Material* material,
+                                        const BoundingBox* globalAabb, Matrix globalTransform,
+                                        const Matrix* instanceTransforms, const Color* instanceColors,
+                                        const R3D_InstanceParams* instanceParams, int instanceCount);
+
+/**
+ * @brief Returns instance parameters leaving the material unchanged.
+ *
+ * @return The default instance parameters, see `R3D_InstanceParams`.
+ */
+R3DAPI R3D_InstanceParams R3D_GetDefaultInstanceParams(void);
+
 /**
  * @brief Draws a model at a specified position and scale.
  * 
@@ -766,6 +1207,42 @@ R3DAPI void R3D_DrawModelInstancedPro(const R3D_Model* model,
                                       const Color* instanceColors, int colorsStride,
                                       int instanceCount);
 
+/**
+ * @brief Draws a skinned model with instancing support, each instance playing its own animation.
+ *
+ * The skinning matrices of every instance are fetched from a baked animation texture,
+ * interpolated between the two frames surrounding the time of the instance. The animation
+ * state of the model itself (`anim`, `animFrame`, `animTime`, `animLayers`) is ignored.
+ *
+ * @param model A pointer to the model to render. Cannot be NULL.
+ * @param animTexture Animations baked for this model with R3D_LoadAnimationTexture(). Cannot be NULL.
+ * @param instanceTransforms Array of transformation matrices for each instance. Cannot be NULL.
+ * @param instanceColors Array of colors for each instance. Can be NULL if no per-instance colors are needed.
+ * @param instanceAnims Array of animation states for each instance. Cannot be NULL.
+ * @param instanceCount The number of instances to render. Must be greater than 0.
+ */
+R3DAPI void R3D_DrawModelInstancedAnimated(const R3D_Model* model, const R3D_AnimationTexture* animTexture,
+                                           const Matrix* instanceTransforms, const Color* instanceColors,
+                                           const R3D_InstanceAnimation* instanceAnims, int instanceCount);
+
+/**
+ * @brief Draws a model with instancing support, deformed by a baked vertex animation.
+ *
+ * Each instance plays the vertex animation at `frame` plus its own offset, interpolated between
+ * the two surrounding baked frames. Skinning and the animation state of the model are ignored.
+ *
+ * @param model A pointer to the model to render. Cannot be NULL.
+ * @param vertexAnim Vertex animation baked for this model. Cannot be NULL.
+ * @param frame Fractional frame shared by all instances, wrapped around the frame count of the animation.
+ * @param instanceTransforms Array of transformation matrices for each instance. Cannot be NULL.
+ * @param instanceColors Array of colors for each instance. Can be NULL if no per-instance colors are needed.
+ * @param instanceFrameOffsets Array of frame offsets added to `frame` for each instance. Can be NULL.
+ * @param instanceCount The number of instances to render. Must be greater than 0.
+ */
+R3DAPI void R3D_DrawModelInstancedVertexAnimated(const R3D_Model* model, const R3D_VertexAnimation* vertexAnim, float frame,
+                                                 const Matrix* instanceTransforms, const Color* instanceColors,
+                                                 const float* instanceFrameOffsets, int instanceCount);
+
 /**
  * @brief Draws a sprite at a specified position.
  *
@@ -856,6 +1333,28 @@ R3DAPI void R3D_DrawSpriteInstancedPro(const R3D_Sprite* sprite, const BoundingB
                                        const Color* instanceColors, int colorsStride,
                                        int instanceCount);
 
+/**
+ * @brief Draws a 3D sprite with instancing support and per-instance animation frames and material parameters.
+ *
+ * This function renders a 3D sprite multiple times using instancing, like `R3D_DrawSpriteInstancedPro`,
+ * each instance playing its own frame of the sprite sheet, computed by the GPU, and reading its own
+ * material factors, so animated crowds of sprites are still drawn with a single draw call.
+ *
+ * @param sprite A pointer to the sprite to render. Cannot be NULL.
+ * @param globalAabb Optional bounding box encompassing all instances, in local space. Used for frustum culling.
+ *                   Can be NULL to disable culling. Will be transformed by the global matrix if provided.
+ * @param globalTransform The global transformation matrix applied to all instances.
+ * @param instanceTransforms Array of transformation matrices for each instance. Cannot be NULL.
+ * @param instanceColors Array of colors for each instance. Can be NULL if no per-instance colors are needed.
+ * @param instanceParams Array of parameters for each instance, including its frame. Can be NULL, all instances then use the current frame of the sprite.
+ * @param instanceCount The number of instances to render. Must be greater than 0.
+ *
+ * @see R3D_GetDefaultInstanceParams
+ */
+R3DAPI void R3D_DrawSpriteInstancedParams(const R3D_Sprite* sprite, const BoundingBox* globalAabb, Matrix globalTransform,
+                                          const Matrix* instanceTransforms, const Color* instanceColors,
+                                          const R3D_InstanceParams* instanceParams, int instanceCount);
+
 /**
  * @brief Renders the current state of a CPU-based particle system.
  *
@@ -887,6 +1386,46 @@ R3DAPI void R3D_DrawParticleSystem(const R3D_ParticleSystem* system, const R3D_M
  */
 R3DAPI void R3D_DrawParticleSystemEx(const R3D_ParticleSystem* system, const R3D_Mesh* mesh, const R3D_Material* material, Matrix transform);
 
+/**
+ * @brief Renders an impostor with a specified transformation.
+ *
+ * The impostor is rendered as a camera-facing quad blending the four views closest to
+ * the view direction. It is always rendered in the deferred pipeline.
+ * It casts shadows from directional and spot lights, but not from omni lights whose
+ * cube shadow maps store a distance the baked depth cannot provide.
+ *
+ * @param impostor A pointer to the impostor to render.
+ * @param transform A transformation matrix, the same as the one that would be used for the model.
+ */
+R3DAPI void R3D_DrawImpostor(const R3D_Impostor* impostor, Matrix transform);
+
+/**
+ * @brief Renders multiple instances of an impostor.
+ *
+ * @param impostor A pointer to the impostor to render.
+ * @param instanceTransforms Array of transformation matrices, one per instance.
+ * @param instanceCount The number of instances to render.
+ */
+R3DAPI void R3D_DrawImpostorInstanced(const R3D_Impostor* impostor, const Matrix* instanceTransforms, int instanceCount);
+
+/**
+ * @brief Renders either a model or its impostor depending on its size on screen.
+ *
+ * The size on screen is the projected diameter of the bounding sphere of the impostor,
+ * relative to the height of the viewport. The model is rendered above `switchSize` and
+ * the impostor below it. Within `fadeRange` around the switch size both are rendered
+ * with complementary dither patterns to cross-fade between them.
+ *
+ * @note The cross-fade only applies to opaque materials of the model.
+ *
+ * @param model A pointer to the model to render.
+ * @param impostor A pointer to the impostor baked from this model.
+ * @param transform A transformation matrix applied to the model or impostor.
+ * @param switchSize Size on screen (0.0 to 1.0) at which the impostor replaces the model.
+ * @param fadeRange Width of the cross-fade range in the same unit (0.0 to disable).
+ */
+R3DAPI void R3D_DrawModelImpostor(const R3D_Model* model, const R3D_Impostor* impostor, Matrix transform, float switchSize, float fadeRange);
+
 /** @} */ // end of Core
 
 /**
@@ -1119,6 +1658,70 @@ R3DAPI bool R3D_UpdateMesh(R3D_Mesh* mesh);
  */
 R3DAPI void R3D_UpdateMeshBoundingBox(R3D_Mesh* mesh);
 
+/**
+ * @brief Partition a mesh into meshlets for per-cluster culling.
+ *
+ * Reorders the triangles of the mesh into clusters of at most 128 triangles that are
+ * spatially close and face a similar direction, then computes a bounding sphere and a
+ * normal cone for each of them (see R3D_Meshlet). When the mesh is drawn, the clusters
+ * outside the view frustum or facing away from the viewer are skipped, in the scene
+ * passes as well as in the shadow passes, and the visible ones are rendered with a few
+ * multi-range draws.
+ *
+ * Index sub-ranges (see R3D_MeshRange) are preserved, triangles are only reordered within them.
+ * If the mesh has already been uploaded, its index buffer is updated.
+ *
+ * @param mesh Pointer to the mesh, which must have CPU-side vertices and indices.
+ * @return true on success, false if the mesh has no indices or on allocation failure.
+ *
+ * @note Cone culling relies on the triangle winding and is only applied for back or
+ *       front face culling. Clusters of skinned meshes are not culled while animated.
+ */
+R3DAPI bool R3D_GenMeshMeshlets(R3D_Mesh* mesh);
+
+/**
+ * @brief Generate a chain of simplified levels of detail for a mesh.
+ *
+ * Each level is obtained by simplifying the previous one to about half of its triangles,
+ * with quadric error metric edge collapses. Vertices are never created nor moved, so every
+ * level shares the vertex buffer of the mesh and only owns an index buffer (see R3D_MeshLOD).
+ * Open borders and attribute seams (UV, normal or color discontinuities) are preserved.
+ *
+ * When drawn, the coarsest level whose projected error stays below the threshold set
+ * with R3D_SetLODThreshold() is selected for each mesh. Shadow passes can use coarser
+ * levels with R3D_SetShadowLODBias().
+ *
+ * Existing levels are replaced. If the mesh has already been uploaded, the index buffers
+ * of the levels are uploaded as well. The chain stops early when a mesh cannot be
+ * simplified any further.
+ *
+ * @param mesh Pointer to the mesh, which must have CPU-side vertices and indices.
+ * @param lodCount Maximum number of levels to generate, the full mesh excluded.
+ * @return true if at least one level has been generated, false otherwise.
+ *
+ * If the mesh has meshlets or index sub-ranges, every level is partitioned into meshlets
+ * and keeps being culled per cluster when drawn.
+ *
+ * @note Levels of detail are not used for instanced draws.
+ */
+R3DAPI bool R3D_GenMeshLODs(R3D_Mesh* mesh, int lodCount);
+
+/**
+ * @brief Generate the bone bounds of a skinned mesh.
+ *
+ * Computes, for each bone referenced by the vertex weights, the bind pose bounding box
+ * of the vertices it influences (see R3D_BoneBounds). When the mesh is drawn animated,
+ * these boxes are moved by the current skinning matrices and merged, giving a tight
+ * bounding box that follows the animation for frustum culling, light filtering and sorting.
+ * Without bone bounds, animated meshes are culled with their bind pose bounding box.
+ *
+ * Models loaded from files get their bone bounds automatically. Existing bounds are replaced.
+ *
+ * @param mesh Pointer to the mesh, which must have CPU-side vertices with bone weights.
+ * @return true on success, false if no vertex is weighted or on allocation failure.
+ */
+R3DAPI bool R3D_GenMeshBoneBounds(R3D_Mesh* mesh);
+
 // --------------------------------------------
 // MODEL: Material Functions
 // --------------------------------------------
@@ -1196,6 +1799,31 @@ R3DAPI R3D_Model R3D_LoadModelFromMemory(const char* fileType, const void* data,
  */
 R3DAPI R3D_Model R3D_LoadModelFromMesh(const R3D_Mesh* mesh);
 
+/**
+ * @brief Builds a static batch from many placed models.
+ *
+ * The geometry of every placement is transformed in world space and merged into one
+ * mesh per unique material. The placed meshes are sorted along a grid of cells and each
+ * non-empty cell becomes an index sub-range (see R3D_MeshRange) with its own bounding box.
+ * When drawn, invisible cells are culled in every pass and the visible ones are rendered
+ * with a few multi-range draws, instead of one draw call per placed mesh.
+ *
+ * The returned model is drawn like any other model, with an identity transform
+ * (e.g. `R3D_DrawModel(&batch, Vector3Zero(), 1.0f)`). Its materials are shallow copies
+ * of the source materials, so it must be unloaded with `R3D_UnloadModel(&batch, false)`.
+ *
+ * @param models Array of models, one per placement (the same model can appear several times).
+ * @param transforms Array of world transforms, one per placement.
+ * @param count Number of placements.
+ * @param cellSize Size of the culling cells in world units, or 0 to derive it from the batch bounds.
+ * @return The batched model. Empty if no mesh could be batched.
+ *
+ * @note The source models must keep their CPU-side vertex data. Skinned meshes and
+ *       billboarded materials are skipped. The source models can be unloaded afterwards,
+ *       as long as their material textures are kept alive.
+ */
+R3DAPI R3D_Model R3D_LoadStaticBatch(const R3D_Model* models, const Matrix* transforms, int count, float cellSize);
+
 /**
  * @brief Unload a model and optionally its materials.
  *
@@ -1283,6 +1911,143 @@ R3DAPI R3D_ModelAnimation* R3D_GetModelAnimation(R3D_ModelAnimation* animations,
  */
 R3DAPI void R3D_ListModelAnimations(R3D_ModelAnimation* animations, int animCount);
 
+/**
+ * @brief Reconstructs the pose of every bone of an animation at a given frame.
+ *
+ * Decompresses the tracks of the animation and combines them along the bone hierarchy.
+ * The resulting matrices express each bone in model space, before the bone offsets are applied.
+ *
+ * @param anim Pointer to the animation to sample.
+ * @param frame Frame to sample, wrapped around the frame count of the animation.
+ * @param poses Output array receiving `anim->boneCount` matrices.
+ */
+R3DAPI void R3D_GetModelAnimationPose(const R3D_ModelAnimation* anim, int frame, Matrix* poses);
+
+/**
+ * @brief Reconstructs the pose of every bone of an animation at a fractional frame.
+ *
+ * Same as R3D_GetModelAnimationPose(), the keys surrounding the frame being interpolated.
+ * The animation loops, frames between the last one and the frame count blend back to the first frame.
+ *
+ * @param anim Pointer to the animation to sample.
+ * @param frame Fractional frame to sample, wrapped around the frame count of the animation.
+ * @param poses Output array receiving `anim->boneCount` matrices.
+ */
+R3DAPI void R3D_SampleModelAnimationPose(const R3D_ModelAnimation* anim, float frame, Matrix* poses);
+
+/**
+ * @brief Materializes the pose of every frame of an animation in its `framePoses` array.
+ *
+ * Animations only keep their compressed tracks, this function decompresses every frame
+ * for code reading `framePoses` directly, at the cost of `sizeof(Matrix)` per bone per frame.
+ * The poses are the same as the ones returned by R3D_GetModelAnimationPose() and are
+ * released with the animation by R3D_UnloadModelAnimations(). Calling it again does nothing.
+ *
+ * @param anim Pointer to the animation whose poses are materialized.
+ * @return true if `framePoses` is available, false on allocation failure.
+ */
+R3DAPI bool R3D_LoadModelAnimationFramePoses(R3D_ModelAnimation* anim);
+
+/**
+ * @brief Samples the local transform of every bone of an animation at a fractional frame.
+ *
+ * Each transform is expressed relative to the parent bone given by `anim->bones`.
+ *
+ * @param anim Pointer to the animation to sample.
+ * @param frame Frame to sample, wrapped around the frame count of the animation.
+ * @param locals Output array receiving `anim->boneCount` transforms.
+ */
+R3DAPI void R3D_SampleModelAnimation(const R3D_ModelAnimation* anim, float frame, Transform* locals);
+
+/**
+ * @brief Blends several animation layers into local bone transforms.
+ *
+ * Regular layers are cross-faded by weight, additive layers are then applied on top.
+ * The skeleton of the first layer defines the bone count, layers with a different
+ * bone count are ignored.
+ *
+ * @param layers Array of animation layers.
+ * @param layerCount Number of layers.
+ * @param locals Output array receiving one transform per bone of the first layer.
+ */
+R3DAPI void R3D_BlendModelAnimations(const R3D_AnimationLayer* layers, int layerCount, Transform* locals);
+
+/**
+ * @brief Blends several animation layers into model space bone poses.
+ *
+ * Same as R3D_BlendModelAnimations(), with the result combined along the bone hierarchy
+ * like R3D_GetModelAnimationPose().
+ *
+ * @param layers Array of animation layers.
+ * @param layerCount Number of layers.
+ * @param poses Output array receiving one matrix per bone of the first layer.
+ */
+R3DAPI void R3D_GetModelAnimationBlendPose(const R3D_AnimationLayer* layers, int layerCount, Matrix* poses);
+
+/**
+ * @brief Bakes the skinning matrices of every frame of a set of animations into a GPU buffer.
+ *
+ * Every frame of every clip is sampled and multiplied by the bone offsets of the model.
+ * Clips whose skeleton does not match the bone count of the model are baked in their bind pose.
+ * The memory used is `sizeof(Matrix) * boneCount` per frame.
+ *
+ * @note This function must be called after `R3D_Init()`.
+ *
+ * @param model Model providing the bone offsets.
+ * @param animations Array of animations to bake.
+ * @param animCount Number of animations in the array.
+ *
+ * @return The baked animation texture, or an empty one on failure.
+ */
+R3DAPI R3D_AnimationTexture R3D_LoadAnimationTexture(const R3D_Model* model, const R3D_ModelAnimation* animations, int animCount);
+
+/**
+ * @brief Unloads an animation texture and its clip table.
+ *
+ * @param animTexture Pointer to the animation texture to unload.
+ */
+R3DAPI void R3D_UnloadAnimationTexture(R3D_AnimationTexture* animTexture);
+
+/**
+ * @brief Bakes the skinned vertices of a model for every frame of an animation.
+ *
+ * Every frame of the clip is sampled and the vertices of all meshes of the model are skinned
+ * on the CPU, the positions and normals being stored on the GPU. The memory used is 32 bytes
+ * per vertex and per frame.
+ *
+ * @note This function must be called after `R3D_Init()`. The model must keep its vertices on the CPU.
+ *
+ * @param model Model to deform.
+ * @param anim Animation to bake, sharing the skeleton of the model.
+ *
+ * @return The baked vertex animation, or an empty one on failure.
+ */
+R3DAPI R3D_VertexAnimation R3D_BakeVertexAnimation(const R3D_Model* model, const R3D_ModelAnimation* anim);
+
+/**
+ * @brief Loads a vertex animation from positions and normals computed by the application.
+ *
+ * Both arrays hold `vertexCount * frameCount` elements, indexed by [frame * vertexCount + vertex],
+ * the vertices of each frame following the meshes of the model they are meant for.
+ *
+ * @note This function must be called after `R3D_Init()`.
+ *
+ * @param positions Array of vertex positions, in model space.
+ * @param normals Array of vertex normals, in model space.
+ * @param vertexCount Number of vertices per frame.
+ * @param frameCount Number of frames.
+ *
+ * @return The loaded vertex animation, or an empty one on failure.
+ */
+R3DAPI R3D_VertexAnimation R3D_LoadVertexAnimation(const Vector3* positions, const Vector3* normals, int vertexCount, int frameCount);
+
+/**
+ * @brief Unloads a vertex animation.
+ *
+ * @param vertexAnim Pointer to the vertex animation to unload.
+ */
+R3DAPI void R3D_UnloadVertexAnimation(R3D_VertexAnimation* vertexAnim);
+
 /**
  * @brief Sets the scaling factor applied to models on loading.
  *
@@ -1293,6 +2058,61 @@ R3DAPI void R3D_ListModelAnimations(R3D_ModelAnimation* animations, int animCoun
  */
 R3DAPI void R3D_SetModelImportScale(float value);
 
+/**
+ * @brief Enables or disables the merging of meshes by material on loading.
+ *
+ * When enabled, all non-skinned meshes of a loaded model that share the same material
+ * are pre-transformed by their node hierarchy and merged into a single mesh per material.
+ * Each source mesh is kept as an index sub-range (see R3D_MeshRange) with its own bounding
+ * box, so the parts of a merged mesh are still frustum culled individually in every pass.
+ *
+ * This greatly reduces the number of draw calls for models made of many small static
+ * meshes, such as architectural scenes. Skinned meshes are never merged.
+ *
+ * This value is only applied to models loaded after it is set. Disabled by default.
+ *
+ * @param enabled Whether meshes sharing the same material should be merged.
+ */
+R3DAPI void R3D_SetModelImportMergeMeshes(bool enabled);
+
+/**
+ * @brief Enables or disables the generation of meshlets on loading.
+ *
+ * When enabled, every mesh of a loaded model is partitioned into meshlets with
+ * R3D_GenMeshMeshlets() before being uploaded, after the optional merging of meshes.
+ * This is mostly useful for large and dense static meshes, such as architectural scenes.
+ *
+ * This value is only applied to models loaded after it is set. Disabled by default.
+ *
+ * @param enabled Whether meshlets should be generated for loaded meshes.
+ */
+R3DAPI void R3D_SetModelImportMeshlets(bool enabled);
+
+/**
+ * @brief Sets the number of levels of detail generated on loading.
+ *
+ * When greater than zero, R3D_GenMeshLODs() is called with this value for every mesh
+ * of a loaded model before it is uploaded.
+ *
+ * This value is only applied to models loaded after it is set. Zero (disabled) by default.
+ *
+ * @param lodCount Maximum number of levels to generate per mesh, the full mesh excluded.
+ */
+R3DAPI void R3D_SetModelImportLODs(int lodCount);
+
+/**
+ * @brief Sets the tolerance used when compressing loaded animations.
+ *
+ * Animation keys that can be reconstructed by interpolating their neighbors within this
+ * tolerance are removed. The tolerance applies to rotations (quaternion distance) and
+ * scales directly, and to translations relative to the size of the animated skeleton.
+ *
+ * This value is only applied to animations loaded after it is set. The default tolerance is 0.0005.
+ *
+ * @param tolerance Maximum reconstruction error, 0 to keep every sampled key.
+ */
+R3DAPI void R3D_SetModelImportAnimationTolerance(float tolerance);
+
 /** @} */ // end of Model
 
 /**
@@ -1835,6 +2655,24 @@ R3DAPI void R3D_DrawLightShape(R3D_Light id);
  */
 R3DAPI R3D_ParticleSystem R3D_LoadParticleSystem(int maxParticles);
 
+/**
+ * @brief Loads a particle emitter system simulated on the GPU.
+ *
+ * The system takes the same parameters as the ones loaded with `R3D_LoadParticleSystem`, but the emission,
+ * integration and curves are evaluated by the GPU with transform feedback, and the particles are drawn
+ * straight from the simulation buffers. Updating and drawing the system then costs no CPU time per
+ * particle and uploads nothing but the parameters.
+ *
+ * The particles are not readable from the CPU, `particles` stays empty. Emission uses its own random
+ * numbers, so the particles follow the same distributions as the CPU ones but not the same values.
+ *
+ * If the particle shader is unavailable, a warning is logged and a CPU system is returned instead.
+ *
+ * @param maxParticles The maximum number of particles the system can handle at once.
+ * @return A newly initialized `R3D_ParticleSystem` structure, to be freed with `R3D_UnloadParticleSystem`.
+ */
+R3DAPI R3D_ParticleSystem R3D_LoadParticleSystemGPU(int maxParticles);
+
 /**
  * @brief Unloads the particle emitter system and frees allocated memory.
  *
@@ -1851,7 +2689,11 @@ R3DAPI void R3D_UnloadParticleSystem(R3D_ParticleSystem* system);
  * This function triggers the emission of a new particle in the particle system. It handles the logic of adding a new
  * particle to the system and initializing its properties based on the current state of the system.
  *
- * @param system A pointer to the `R3D_ParticleSystemCPU` where the particle will be emitted.
+ * For GPU systems, the particle is emitted by the next call to `R3D_UpdateParticleSystem`. Particles are
+ * counted as alive until their largest possible lifetime has elapsed, so the system may refuse emissions
+ * slightly earlier than a CPU system; alive particles are never replaced.
+ *
+ * @param system A pointer to the `R3D_ParticleSystem` where the particle will be emitted.
  * @return `true` if the particle was successfully emitted, `false` if the system is at full capacity and cannot emit more particles.
  */
 R3DAPI bool R3D_EmitParticle(R3D_ParticleSystem* system);
@@ -1867,13 +2709,29 @@ R3DAPI bool R3D_EmitParticle(R3D_ParticleSystem* system);
  */
 R3DAPI void R3D_UpdateParticleSystem(R3D_ParticleSystem* system, float deltaTime);
 
+/**
+ * @brief Updates an array of particle emitter systems, in parallel when possible.
+ *
+ * Each system is updated as with `R3D_UpdateParticleSystem`. When the library is built with OpenMP,
+ * the systems simulated on the CPU are distributed over its worker threads. The random numbers of
+ * each system only depend on its `seed` and `randomCounter`, so the results are identical whatever
+ * the number of threads. Systems simulated on the GPU are updated afterwards, on the calling thread.
+ *
+ * @param systems An array of `R3D_ParticleSystem` to be updated.
+ * @param count The number of systems in the array.
+ * @param deltaTime The time elapsed since the last update (in seconds).
+ */
+R3DAPI void R3D_UpdateParticleSystems(R3D_ParticleSystem* systems, int count, float deltaTime);
+
 /**
  * @brief Computes and updates the AABB (Axis-Aligned Bounding Box) of a particle system.
  *
- * This function simulates the particle system to estimate the region of space it occupies.
- * It considers particle positions at mid-life and end-of-life to approximate the AABB,
- * which is then stored in the system's `aabb` field. This is useful for enabling frustum culling,
- * especially when the bounds are not known beforehand.
+ * This function derives a conservative bound of every particle the system can emit from its
+ * position, its velocity, spread, gravity, lifetime, scale and variance parameters and the range
+ * of its curves, without simulating anything. The bound is stored in the system's `aabb` field and
+ * the largest scale in `maxScale`. This is useful for enabling frustum culling of systems that are
+ * not updated every frame. Only the current position of the emitter is considered, particles emitted
+ * before it moved are not covered; leave `autoBoundingBox` set for moving GPU systems instead.
  *
  * @param system Pointer to the `R3D_ParticleSystem` to update.
  */
@@ -1951,6 +2809,121 @@ R3DAPI void R3D_UpdateSpriteEx(R3D_Sprite* sprite, int firstFrame, int lastFrame
 
 /** @} */ // end of Sprites
 
+/**
+ * @defgroup Atlas Texture Atlas Functions
+ * @{
+ */
+
+// --------------------------------------------
+// ATLAS: Texture Atlas Functions
+// --------------------------------------------
+
+/**
+ * @brief Packs images into a texture atlas.
+ *
+ * The images are placed with a skyline packer into the smallest power-of-two texture found,
+ * up to `maxSize` pixels per side. Each image is surrounded by `padding` pixels repeating its border.
+ * Regions are aligned so that the mipmaps keep the regions apart: a padding of 2^(n+1) pixels
+ * allows n mipmap levels, and the mipmap chain of the atlas is limited accordingly.
+ *
+ * @param images Images to pack, of any uncompressed format.
+ * @param count Number of images.
+ * @param maxSize Maximum width and height of the atlas, in pixels.
+ * @param padding Number of pixels repeating the border of each image.
+ * @return The atlas, with one region per image. Empty on failure.
+ *
+ * @note An image that does not fit in the largest atlas gets an empty region and a warning is logged.
+ */
+R3DAPI R3D_TextureAtlas R3D_LoadTextureAtlas(const Image* images, int count, int maxSize, int padding);
+
+/**
+ * @brief Packs the albedo textures of materials into an atlas and remaps the materials to it.
+ *
+ * Each distinct albedo texture is read back from the GPU and packed once (see `R3D_LoadTextureAtlas`),
+ * then every material using it is remapped to its region with `R3D_SetMaterialAtlasRegion`.
+ * Materials which differed only by their albedo texture then become identical,
+ * apart from their UV transform, so that sprite batches and static batches can merge them.
+ *
+ * @param materials Materials to remap. Materials without albedo texture, with emission, normal
+ *                  or ORM textures (which share the texture coordinates of the albedo), or whose
+ *                  UV transform reaches past [0, 1] (tiled textures), are left untouched.
+ * @param count Number of materials.
+ * @param maxSize Maximum width and height of the atlas, in pixels.
+ * @param padding Number of pixels repeating the border of each image.
+ * @return The atlas, with one region per distinct albedo texture. Empty on failure, the materials being then left untouched.
+ *
+ * @note The original textures are not unloaded. Textures relying on repeating texture coordinates
+ *       cannot be atlased, since they would sample the neighbouring regions. Only the UV transform
+ *       can be checked, materials of meshes whose own texture coordinates leave [0, 1] must be kept
+ *       out of the array. The remapped materials share the atlas texture, which must only be
+ *       unloaded with `R3D_UnloadTextureAtlas`.
+ */
+R3DAPI R3D_TextureAtlas R3D_LoadMaterialAtlas(R3D_Material* materials, int count, int maxSize, int padding);
+
+/**
+ * @brief Unloads a texture atlas.
+ *
+ * @param atlas Pointer to the atlas to unload.
+ */
+R3DAPI void R3D_UnloadTextureAtlas(const R3D_TextureAtlas* atlas);
+
+/**
+ * @brief Points the albedo of a material to a region of an atlas.
+ *
+ * The albedo texture of the material is replaced by the atlas and its UV transform is combined
+ * with the transform of the region, so texture coordinates in [0, 1] cover the region only.
+ * For sprites, the frames of the sprite sheet are then read within the region.
+ * The other texture maps of the material are read with the same texture coordinates.
+ *
+ * @param material Material to remap.
+ * @param atlas Atlas holding the region.
+ * @param region Index of the region.
+ * @return False if the region does not exist or is empty, or if the UV transform of the material
+ *         reaches past [0, 1], the material being then left untouched.
+ *
+ * @note Tiled textures cannot be read from a region, the texture coordinates past [0, 1] would
+ *       sample the neighbouring regions. This also applies to meshes whose own texture coordinates
+ *       leave [0, 1], which cannot be detected here.
+ */
+R3DAPI bool R3D_SetMaterialAtlasRegion(R3D_Material* material, const R3D_TextureAtlas* atlas, int region);
+
+/** @} */ // end of Atlas
+
+/**
+ * @defgroup Impostors Impostor Functions
+ * @{
+ */
+
+// --------------------------------------------
+// IMPOSTOR: Impostor Functions
+// --------------------------------------------
+
+/**
+ * @brief Bakes an octahedral impostor from a model.
+ *
+ * The opaque meshes of the model are rendered offscreen with the G-Buffer shaders from
+ * `frames` x `frames` directions spread over an octahedron, in an orthographic view
+ * fitted to the bounding sphere of the model. Animated models are baked in their bind pose.
+ *
+ * @note This function must be called after `R3D_Init()` and outside of `R3D_Begin()` / `R3D_End()`.
+ *
+ * @param model A pointer to the model to bake.
+ * @param frames Number of views along each side of the atlas (e.g. 8 for 64 views).
+ * @param frameSize Resolution in pixels of each view (e.g. 128).
+ *
+ * @return The baked impostor, or an empty impostor on failure.
+ */
+R3DAPI R3D_Impostor R3D_LoadImpostor(const R3D_Model* model, int frames, int frameSize);
+
+/**
+ * @brief Unloads the textures of an impostor.
+ *
+ * @param impostor A pointer to the impostor to unload.
+ */
+R3DAPI void R3D_UnloadImpostor(const R3D_Impostor* impostor);
+
+/** @} */ // end of Impostors
+
 /**
  * @defgroup Curves Curve Functions
  * @brief The interpolation curves defined in this module are used in the context of particle systems.
@@ -1998,11 +2971,25 @@ R3DAPI void R3D_UnloadInterpolationCurve(R3D_InterpolationCurve curve);
  */
 R3DAPI bool R3D_AddKeyframe(R3D_InterpolationCurve* curve, float time, float value);
 
+/**
+ * @brief Bakes the lookup table of the interpolation curve.
+ *
+ * This function samples the keyframes of the curve into its lookup table, allocating the table if needed.
+ * It is called by `R3D_AddKeyframe`, and only has to be called manually after modifying the keyframes directly.
+ * Curves whose keyframes lie outside the [0, 1] time range can't be represented by the table, in that case
+ * the table is released and the curve is evaluated from its keyframes.
+ *
+ * @param curve A pointer to the interpolation curve to bake.
+ * @return `true` if the lookup table is valid, `false` otherwise.
+ */
+R3DAPI bool R3D_BakeCurve(R3D_InterpolationCurve* curve);
+
 /**
  * @brief Evaluates the interpolation curve at a specific time.
  *
  * This function evaluates the value of the interpolation curve at a given time. The curve will interpolate between
- * keyframes based on the time provided.
+ * keyframes based on the time provided. Baked curves are read from their lookup table in constant time,
+ * the others search their keyframes by bisection.
  *
  * @param curve The interpolation curve to be evaluated.
  * @param time The time at which to evaluate the curve.
@@ -19,10 +19,6 @@
 
 #version 330 core
 
-/* === Constants === */
-
-const int MAX_BONES = 128;
-
 /* === Attributes === */
 
 layout(location = 0) in vec3 aPosition;
@@ -36,7 +32,8 @@ layout(location = 6) in vec4 aWeights;
 uniform mat4 uMatMVP;
 uniform float uAlpha;
 
-uniform mat4 uBoneMatrices[MAX_BONES];
+uniform samplerBuffer uTexBoneMatrices;
+uniform int uBoneOffset;
 uniform bool uUseSkinning;
 
 /* === Varyings === */
@@ -44,6 +41,20 @@ uniform bool uUseSkinning;
 out vec2 vTexCoord;
 out float vAlpha;
 
+/* === Helper functions === */
+
+mat4 BoneMatrix(int boneID)
+{
+    int texel = 3 * (uBoneOffset + boneID);
+
+    return transpose(mat4(
+        texelFetch(uTexBoneMatrices, texel + 0),
+        texelFetch(uTexBoneMatrices, texel + 1),
+        texelFetch(uTexBoneMatrices, texel + 2),
+        vec4(0.0, 0.0, 0.0, 1.0)
+    ));
+}
+
 /* === Main function === */
 
 void main()
@@ -53,10 +64,10 @@ void main()
     if (uUseSkinning)
     {
         mat4 skinMatrix =
-              aWeights.x * uBoneMatrices[aBoneIDs.x] +
-              aWeights.y * uBoneMatrices[aBoneIDs.y] +
-              aWeights.z * uBoneMatrices[aBoneIDs.z] +
-              aWeights.w * uBoneMatrices[aBoneIDs.w];
+              aWeights.x * BoneMatrix(aBoneIDs.x) +
+              aWeights.y * BoneMatrix(aBoneIDs.y) +
+              aWeights.z * BoneMatrix(aBoneIDs.z) +
+              aWeights.w * BoneMatrix(aBoneIDs.w);
 
         skinnedPosition = vec3(skinMatrix * vec4(aPosition, 1.0));
     }
@@ -19,10 +19,6 @@
 
 #version 330 core
 
-/* === Constants === */
-
-const int MAX_BONES = 128;
-
 /* === Attributes === */
 
 layout(location = 0) in vec3 aPosition;
@@ -37,7 +33,8 @@ uniform mat4 uMatModel;
 uniform mat4 uMatMVP;
 uniform float uAlpha;
 
-uniform mat4 uBoneMatrices[MAX_BONES];
+uniform samplerBuffer uTexBoneMatrices;
+uniform int uBoneOffset;
 uniform bool uUseSkinning;
 
 /* === Varyings === */
@@ -46,6 +43,20 @@ out vec3 vPosition;
 out vec2 vTexCoord;
 out float vAlpha;
 
+/* === Helper functions === */
+
+mat4 BoneMatrix(int boneID)
+{
+    int texel = 3 * (uBoneOffset + boneID);
+
+    return transpose(mat4(
+        texelFetch(uTexBoneMatrices, texel + 0),
+        texelFetch(uTexBoneMatrices, texel + 1),
+        texelFetch(uTexBoneMatrices, texel + 2),
+        vec4(0.0, 0.0, 0.0, 1.0)
+    ));
+}
+
 /* === Main function === */
 
 void main()
@@ -55,10 +66,10 @@ void main()
     if (uUseSkinning)
     {
         mat4 skinMatrix = 
-              aWeights.x * uBoneMatrices[aBoneIDs.x] +
-              aWeights.y * uBoneMatrices[aBoneIDs.y] +
-              aWeights.z * uBoneMatrices[aBoneIDs.z] +
-              aWeights.w * uBoneMatrices[aBoneIDs.w];
+              aWeights.x * BoneMatrix(aBoneIDs.x) +
+              aWeights.y * BoneMatrix(aBoneIDs.y) +
+              aWeights.z * BoneMatrix(aBoneIDs.z) +
+              aWeights.w * BoneMatrix(aBoneIDs.w);
 
         skinnedPosition = vec3(skinMatrix * vec4(aPosition, 1.0));
     }
@@ -57,6 +57,7 @@ struct Light
 /* === Varyings === */
 
 in vec3 vPosition;
+flat in vec3 vMaterialFactor;   ///< Factors of the emission energy, roughness and metalness of the instance
 in vec2 vTexCoord;
 in vec4 vColor;
 in mat3 vTBN;
@@ -355,15 +356,15 @@ void main()
 
     /* Sample emission texture */
 
-    vec3 emission = uEmissionEnergy * (uEmissionColor * texture(uTexEmission, vTexCoord).rgb);
+    vec3 emission = vMaterialFactor.x * uEmissionEnergy * (uEmissionColor * texture(uTexEmission, vTexCoord).rgb);
 
     /* Sample ORM texture and extract values */
 
     vec3 orm = texture(uTexORM, vTexCoord).rgb;
 
     float occlusion = uOcclusion * orm.x;
-    float roughness = uRoughness * orm.y;
-    float metalness = uMetalness * orm.z;
+    float roughness = vMaterialFactor.y * uRoughness * orm.y;
+    float metalness = vMaterialFactor.z * uMetalness * orm.z;
 
     /* Compute F0 (reflectance at normal incidence) based on the metallic factor */
 
@@ -23,10 +23,6 @@
 
 #define NUM_LIGHTS 8
 
-/* === Constants === */
-
-const int MAX_BONES = 128;
-
 /* === Attributes === */
 
 layout(location = 0) in vec3 aPosition;
@@ -50,18 +46,34 @@ uniform vec4 uAlbedoColor;
 uniform vec2 uTexCoordOffset;
 uniform vec2 uTexCoordScale;
 
-uniform mat4 uBoneMatrices[MAX_BONES];
+uniform samplerBuffer uTexBoneMatrices;
+uniform int uBoneOffset;
 uniform bool uUseSkinning;
 
 /* === Varyings === */
 
 out vec3 vPosition;
+flat out vec3 vMaterialFactor;
 out vec2 vTexCoord;
 out vec4 vColor;
 out mat3 vTBN;
 
 out vec4 vPosLightSpace[NUM_LIGHTS];
 
+/* === Helper functions === */
+
+mat4 BoneMatrix(int boneID)
+{
+    int texel = 3 * (uBoneOffset + boneID);
+
+    return transpose(mat4(
+        texelFetch(uTexBoneMatrices, texel + 0),
+        texelFetch(uTexBoneMatrices, texel + 1),
+        texelFetch(uTexBoneMatrices, texel + 2),
+        vec4(0.0, 0.0, 0.0, 1.0)
+    ));
+}
+
 /* === Main program === */
 
 void main()
@@ -73,10 +85,10 @@ void main()
     if (uUseSkinning)
     {
         mat4 skinMatrix = 
-              aWeights.x * uBoneMatrices[aBoneIDs.x] +
-              aWeights.y * uBoneMatrices[aBoneIDs.y] +
-              aWeights.z * uBoneMatrices[aBoneIDs.z] +
-              aWeights.w * uBoneMatrices[aBoneIDs.w];
+              aWeights.x * BoneMatrix(aBoneIDs.x) +
+              aWeights.y * BoneMatrix(aBoneIDs.y) +
+              aWeights.z * BoneMatrix(aBoneIDs.z) +
+              aWeights.w * BoneMatrix(aBoneIDs.w);
 
         skinnedPosition = vec3(skinMatrix * vec4(aPosition, 1.0));
         skinnedNormal   = mat3(skinMatrix) * aNormal;
@@ -86,6 +98,7 @@ void main()
     vec4 worldPosition = uMatModel * vec4(skinnedPosition, 1.0);
     vPosition = worldPosition.xyz;
     vTexCoord = uTexCoordOffset + aTexCoord * uTexCoordScale;
+    vMaterialFactor = vec3(1.0);
     vColor = aColor * uAlbedoColor;
 
     vec3 T = normalize(vec3(uMatModel * vec4(skinnedTangent, 0.0)));
@@ -26,10 +26,6 @@
 #define BILLBOARD_FRONT 1
 #define BILLBOARD_Y_AXIS 2
 
-/* === Constants === */
-
-const int MAX_BONES = 128;
-
 /* === Attributes === */
 
 layout(location = 0) in vec3 aPosition;
@@ -42,8 +38,11 @@ layout(location = 6) in vec4 aWeights;
 
 /* === Instance attributes === */
 
+layout(location = 8) in vec4 iUVTransform;  ///< UV offset and scale of the instance
+layout(location = 9) in vec4 iParams;       ///< Sprite frame of the instance then factors of the emission energy, roughness and metalness
 layout(location = 10) in mat4 iMatModel;
 layout(location = 14) in vec4 iColor;
+layout(location = 15) in uvec3 iAnimation;  ///< Offsets of the two baked frames to blend, then the bits of the blend factor
 
 /* === Uniforms === */
 
@@ -59,13 +58,22 @@ uniform vec4 uAlbedoColor;
 
 uniform vec2 uTexCoordOffset;
 uniform vec2 uTexCoordScale;
+uniform vec2 uSpriteFrameCount;    ///< Frames of the sprite sheet along X and Y, zero when the frame of 'iParams' is not used
 
-uniform mat4 uBoneMatrices[MAX_BONES];
+uniform samplerBuffer uTexBoneMatrices;
+uniform int uBoneOffset;
 uniform bool uUseSkinning;
+uniform bool uUseInstanceAnimation;
+uniform bool uPackedInstances;
+
+uniform samplerBuffer uTexVertexAnim;
+uniform int uVertexAnimBase;
+uniform bool uUseVertexAnimation;
 
 /* === Varyings === */
 
 out vec3 vPosition;
+flat out vec3 vMaterialFactor;
 out vec2 vTexCoord;
 out vec4 vColor;
 out mat3 vTBN;
@@ -74,6 +82,68 @@ out vec4 vPosLightSpace[NUM_LIGHTS];
 
 /* === Helper functions === */
 
+vec2 InstanceTexCoord(vec2 texCoord)
+{
+    // Transform of the instance first, within its sprite frame if any, then the one of the material
+    vec2 uv = iUVTransform.xy + texCoord * iUVTransform.zw;
+
+    // Same layout as 'r3d_sprite_get_uv_scale_offset', frames are read row by row and flipped along Y
+    if (uSpriteFrameCount.x > 0.0) {
+        float frameCount = uSpriteFrameCount.x * uSpriteFrameCount.y;
+        float frame = mod(floor(iParams.x), frameCount);
+        vec2 cell = vec2(mod(frame, uSpriteFrameCount.x), floor(frame / uSpriteFrameCount.x));
+        uv = (cell + vec2(uv.x, 1.0 - uv.y)) / uSpriteFrameCount;
+    }
+
+    return uTexCoordOffset + uv * uTexCoordScale;
+}
+
+mat4 InstanceMatrix(mat4 instance)
+{
+    if (!uPackedInstances) {
+        return transpose(instance);
+    }
+
+    // Packed instance: position, rotation quaternion and scale, see 'R3D_PackedInstance'
+    vec3 position = instance[0].xyz;
+    vec4 q = normalize(instance[1]);
+    vec3 scale = instance[2].xyz;
+
+    mat3 rotation = mat3(
+        1.0 - 2.0 * (q.y * q.y + q.z * q.z), 2.0 * (q.x * q.y + q.z * q.w), 2.0 * (q.x * q.z - q.y * q.w),
+        2.0 * (q.x * q.y - q.z * q.w), 1.0 - 2.0 * (q.x * q.x + q.z * q.z), 2.0 * (q.y * q.z + q.x * q.w),
+        2.0 * (q.x * q.z + q.y * q.w), 2.0 * (q.y * q.z - q.x * q.w), 1.0 - 2.0 * (q.x * q.x + q.y * q.y)
+    );
+
+    // The scale applies to the rows, after the rotation
+    return mat4(
+        vec4(rotation[0] * scale, 0.0),
+        vec4(rotation[1] * scale, 0.0),
+        vec4(rotation[2] * scale, 0.0),
+        vec4(position, 1.0)
+    );
+}
+
+mat4 BoneMatrix(int boneOffset, int boneID)
+{
+    int texel = 3 * (boneOffset + boneID);
+
+    return transpose(mat4(
+        texelFetch(uTexBoneMatrices, texel + 0),
+        texelFetch(uTexBoneMatrices, texel + 1),
+        texelFetch(uTexBoneMatrices, texel + 2),
+        vec4(0.0, 0.0, 0.0, 1.0)
+    ));
+}
+
+mat4 SkinMatrix(int boneOffset)
+{
+    return aWeights.x * BoneMatrix(boneOffset, aBoneIDs.x) +
+           aWeights.y * BoneMatrix(boneOffset, aBoneIDs.y) +
+           aWeights.z * BoneMatrix(boneOffset, aBoneIDs.z) +
+           aWeights.w * BoneMatrix(boneOffset, aBoneIDs.w);
+}
+
 void BillboardFront(inout mat4 model, inout mat3 normal)
 {
     // Extract the original scales of the model
@@ -134,23 +204,42 @@ void main()
     vec3 skinnedNormal = aNormal;
     vec3 skinnedTangent = aTangent.xyz;
 
-    if (uUseSkinning)
+    if (uUseVertexAnimation)
+    {
+        float blend = uintBitsToFloat(iAnimation.z);
+
+        // Each vertex is stored as a position texel followed by a normal texel
+        int texel0 = 2 * (int(iAnimation.x) + uVertexAnimBase + gl_VertexID);
+        int texel1 = 2 * (int(iAnimation.y) + uVertexAnimBase + gl_VertexID);
+
+        skinnedPosition = mix(texelFetch(uTexVertexAnim, texel0).xyz, texelFetch(uTexVertexAnim, texel1).xyz, blend);
+        skinnedNormal = normalize(mix(texelFetch(uTexVertexAnim, texel0 + 1).xyz, texelFetch(uTexVertexAnim, texel1 + 1).xyz, blend));
+        skinnedTangent = normalize(skinnedTangent - skinnedNormal * dot(skinnedNormal, skinnedTangent));
+    }
+    else if (uUseSkinning)
     {
-        mat4 skinMatrix = 
-              aWeights.x * uBoneMatrices[aBoneIDs.x] +
-              aWeights.y * uBoneMatrices[aBoneIDs.y] +
-              aWeights.z * uBoneMatrices[aBoneIDs.z] +
-              aWeights.w * uBoneMatrices[aBoneIDs.w];
+        mat4 skinMatrix;
+
+        // Each instance blends two frames of the baked animation texture
+        if (uUseInstanceAnimation) {
+            float blend = uintBitsToFloat(iAnimation.z);
+            skinMatrix = SkinMatrix(int(iAnimation.x)) * (1.0 - blend) +
+                         SkinMatrix(int(iAnimation.y)) * blend;
+        }
+        else {
+            skinMatrix = SkinMatrix(uBoneOffset);
+        }
 
         skinnedPosition = vec3(skinMatrix * vec4(aPosition, 1.0));
         skinnedNormal   = mat3(skinMatrix) * aNormal;
         skinnedTangent  = mat3(skinMatrix) * aTangent.xyz;
     }
 
-    vTexCoord = uTexCoordOffset + aTexCoord * uTexCoordScale;
+    vTexCoord = InstanceTexCoord(aTexCoord);
+    vMaterialFactor = iParams.yzw;
     vColor = aColor * iColor * uAlbedoColor;
 
-    mat4 matModel = uMatModel * transpose(iMatModel);
+    mat4 matModel = uMatModel * InstanceMatrix(iMatModel);
     mat3 matNormal = mat3(0.0);
 
     if (uBillboardMode == BILLBOARD_FRONT) BillboardFront(matModel, matNormal);
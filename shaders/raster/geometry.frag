@@ -23,6 +23,7 @@
 /* === Varyings === */
 
 flat in vec3 vEmission;
+flat in vec3 vMaterialFactor;   ///< Factors of the emission energy, roughness and metalness of the instance
 in vec2 vTexCoord;
 in vec3 vColor;
 in mat3 vTBN;
@@ -40,6 +41,10 @@ uniform float uOcclusion;
 uniform float uRoughness;
 uniform float uMetalness;
 
+#ifdef DITHER
+uniform float uDitherFade;
+#endif
+
 
 /* === Fragments === */
 
@@ -74,18 +79,41 @@ vec2 EncodeOctahedral(vec3 normal)
     return normal.xy;
 }
 
+#ifdef DITHER
+float DitherThreshold()
+{
+    const float bayer[16] = float[16](
+         0.0,  8.0,  2.0, 10.0,
+        12.0,  4.0, 14.0,  6.0,
+         3.0, 11.0,  1.0,  9.0,
+        15.0,  7.0, 13.0,  5.0
+    );
+
+    ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+    return (bayer[p.y * 4 + p.x] + 0.5) / 16.0;
+}
+#endif
+
 
 /* === Main function === */
 
 void main()
 {
+#ifdef DITHER
+    // Positive values fade in, negative values fade out with the complementary pattern
+    // Only compiled in the variant used by fading draws, discarding disables early depth testing
+    float threshold = DitherThreshold();
+    if (uDitherFade > 0.0 && threshold >= uDitherFade) discard;
+    if (uDitherFade < 0.0 && threshold < -uDitherFade) discard;
+#endif
+
     FragAlbedo = vColor * texture(uTexAlbedo, vTexCoord).rgb;
-    FragEmission = vEmission * texture(uTexEmission, vTexCoord).rgb;
+    FragEmission = vMaterialFactor.x * vEmission * texture(uTexEmission, vTexCoord).rgb;
     FragNormal = EncodeOctahedral(normalize(vTBN * NormalScale(texture(uTexNormal, vTexCoord).rgb * 2.0 - 1.0, uNormalScale)));
 
     vec3 orm = texture(uTexORM, vTexCoord).rgb;
 
     FragORM.r = uOcclusion * orm.x;
-    FragORM.g = uRoughness * orm.y;
-    FragORM.b = uMetalness * orm.z;
+    FragORM.g = vMaterialFactor.y * uRoughness * orm.y;
+    FragORM.b = vMaterialFactor.z * uMetalness * orm.z;
 }
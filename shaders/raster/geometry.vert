@@ -19,10 +19,6 @@
 
 #version 330 core
 
-/* === Constants === */
-
-const int MAX_BONES = 128;
-
 /* === Attributes === */
 
 layout(location = 0) in vec3 aPosition;
@@ -46,16 +42,32 @@ uniform vec3 uAlbedoColor;
 uniform vec2 uTexCoordOffset;
 uniform vec2 uTexCoordScale;
 
-uniform mat4 uBoneMatrices[MAX_BONES];
+uniform samplerBuffer uTexBoneMatrices;
+uniform int uBoneOffset;
 uniform bool uUseSkinning;
 
 /* === Varyings === */
 
 flat out vec3 vEmission;
+flat out vec3 vMaterialFactor;
 out vec2 vTexCoord;
 out vec3 vColor;
 out mat3 vTBN;
 
+/* === Helper functions === */
+
+mat4 BoneMatrix(int boneID)
+{
+    int texel = 3 * (uBoneOffset + boneID);
+
+    return transpose(mat4(
+        texelFetch(uTexBoneMatrices, texel + 0),
+        texelFetch(uTexBoneMatrices, texel + 1),
+        texelFetch(uTexBoneMatrices, texel + 2),
+        vec4(0.0, 0.0, 0.0, 1.0)
+    ));
+}
+
 /* === Main function === */
 
 void main()
@@ -67,10 +79,10 @@ void main()
     if (uUseSkinning)
     {
         mat4 skinMatrix = 
-              aWeights.x * uBoneMatrices[aBoneIDs.x] +
-              aWeights.y * uBoneMatrices[aBoneIDs.y] +
-              aWeights.z * uBoneMatrices[aBoneIDs.z] +
-              aWeights.w * uBoneMatrices[aBoneIDs.w];
+              aWeights.x * BoneMatrix(aBoneIDs.x) +
+              aWeights.y * BoneMatrix(aBoneIDs.y) +
+              aWeights.z * BoneMatrix(aBoneIDs.z) +
+              aWeights.w * BoneMatrix(aBoneIDs.w);
 
         skinnedPosition = vec3(skinMatrix * vec4(aPosition, 1.0));
         skinnedNormal   = mat3(skinMatrix) * aNormal;
@@ -80,6 +92,7 @@ void main()
     vTexCoord = uTexCoordOffset + aTexCoord * uTexCoordScale;
     vColor = aColor.rgb * uAlbedoColor;
     vEmission = uEmissionColor * uEmissionEnergy;
+    vMaterialFactor = vec3(1.0);
 
     vec3 T = normalize(vec3(uMatModel * vec4(skinnedTangent, 0.0)));
     vec3 N = normalize(vec3(uMatNormal * vec4(skinnedNormal, 0.0)));
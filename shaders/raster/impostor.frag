@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#version 330 core
+
+
+/* === Varyings === */
+
+in vec2 vFrameTexCoord[4];
+flat in ivec4 vFrameIndices;
+flat in vec4 vFrameWeights;
+in vec4 vClipPosition;
+flat in vec4 vClipDirection;
+flat in mat3 vMatNormal;
+
+
+/* === Uniforms === */
+
+uniform sampler2D uTexAlbedo;
+uniform sampler2D uTexEmission;
+uniform sampler2D uTexNormal;
+uniform sampler2D uTexORM;
+uniform sampler2D uTexDepth;
+
+uniform int uFrames;
+uniform float uDitherFade;
+
+
+/* === Fragments === */
+
+layout(location = 0) out vec3 FragAlbedo;
+layout(location = 1) out vec3 FragEmission;
+layout(location = 2) out vec2 FragNormal;
+layout(location = 3) out vec3 FragORM;
+
+
+/* === Helper functions === */
+
+vec2 OctahedronWrap(vec2 val)
+{
+    return (1.0 - abs(val.yx)) * mix(vec2(-1.0), vec2(1.0), vec2(greaterThanEqual(val.xy, vec2(0.0))));
+}
+
+vec2 EncodeOctahedral(vec3 normal)
+{
+    normal /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+    normal.xy = normal.z >= 0.0 ? normal.xy : OctahedronWrap(normal.xy);
+    normal.xy = normal.xy * 0.5 + 0.5;
+    return normal.xy;
+}
+
+vec3 DecodeOctahedral(vec2 encoded)
+{
+    encoded = encoded * 2.0 - 1.0;
+
+    vec3 normal;
+    normal.z  = 1.0 - abs(encoded.x) - abs(encoded.y);
+    normal.xy = normal.z >= 0.0 ? encoded.xy : OctahedronWrap(encoded.xy);
+    return normalize(normal);
+}
+
+float DitherThreshold()
+{
+    const float bayer[16] = float[16](
+         0.0,  8.0,  2.0, 10.0,
+        12.0,  4.0, 14.0,  6.0,
+         3.0, 11.0,  1.0,  9.0,
+        15.0,  7.0, 13.0,  5.0
+    );
+
+    ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+    return (bayer[p.y * 4 + p.x] + 0.5) / 16.0;
+}
+
+
+/* === Main function === */
+
+void main()
+{
+    // Positive values fade in, negative values fade out with the complementary pattern
+    if (uDitherFade != 0.0) {
+        float threshold = DitherThreshold();
+        if (uDitherFade > 0.0 && threshold >= uDitherFade) discard;
+        if (uDitherFade < 0.0 && threshold < -uDitherFade) discard;
+    }
+
+    vec3 albedo = vec3(0.0);
+    vec3 emission = vec3(0.0);
+    vec3 normal = vec3(0.0);
+    vec3 orm = vec3(0.0);
+    float depth = 0.0;
+    float weight = 0.0;
+
+    // Blend the four nearest views, ignoring the background of each frame
+    for (int i = 0; i < 4; i++)
+    {
+        vec2 uv = vFrameTexCoord[i];
+        if (vFrameWeights[i] <= 0.0 || any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) {
+            continue;
+        }
+
+        ivec2 frame = ivec2(vFrameIndices[i] % uFrames, vFrameIndices[i] / uFrames);
+        vec2 texCoord = (vec2(frame) + uv) / float(uFrames);
+
+        float frameDepth = texture(uTexDepth, texCoord).r;
+        if (frameDepth >= 1.0) continue;
+
+        float w = vFrameWeights[i];
+        albedo += w * texture(uTexAlbedo, texCoord).rgb;
+        emission += w * texture(uTexEmission, texCoord).rgb;
+        normal += w * DecodeOctahedral(texture(uTexNormal, texCoord).rg);
+        orm += w * texture(uTexORM, texCoord).rgb;
+        depth += w * frameDepth;
+        weight += w;
+    }
+
+    if (weight < 0.5) discard;
+
+    float invWeight = 1.0 / weight;
+
+    FragAlbedo = albedo * invWeight;
+    FragEmission = emission * invWeight;
+    FragNormal = EncodeOctahedral(normalize(vMatNormal * normal));
+    FragORM = orm * invWeight;
+
+    // The frame depth goes from the front (0) to the back (1) of the bounding sphere
+    vec4 clipPosition = vClipPosition + vClipDirection * (1.0 - 2.0 * depth * invWeight);
+    gl_FragDepth = 0.5 * (clipPosition.z / clipPosition.w) + 0.5;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#version 330 core
+
+/* === Attributes === */
+
+layout(location = 0) in vec3 aPosition;
+
+/* === Uniforms === */
+
+uniform mat4 uMatNormal;
+uniform mat4 uMatModel;
+uniform mat4 uMatVP;
+
+uniform vec3 uViewPosition;
+
+uniform vec3 uCenter;
+uniform float uRadius;
+uniform int uFrames;
+
+/* === Varyings === */
+
+out vec2 vFrameTexCoord[4];
+flat out ivec4 vFrameIndices;
+flat out vec4 vFrameWeights;
+out vec4 vClipPosition;
+flat out vec4 vClipDirection;
+flat out mat3 vMatNormal;
+
+/* === Helper functions === */
+
+vec2 OctahedronWrap(vec2 val)
+{
+    return (1.0 - abs(val.yx)) * mix(vec2(-1.0), vec2(1.0), vec2(greaterThanEqual(val.xy, vec2(0.0))));
+}
+
+vec2 EncodeOctahedral(vec3 normal)
+{
+    normal /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+    normal.xy = normal.z >= 0.0 ? normal.xy : OctahedronWrap(normal.xy);
+    normal.xy = normal.xy * 0.5 + 0.5;
+    return normal.xy;
+}
+
+vec3 DecodeOctahedral(vec2 encoded)
+{
+    encoded = encoded * 2.0 - 1.0;
+
+    vec3 normal;
+    normal.z  = 1.0 - abs(encoded.x) - abs(encoded.y);
+    normal.xy = normal.z >= 0.0 ? encoded.xy : OctahedronWrap(encoded.xy);
+    return normalize(normal);
+}
+
+void FrameBasis(vec3 dir, out vec3 right, out vec3 up)
+{
+    // Must match the view basis used when baking the frames
+    vec3 ref = (abs(dir.y) > 0.999) ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    right = normalize(cross(ref, dir));
+    up = cross(dir, right);
+}
+
+/* === Main function === */
+
+void main()
+{
+    // Direction from the impostor center to the camera, in model space
+    vec3 viewDir = normalize(vec3(inverse(uMatModel) * vec4(uViewPosition, 1.0)) - uCenter);
+
+    // Camera-facing quad covering the bounding sphere
+    vec3 right, up;
+    FrameBasis(viewDir, right, up);
+    vec3 offset = (aPosition.x * right + aPosition.y * up) * uRadius;
+
+    // Select the four frames surrounding the view direction in the octahedral grid
+    // The octahedron is oriented so that the center of the atlas looks from the top (+Y)
+    vec2 grid = EncodeOctahedral(viewDir.xzy) * float(uFrames) - 0.5;
+    vec2 cell = floor(grid);
+    vec2 f = grid - cell;
+
+    vFrameWeights = vec4((1.0 - f.x) * (1.0 - f.y), f.x * (1.0 - f.y), (1.0 - f.x) * f.y, f.x * f.y);
+
+    for (int i = 0; i < 4; i++)
+    {
+        ivec2 frame = clamp(ivec2(cell) + ivec2(i & 1, i >> 1), ivec2(0), ivec2(uFrames - 1));
+        vec3 frameDir = DecodeOctahedral((vec2(frame) + 0.5) / float(uFrames)).xzy;
+
+        // Orthographic projection of the quad point in the frame
+        vec3 frameRight, frameUp;
+        FrameBasis(frameDir, frameRight, frameUp);
+        vFrameTexCoord[i] = vec2(dot(offset, frameRight), dot(offset, frameUp)) / (2.0 * uRadius) + 0.5;
+        vFrameIndices[i] = frame.y * uFrames + frame.x;
+    }
+
+    mat4 matMVP = uMatVP * uMatModel;
+
+    vClipPosition = matMVP * vec4(uCenter + offset, 1.0);
+    vClipDirection = matMVP * vec4(viewDir * uRadius, 0.0);
+    vMatNormal = mat3(uMatNormal);
+
+    gl_Position = vClipPosition;
+}
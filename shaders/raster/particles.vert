@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#version 330 core
+
+/* === Defines === */
+
+#define DEG2RAD (3.14159265358979 / 180.0)
+
+// Must match R3D_CURVE_LUT_RESOLUTION
+#define CURVE_LUT_RESOLUTION 256
+
+/* === Attributes (state of the previous update, one vertex per particle) === */
+
+layout(location = 0) in vec4 aTransform0;
+layout(location = 1) in vec4 aTransform1;
+layout(location = 2) in vec4 aTransform2;
+layout(location = 3) in vec4 aTransform3;
+layout(location = 4) in vec4 aColor;
+layout(location = 5) in vec4 aPositionLife;
+layout(location = 6) in vec4 aVelocity;
+layout(location = 7) in vec4 aBaseVelocity;
+layout(location = 8) in vec4 aRotation;
+layout(location = 9) in vec4 aBaseAngularVelocity;
+layout(location = 10) in vec4 aBaseScaleOpacity;
+
+/* === Uniforms === */
+
+uniform float uDeltaTime;
+uniform vec3 uGravity;
+
+uniform int uCapacity;
+uniform int uEmitFirst;
+uniform int uEmitCount;
+uniform int uSeed;
+
+uniform vec3 uPosition;
+uniform vec3 uInitialScale;
+uniform float uScaleVariance;
+uniform vec3 uInitialRotation;
+uniform vec3 uRotationVariance;
+uniform vec4 uInitialColor;
+uniform vec4 uColorVariance;
+uniform vec3 uInitialVelocity;
+uniform vec3 uVelocityVariance;
+uniform vec3 uInitialAngularVelocity;
+uniform vec3 uAngularVelocityVariance;
+uniform float uLifetime;
+uniform float uLifetimeVariance;
+uniform float uSpreadAngle;
+
+uniform sampler1D uTexCurves;   //< Lookup tables of the scale, speed, opacity and angular velocity curves
+uniform vec4 uCurveMask;        //< 1.0 for each curve in use, 0.0 otherwise
+
+/* === Varyings (captured by transform feedback) === */
+
+out vec4 vTransform0;
+out vec4 vTransform1;
+out vec4 vTransform2;
+out vec4 vTransform3;
+out vec4 vColor;
+out vec4 vPositionLife;
+out vec4 vVelocity;
+out vec4 vBaseVelocity;
+out vec4 vRotation;
+out vec4 vBaseAngularVelocity;
+out vec4 vBaseScaleOpacity;
+
+/* === Random numbers === */
+
+uint gRandState;
+
+uint Hash(uint x)
+{
+    uint state = x * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+float RandF()
+{
+    gRandState = Hash(gRandState);
+    return float(gRandState >> 8u) * (1.0 / 16777215.0);
+}
+
+float RandRange(float min, float max)
+{
+    return min + RandF() * (max - min);
+}
+
+vec3 RandVariance(vec3 variance)
+{
+    return vec3(
+        RandRange(-variance.x, variance.x),
+        RandRange(-variance.y, variance.y),
+        RandRange(-variance.z, variance.z)
+    );
+}
+
+float RandColorChannel(float value, float variance)
+{
+    // Same as 'GetRandomValue(-variance, variance)' then a cast to unsigned char
+    float offset = min(floor(RandF() * (2.0 * variance + 1.0)), 2.0 * variance) - variance;
+    return mod(value + offset, 256.0);
+}
+
+/* === Helper functions === */
+
+vec4 EvaluateCurves(float time)
+{
+    float x = clamp(time, 0.0, 1.0) * float(CURVE_LUT_RESOLUTION);
+    int i = int(min(x, float(CURVE_LUT_RESOLUTION - 1)));
+
+    vec4 a = texelFetch(uTexCurves, i, 0);
+    vec4 b = texelFetch(uTexCurves, i + 1, 0);
+
+    return a + (x - float(i)) * (b - a);
+}
+
+vec3 EmitVelocity()
+{
+    float speed = length(uInitialVelocity);
+    if (speed == 0.0) return vec3(0.0);
+
+    vec3 direction = uInitialVelocity / speed;
+
+    // Random direction within the cone, in its local space
+    float elevation = RandRange(0.0, uSpreadAngle * DEG2RAD);
+    float azimuth = RandRange(0.0, 2.0 * 3.14159265358979);
+
+    float cosElevation = cos(elevation);
+    float sinElevation = sqrt(1.0 - cosElevation * cosElevation);
+
+    vec3 spreadDirection = vec3(
+        sinElevation * cos(azimuth),
+        sinElevation * sin(azimuth),
+        cosElevation
+    );
+
+    // Local basis around 'direction'
+    vec3 arbitraryAxis = (abs(direction.y) > 0.9999) ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 binormal = normalize(cross(arbitraryAxis, direction));
+    vec3 normal = cross(direction, binormal);
+
+    vec3 velocity = spreadDirection.x * binormal + spreadDirection.y * normal + spreadDirection.z * direction;
+
+    return velocity * speed;
+}
+
+/* === Main function === */
+
+void main()
+{
+    vec4 color = aColor;
+    vec3 position = aPositionLife.xyz;
+    float lifetime = aPositionLife.w;
+    vec3 velocity = aVelocity.xyz;
+    vec3 baseVelocity = aBaseVelocity.xyz;
+    vec3 rotation = aRotation.xyz;
+    vec3 baseAngularVelocity = aBaseAngularVelocity.xyz;
+    vec3 baseScale = aBaseScaleOpacity.xyz;
+    float baseOpacity = aBaseScaleOpacity.w;
+
+    /* --- Emit a particle in this slot if it is part of this update's window and free --- */
+
+    int window = (gl_VertexID - uEmitFirst + uCapacity) % uCapacity;
+
+    if (window < uEmitCount && lifetime <= 0.0)
+    {
+        gRandState = Hash(uint(gl_VertexID) ^ Hash(uint(uSeed)));
+
+        lifetime = uLifetime + RandRange(-uLifetimeVariance, uLifetimeVariance);
+        position = uPosition;
+        rotation = (uInitialRotation + RandVariance(uRotationVariance)) * DEG2RAD;
+        baseScale = uInitialScale + RandRange(-uScaleVariance, uScaleVariance);
+        baseVelocity = velocity = EmitVelocity() + RandVariance(uVelocityVariance);
+        baseAngularVelocity = uInitialAngularVelocity + RandVariance(uAngularVelocityVariance);
+
+        color = vec4(
+            RandColorChannel(uInitialColor.r, uColorVariance.r),
+            RandColorChannel(uInitialColor.g, uColorVariance.g),
+            RandColorChannel(uInitialColor.b, uColorVariance.b),
+            RandColorChannel(uInitialColor.a, uColorVariance.a)
+        ) / 255.0;
+
+        baseOpacity = color.a * 255.0;
+    }
+
+    /* --- Age the particle, dead particles are collapsed to a point --- */
+
+    lifetime -= uDeltaTime;
+
+    if (lifetime <= 0.0)
+    {
+        vTransform0 = vTransform1 = vTransform2 = vTransform3 = vec4(0.0);
+        vColor = vec4(0.0);
+        vPositionLife = vec4(position, 0.0);
+        vVelocity = vec4(velocity, 0.0);
+        vBaseVelocity = vec4(baseVelocity, 0.0);
+        vRotation = vec4(rotation, 0.0);
+        vBaseAngularVelocity = vec4(baseAngularVelocity, 0.0);
+        vBaseScaleOpacity = vec4(baseScale, baseOpacity);
+        return;
+    }
+
+    /* --- Apply the curves over the lifetime --- */
+
+    vec4 curves = EvaluateCurves(1.0 - lifetime / uLifetime);
+
+    vec3 scale = baseScale;
+    vec3 angularVelocity = baseAngularVelocity;
+
+    if (uCurveMask.x > 0.0) {
+        scale = baseScale * curves.x;
+    }
+
+    if (uCurveMask.y > 0.0) {
+        velocity = baseVelocity * curves.y;
+    }
+
+    if (uCurveMask.z > 0.0) {
+        color.a = floor(clamp(baseOpacity * curves.z, 0.0, 255.0)) / 255.0;
+    }
+
+    if (uCurveMask.w > 0.0) {
+        angularVelocity = baseAngularVelocity * curves.w;
+    }
+
+    /* --- Integrate the motion and rebuild the transform --- */
+
+    rotation += angularVelocity * uDeltaTime * DEG2RAD;
+    position += velocity * uDeltaTime;
+
+    float cx = cos(rotation.x), sx = sin(rotation.x);
+    float cy = cos(rotation.y), sy = sin(rotation.y);
+    float cz = cos(rotation.z), sz = sin(rotation.z);
+
+    // Rows in the memory order of a raylib 'Matrix', as read by the instanced shaders
+    vTransform0 = vec4(scale.x * (cy*cz), scale.x * (-cy*sz), scale.x * sy, position.x);
+    vTransform1 = vec4(scale.y * (sx*sy*cz + cx*sz), scale.y * (-sx*sy*sz + cx*cz), scale.y * (-sx*cy), position.y);
+    vTransform2 = vec4(scale.z * (-cx*sy*cz + sx*sz), scale.z * (cx*sy*sz + sx*cz), scale.z * (cx*cy), position.z);
+    vTransform3 = vec4(0.0, 0.0, 0.0, 1.0);
+
+    velocity += uGravity * uDeltaTime;
+
+    vColor = color;
+    vPositionLife = vec4(position, lifetime);
+    vVelocity = vec4(velocity, 0.0);
+    vBaseVelocity = vec4(baseVelocity, 0.0);
+    vRotation = vec4(rotation, 0.0);
+    vBaseAngularVelocity = vec4(baseAngularVelocity, 0.0);
+    vBaseScaleOpacity = vec4(baseScale, baseOpacity);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#version 330 core
+
+/* === Attributes === */
+
+layout(location = 0) in vec3 aPosition;
+layout(location = 2) in vec3 aNormal;
+layout(location = 4) in vec4 aTangent;
+layout(location = 5) in ivec4 aBoneIDs;
+layout(location = 6) in vec4 aWeights;
+
+/* === Uniforms === */
+
+uniform samplerBuffer uTexBoneMatrices;
+uniform int uBoneOffset;
+
+/* === Varyings (captured by transform feedback) === */
+
+out vec3 vPosition;
+out vec3 vNormal;
+out vec4 vTangent;
+
+/* === Helper functions === */
+
+mat4 BoneMatrix(int boneID)
+{
+    int texel = 3 * (uBoneOffset + boneID);
+
+    return transpose(mat4(
+        texelFetch(uTexBoneMatrices, texel + 0),
+        texelFetch(uTexBoneMatrices, texel + 1),
+        texelFetch(uTexBoneMatrices, texel + 2),
+        vec4(0.0, 0.0, 0.0, 1.0)
+    ));
+}
+
+/* === Main function === */
+
+void main()
+{
+    mat4 skinMatrix =
+          aWeights.x * BoneMatrix(aBoneIDs.x) +
+          aWeights.y * BoneMatrix(aBoneIDs.y) +
+          aWeights.z * BoneMatrix(aBoneIDs.z) +
+          aWeights.w * BoneMatrix(aBoneIDs.w);
+
+    vPosition = vec3(skinMatrix * vec4(aPosition, 1.0));
+    vNormal = mat3(skinMatrix) * aNormal;
+    vTangent = vec4(mat3(skinMatrix) * aTangent.xyz, aTangent.w);
+}
@@ -0,0 +1,1043 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_anim.h"
+
+#include "./r3d_math.h"
+#include "./r3d_simd.h"
+#include "./misc/r3d_half.h"
+
+#include <raylib.h>
+#include <raymath.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+/* === Internal constants === */
+
+#define R3D_ANIM_UNORM_MAX 65535.0f
+#define R3D_ANIM_SNORM_MAX 32767.0f
+
+/* === Internal types === */
+
+typedef enum {
+    R3D_ANIM_CHANNEL_TRANSLATION,
+    R3D_ANIM_CHANNEL_ROTATION,
+    R3D_ANIM_CHANNEL_SCALE
+} r3d_anim_channel_e;
+
+/* === Internal functions (decomposition) === */
+
+// Returns false if the basis is sheared, the shear being dropped from the decomposition
+static bool r3d_anim_decompose(const Matrix* m, Vector3* t, Quaternion* r, Vector3* s)
+{
+    // Inverse of 'r3d_matrix_scale_rotq_translate', each row of the basis is scaled
+    *t = (Vector3) { m->m12, m->m13, m->m14 };
+
+    float row[3][3] = {
+        { m->m0, m->m4, m->m8 },
+        { m->m1, m->m5, m->m9 },
+        { m->m2, m->m6, m->m10 }
+    };
+
+    float sc[3];
+    for (int i = 0; i < 3; i++) {
+        sc[i] = sqrtf(row[i][0] * row[i][0] + row[i][1] * row[i][1] + row[i][2] * row[i][2]);
+    }
+
+    float det = row[0][0] * (row[1][1] * row[2][2] - row[1][2] * row[2][1])
+              - row[0][1] * (row[1][0] * row[2][2] - row[1][2] * row[2][0])
+              + row[0][2] * (row[1][0] * row[2][1] - row[1][1] * row[2][0]);
+
+    if (det < 0.0f) sc[0] = -sc[0];
+
+    for (int i = 0; i < 3; i++) {
+        float inv = (fabsf(sc[i]) > 1e-12f) ? 1.0f / sc[i] : 0.0f;
+        for (int j = 0; j < 3; j++) row[i][j] *= inv;
+    }
+
+    *s = (Vector3) { sc[0], sc[1], sc[2] };
+
+    // Without shear the normalized rows are orthogonal
+    float skew = fmaxf(fabsf(row[0][0] * row[1][0] + row[0][1] * row[1][1] + row[0][2] * row[1][2]),
+                 fmaxf(fabsf(row[0][0] * row[2][0] + row[0][1] * row[2][1] + row[0][2] * row[2][2]),
+                       fabsf(row[1][0] * row[2][0] + row[1][1] * row[2][1] + row[1][2] * row[2][2])));
+
+    // Rotation matrix to quaternion
+    float trace = row[0][0] + row[1][1] + row[2][2];
+    Quaternion q;
+
+    if (trace > 0.0f) {
+        float k = 0.5f / sqrtf(trace + 1.0f);
+        q.w = 0.25f / k;
+        q.x = (row[2][1] - row[1][2]) * k;
+        q.y = (row[0][2] - row[2][0]) * k;
+        q.z = (row[1][0] - row[0][1]) * k;
+    }
+    else if (row[0][0] > row[1][1] && row[0][0] > row[2][2]) {
+        float k = 2.0f * sqrtf(1.0f + row[0][0] - row[1][1] - row[2][2]);
+        q.w = (row[2][1] - row[1][2]) / k;
+        q.x = 0.25f * k;
+        q.y = (row[0][1] + row[1][0]) / k;
+        q.z = (row[0][2] + row[2][0]) / k;
+    }
+    else if (row[1][1] > row[2][2]) {
+        float k = 2.0f * sqrtf(1.0f + row[1][1] - row[0][0] - row[2][2]);
+        q.w = (row[0][2] - row[2][0]) / k;
+        q.x = (row[0][1] + row[1][0]) / k;
+        q.y = 0.25f * k;
+        q.z = (row[1][2] + row[2][1]) / k;
+    }
+    else {
+        float k = 2.0f * sqrtf(1.0f + row[2][2] - row[0][0] - row[1][1]);
+        q.w = (row[1][0] - row[0][1]) / k;
+        q.x = (row[0][2] + row[2][0]) / k;
+        q.y = (row[1][2] + row[2][1]) / k;
+        q.z = 0.25f * k;
+    }
+
+    *r = QuaternionNormalize(q);
+
+    return skew <= 1e-3f;
+}
+
+/* === Internal functions (keyframe reduction) === */
+
+static void r3d_anim_lerp4(float* out, const float* a, const float* b, float t, int n)
+{
+    for (int i = 0; i < n; i++) {
+        out[i] = a[i] + t * (b[i] - a[i]);
+    }
+}
+
+static float r3d_anim_segment_error(const float* values, int stride, int a, int b, int i, bool quat)
+{
+    float t = (float)(i - a) / (float)(b - a);
+    float v[4];
+
+    r3d_anim_lerp4(v, values + a * stride, values + b * stride, t, stride);
+
+    if (quat) {
+        float len = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+        if (len > 1e-12f) for (int k = 0; k < 4; k++) v[k] /= len;
+    }
+
+    float err = 0.0f;
+    for (int k = 0; k < stride; k++) {
+        float d = v[k] - values[i * stride + k];
+        err += d * d;
+    }
+
+    return sqrtf(err);
+}
+
+// Douglas-Peucker reduction, marks in 'keep' the frames that must stay keys
+static int r3d_anim_reduce(bool* keep, const float* values, int stride, int frameCount, float tolerance, bool quat, int* stack)
+{
+    memset(keep, 0, frameCount * sizeof(bool));
+
+    keep[0] = true;
+    keep[frameCount - 1] = true;
+
+    int keyCount = (frameCount > 1) ? 2 : 1;
+    int top = 0;
+
+    if (frameCount > 2) {
+        stack[top++] = 0;
+        stack[top++] = frameCount - 1;
+    }
+
+    while (top > 0)
+    {
+        int b = stack[--top];
+        int a = stack[--top];
+
+        float maxErr = 0.0f;
+        int maxIdx = -1;
+
+        for (int i = a + 1; i < b; i++) {
+            float err = r3d_anim_segment_error(values, stride, a, b, i, quat);
+            if (err > maxErr) {
+                maxErr = err;
+                maxIdx = i;
+            }
+        }
+
+        if (maxIdx < 0 || maxErr <= tolerance) {
+            continue;
+        }
+
+        keep[maxIdx] = true;
+        keyCount++;
+
+        if (maxIdx - a > 1) { stack[top++] = a; stack[top++] = maxIdx; }
+        if (b - maxIdx > 1) { stack[top++] = maxIdx; stack[top++] = b; }
+    }
+
+    // Constant channels only need their first key
+    if (keyCount == 2 && frameCount > 1) {
+        bool constant = true;
+        for (int i = 1; i < frameCount && constant; i++) {
+            for (int k = 0; k < stride; k++) {
+                if (fabsf(values[i * stride + k] - values[k]) > tolerance) {
+                    constant = false;
+                    break;
+                }
+            }
+        }
+        if (constant) {
+            keep[frameCount - 1] = false;
+            keyCount = 1;
+        }
+    }
+
+    return keyCount;
+}
+
+static int r3d_anim_write_channel(
+    R3D_AnimationChannel* channel, unsigned short* data, int offset,
+    const float* values, const bool* keep, int keyCount, int frameCount, bool quat)
+{
+    int stride = quat ? 4 : 3;
+
+    channel->keyCount = keyCount;
+    channel->keyOffset = offset;
+
+    unsigned short* frames = data + offset;
+    unsigned short* words = frames + keyCount;
+
+    /* --- Quantization range of the kept keys --- */
+
+    float vmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float vmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    if (!quat) {
+        for (int f = 0; f < frameCount; f++) {
+            if (!keep[f]) continue;
+            for (int k = 0; k < 3; k++) {
+                vmin[k] = fminf(vmin[k], values[f * 3 + k]);
+                vmax[k] = fmaxf(vmax[k], values[f * 3 + k]);
+            }
+        }
+        channel->offset = (Vector3) { vmin[0], vmin[1], vmin[2] };
+        channel->scale = (Vector3) {
+            (vmax[0] - vmin[0]) / R3D_ANIM_UNORM_MAX,
+            (vmax[1] - vmin[1]) / R3D_ANIM_UNORM_MAX,
+            (vmax[2] - vmin[2]) / R3D_ANIM_UNORM_MAX
+        };
+    }
+    else {
+        channel->offset = (Vector3) { 0 };
+        channel->scale = (Vector3) { 0 };
+    }
+
+    /* --- Write frames and quantized values --- */
+
+    int key = 0;
+
+    for (int f = 0; f < frameCount; f++)
+    {
+        if (!keep[f]) continue;
+
+        frames[key] = (unsigned short)f;
+
+        for (int k = 0; k < stride; k++) {
+            float v = values[f * stride + k];
+            if (quat) {
+                int16_t q = (int16_t)lrintf(Clamp(v, -1.0f, 1.0f) * R3D_ANIM_SNORM_MAX);
+                words[key * stride + k] = (unsigned short)q;
+            }
+            else {
+                float range = vmax[k] - vmin[k];
+                float n = (range > 0.0f) ? (v - vmin[k]) / range : 0.0f;
+                words[key * stride + k] = (unsigned short)lrintf(Clamp(n, 0.0f, 1.0f) * R3D_ANIM_UNORM_MAX);
+            }
+        }
+
+        key++;
+    }
+
+    return offset + keyCount * (1 + stride);
+}
+
+/* === Internal functions (sampling) === */
+
+// Dequantizes two keys of four 16-bit words and interpolates them, the fourth lane is ignored for vectors
+static inline void r3d_anim_decode_lerp(float* out, const unsigned short* a, const unsigned short* b, float t, bool snorm)
+{
+#if defined(R3D_HAS_SSE2)
+    __m128i wa = _mm_loadl_epi64((const __m128i*)a);
+    __m128i wb = _mm_loadl_epi64((const __m128i*)b);
+    __m128i ia, ib;
+    if (snorm) {
+        ia = _mm_srai_epi32(_mm_unpacklo_epi16(wa, wa), 16);
+        ib = _mm_srai_epi32(_mm_unpacklo_epi16(wb, wb), 16);
+    }
+    else {
+        ia = _mm_unpacklo_epi16(wa, _mm_setzero_si128());
+        ib = _mm_unpacklo_epi16(wb, _mm_setzero_si128());
+    }
+    __m128 fa = _mm_cvtepi32_ps(ia);
+    __m128 fb = _mm_cvtepi32_ps(ib);
+    __m128 v = _mm_add_ps(fa, _mm_mul_ps(_mm_sub_ps(fb, fa), _mm_set1_ps(t)));
+    _mm_storeu_ps(out, v);
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    float32x4_t fa, fb;
+    if (snorm) {
+        fa = vcvtq_f32_s32(vmovl_s16(vld1_s16((const int16_t*)a)));
+        fb = vcvtq_f32_s32(vmovl_s16(vld1_s16((const int16_t*)b)));
+    }
+    else {
+        fa = vcvtq_f32_u32(vmovl_u16(vld1_u16(a)));
+        fb = vcvtq_f32_u32(vmovl_u16(vld1_u16(b)));
+    }
+    float32x4_t v = vmlaq_n_f32(fa, vsubq_f32(fb, fa), t);
+    vst1q_f32(out, v);
+#else
+    for (int i = 0; i < 4; i++) {
+        float fa = snorm ? (float)(int16_t)a[i] : (float)a[i];
+        float fb = snorm ? (float)(int16_t)b[i] : (float)b[i];
+        out[i] = fa + t * (fb - fa);
+    }
+#endif
+}
+
+// 'loopEnd' is the frame at which the first key repeats for looping clips, 0 to hold the last key
+static void r3d_anim_sample_channel(float* out, const R3D_AnimationChannel* channel, const unsigned short* data, float frame, float loopEnd, bool quat)
+{
+    int stride = quat ? 4 : 3;
+    const unsigned short* frames = data + channel->keyOffset;
+    const unsigned short* words = frames + channel->keyCount;
+
+    /* --- Find the key preceding the frame --- */
+
+    int lo = 0, hi = channel->keyCount - 1;
+
+    while (lo < hi) {
+        int mid = (lo + hi + 1) >> 1;
+        if ((float)frames[mid] <= frame) lo = mid;
+        else hi = mid - 1;
+    }
+
+    int next = (lo + 1 < channel->keyCount) ? lo + 1 : lo;
+    float t = 0.0f;
+
+    if (next != lo) {
+        t = (frame - frames[lo]) / (float)(frames[next] - frames[lo]);
+        t = Clamp(t, 0.0f, 1.0f);
+    }
+    else if (loopEnd > (float)frames[lo]) {
+        // Past the last key of a looping clip, blend back to the first key
+        next = 0;
+        t = (frame - frames[lo]) / (loopEnd - frames[lo]);
+        t = Clamp(t, 0.0f, 1.0f);
+    }
+
+    /* --- Dequantize and interpolate --- */
+
+    if (next < lo && quat) {
+        // The keys are only kept in the same hemisphere from one frame to the next,
+        // not across the seam of the loop
+        float a[4], b[4];
+        r3d_anim_decode_lerp(a, words + lo * stride, words + lo * stride, 0.0f, true);
+        r3d_anim_decode_lerp(b, words + next * stride, words + next * stride, 0.0f, true);
+        float sign = (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.0f) ? -1.0f : 1.0f;
+        for (int k = 0; k < 4; k++) out[k] = a[k] + t * (sign * b[k] - a[k]);
+    }
+    else {
+        r3d_anim_decode_lerp(out, words + lo * stride, words + next * stride, t, quat);
+    }
+
+    if (quat) {
+        float len = sqrtf(out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3]);
+        float inv = (len > 1e-12f) ? 1.0f / len : 0.0f;
+        for (int k = 0; k < 4; k++) out[k] *= inv;
+    }
+    else {
+        out[0] = channel->offset.x + out[0] * channel->scale.x;
+        out[1] = channel->offset.y + out[1] * channel->scale.y;
+        out[2] = channel->offset.z + out[2] * channel->scale.z;
+        out[3] = 0.0f;
+    }
+}
+
+/* === Internal functions (blending) === */
+
+// Scratch transforms of the sampling and blending functions, taken from the caller's stack buffer
+// of 'R3D_ANIM_STACK_TRANSFORMS' transforms when large enough, so that no state is shared between calls
+static r3d_anim_transform_t* r3d_anim_scratch_alloc(r3d_anim_transform_t* stack, int count)
+{
+    if (count <= R3D_ANIM_STACK_TRANSFORMS) return stack;
+    return RL_MALLOC(count * sizeof(r3d_anim_transform_t));
+}
+
+static void r3d_anim_scratch_free(r3d_anim_transform_t* scratch, const r3d_anim_transform_t* stack)
+{
+    if (scratch != stack) RL_FREE(scratch);
+}
+
+// dst += src * w, on four lanes
+static inline void r3d_anim_madd4(float* dst, const float* src, float w)
+{
+#if defined(R3D_HAS_SSE)
+    __m128 d = _mm_loadu_ps(dst);
+    __m128 v = _mm_loadu_ps(src);
+    _mm_storeu_ps(dst, _mm_add_ps(d, _mm_mul_ps(v, _mm_set1_ps(w))));
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    vst1q_f32(dst, vmlaq_n_f32(vld1q_f32(dst), vld1q_f32(src), w));
+#else
+    dst[0] += src[0] * w;
+    dst[1] += src[1] * w;
+    dst[2] += src[2] * w;
+    dst[3] += src[3] * w;
+#endif
+}
+
+static inline float r3d_anim_dot4(const float* a, const float* b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+static inline void r3d_anim_normalize4(float* q)
+{
+    float len = sqrtf(r3d_anim_dot4(q, q));
+    float inv = (len > 1e-12f) ? 1.0f / len : 0.0f;
+    for (int k = 0; k < 4; k++) q[k] *= inv;
+    if (inv == 0.0f) q[3] = 1.0f;
+}
+
+// Weighted accumulation of a pose, rotations are flipped into the hemisphere of the accumulated one
+static void r3d_anim_accumulate(r3d_anim_transform_t* dst, const r3d_anim_transform_t* src, float weight, int count)
+{
+    for (int i = 0; i < count; i++) {
+        float wr = (r3d_anim_dot4(dst[i].rotation, src[i].rotation) < 0.0f) ? -weight : weight;
+        r3d_anim_madd4(dst[i].translation, src[i].translation, weight);
+        r3d_anim_madd4(dst[i].rotation, src[i].rotation, wr);
+        r3d_anim_madd4(dst[i].scale, src[i].scale, weight);
+    }
+}
+
+// Applies the difference between 'src' and 'ref' on top of 'dst', scaled by the weight
+static void r3d_anim_add(r3d_anim_transform_t* dst, const r3d_anim_transform_t* src, const r3d_anim_transform_t* ref, float weight, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        /* --- Translation delta --- */
+
+        float dt[4];
+        for (int k = 0; k < 4; k++) dt[k] = src[i].translation[k] - ref[i].translation[k];
+        r3d_anim_madd4(dst[i].translation, dt, weight);
+
+        /* --- Scale ratio --- */
+
+        for (int k = 0; k < 3; k++) {
+            float r = (fabsf(ref[i].scale[k]) > 1e-6f) ? src[i].scale[k] / ref[i].scale[k] : 1.0f;
+            dst[i].scale[k] *= 1.0f + weight * (r - 1.0f);
+        }
+
+        /* --- Rotation delta, nlerp from identity by the weight --- */
+
+        const float* a = src[i].rotation;
+        const float* b = ref[i].rotation;
+
+        // a * conjugate(b)
+        float dq[4] = {
+            -a[3] * b[0] + a[0] * b[3] - a[1] * b[2] + a[2] * b[1],
+            -a[3] * b[1] + a[1] * b[3] - a[2] * b[0] + a[0] * b[2],
+            -a[3] * b[2] + a[2] * b[3] - a[0] * b[1] + a[1] * b[0],
+             a[3] * b[3] + a[0] * b[0] + a[1] * b[1] + a[2] * b[2]
+        };
+
+        if (dq[3] < 0.0f) for (int k = 0; k < 4; k++) dq[k] = -dq[k];
+
+        for (int k = 0; k < 3; k++) dq[k] *= weight;
+        dq[3] = 1.0f + weight * (dq[3] - 1.0f);
+        r3d_anim_normalize4(dq);
+
+        // dq * dst
+        const float* q = dst[i].rotation;
+        float r[4] = {
+            dq[3] * q[0] + dq[0] * q[3] + dq[1] * q[2] - dq[2] * q[1],
+            dq[3] * q[1] + dq[1] * q[3] + dq[2] * q[0] - dq[0] * q[2],
+            dq[3] * q[2] + dq[2] * q[3] + dq[0] * q[1] - dq[1] * q[0],
+            dq[3] * q[3] - dq[0] * q[0] - dq[1] * q[1] - dq[2] * q[2]
+        };
+
+        r3d_anim_normalize4(r);
+        memcpy(dst[i].rotation, r, sizeof(r));
+    }
+}
+
+static bool r3d_anim_build_bone_order(R3D_ModelAnimation* anim)
+{
+    anim->boneOrder = RL_MALLOC(anim->boneCount * sizeof(int));
+    bool* placed = RL_CALLOC(anim->boneCount, sizeof(bool));
+
+    if (!anim->boneOrder || !placed) {
+        RL_FREE(anim->boneOrder);
+        RL_FREE(placed);
+        anim->boneOrder = NULL;
+        return false;
+    }
+
+    // Repeatedly place the bones whose parent is already placed
+    int count = 0;
+    while (count < anim->boneCount) {
+        int prev = count;
+        for (int i = 0; i < anim->boneCount; i++) {
+            if (placed[i]) continue;
+            int parent = anim->bones[i].parent;
+            if (parent < 0 || parent >= anim->boneCount || placed[parent]) {
+                anim->boneOrder[count++] = i;
+                placed[i] = true;
+            }
+        }
+        // Break hierarchy cycles by detaching the remaining bones
+        if (count == prev) {
+            for (int i = 0; i < anim->boneCount; i++) {
+                if (!placed[i]) {
+                    anim->bones[i].parent = -1;
+                    anim->boneOrder[count++] = i;
+                    placed[i] = true;
+                }
+            }
+        }
+    }
+
+    RL_FREE(placed);
+
+    return true;
+}
+
+// 'scratch' must hold two transforms per bone of the first layer
+static void r3d_anim_blend_layers(const R3D_AnimationLayer* layers, int layerCount, r3d_anim_transform_t* outLocals, r3d_anim_transform_t* scratch)
+{
+    const R3D_ModelAnimation* skeleton = layers[0].anim;
+    int boneCount = skeleton->boneCount;
+
+    r3d_anim_transform_t* sample = scratch;
+    r3d_anim_transform_t* reference = scratch + boneCount;
+
+    /* --- Cross-fade the regular layers --- */
+
+    memset(outLocals, 0, boneCount * sizeof(r3d_anim_transform_t));
+    float totalWeight = 0.0f;
+
+    for (int i = 0; i < layerCount; i++) {
+        const R3D_AnimationLayer* layer = &layers[i];
+        if (layer->additive || layer->weight <= 0.0f) continue;
+        if (layer->anim == NULL || layer->anim->boneCount != boneCount) continue;
+
+        r3d_anim_sample_local(layer->anim, r3d_anim_wrap_frame(layer->anim, layer->frame), true, sample);
+        r3d_anim_accumulate(outLocals, sample, layer->weight, boneCount);
+        totalWeight += layer->weight;
+    }
+
+    if (totalWeight > 1e-6f) {
+        float inv = 1.0f / totalWeight;
+        for (int b = 0; b < boneCount; b++) {
+            for (int k = 0; k < 4; k++) {
+                outLocals[b].translation[k] *= inv;
+                outLocals[b].scale[k] *= inv;
+            }
+            r3d_anim_normalize4(outLocals[b].rotation);
+        }
+    }
+    else {
+        // Only additive layers, they are applied on top of the first frame of the first clip
+        r3d_anim_sample_local(skeleton, 0.0f, false, outLocals);
+    }
+
+    /* --- Apply the additive layers --- */
+
+    for (int i = 0; i < layerCount; i++) {
+        const R3D_AnimationLayer* layer = &layers[i];
+        if (!layer->additive || layer->weight == 0.0f) continue;
+        if (layer->anim == NULL || layer->anim->boneCount != boneCount) continue;
+
+        r3d_anim_sample_local(layer->anim, r3d_anim_wrap_frame(layer->anim, layer->frame), true, sample);
+        r3d_anim_sample_local(layer->anim, 0.0f, false, reference);
+        r3d_anim_add(outLocals, sample, reference, layer->weight, boneCount);
+    }
+}
+
+/* === Public functions === */
+
+bool r3d_anim_compress(R3D_ModelAnimation* anim, const Matrix* localPoses, float tolerance)
+{
+    int boneCount = anim->boneCount;
+    int frameCount = anim->frameCount;
+
+    if (boneCount <= 0 || frameCount <= 0 || frameCount > 65536) {
+        return false;
+    }
+
+    size_t sampleCount = (size_t)frameCount * boneCount;
+
+    Vector3* translations = RL_MALLOC(sampleCount * sizeof(Vector3));
+    Quaternion* rotations = RL_MALLOC(sampleCount * sizeof(Quaternion));
+    Vector3* scales = RL_MALLOC(sampleCount * sizeof(Vector3));
+
+    // Per-bone channel values laid out by frame, reused for every channel
+    float* values = RL_MALLOC(frameCount * 4 * sizeof(float));
+    bool* keep = RL_MALLOC(frameCount * sizeof(bool));
+    int* stack = RL_MALLOC(frameCount * 2 * sizeof(int));
+
+    anim->tracks = RL_CALLOC(boneCount, sizeof(R3D_AnimationTrack));
+
+    // Worst case: every frame kept in every channel, plus one padding word for vector reads
+    size_t maxWords = (size_t)boneCount * frameCount * (4 + 5 + 4) + 1;
+    anim->keyData = RL_MALLOC(maxWords * sizeof(unsigned short));
+
+    bool success = translations && rotations && scales && values && keep && stack && anim->tracks && anim->keyData;
+    if (success) success = r3d_anim_build_bone_order(anim);
+
+    if (!success) {
+        goto cleanup;
+    }
+
+    /* --- Decompose every local transform --- */
+
+    float maxTranslation = 0.0f;
+    size_t shearCount = 0;
+
+    for (size_t i = 0; i < sampleCount; i++) {
+        if (!r3d_anim_decompose(&localPoses[i], &translations[i], &rotations[i], &scales[i])) shearCount++;
+        maxTranslation = fmaxf(maxTranslation, Vector3Length(translations[i]));
+    }
+
+    // Tracks only store translation, rotation and scale, see 'R3D_ModelAnimation'
+    if (shearCount > 0) {
+        TraceLog(LOG_WARNING, "R3D: Animation '%s' has %d sheared bone transforms, their shear is dropped",
+                 anim->name, (int)shearCount);
+    }
+
+    // Translations are compared relative to the size of the skeleton
+    float tolT = tolerance * fmaxf(maxTranslation, 1e-6f);
+    float tolR = tolerance;
+    float tolS = tolerance;
+
+    /* --- Reduce and quantize each channel of each bone --- */
+
+    int offset = 0;
+
+    for (int b = 0; b < boneCount; b++)
+    {
+        R3D_AnimationTrack* track = &anim->tracks[b];
+        int keyCount = 0;
+
+        // Translation
+        for (int f = 0; f < frameCount; f++) {
+            Vector3 v = translations[(size_t)f * boneCount + b];
+            values[f * 3 + 0] = v.x; values[f * 3 + 1] = v.y; values[f * 3 + 2] = v.z;
+        }
+        keyCount = r3d_anim_reduce(keep, values, 3, frameCount, tolT, false, stack);
+        offset = r3d_anim_write_channel(&track->translation, anim->keyData, offset, values, keep, keyCount, frameCount, false);
+
+        // Rotation, kept in the same hemisphere from one frame to the next
+        Quaternion prev = rotations[b];
+        for (int f = 0; f < frameCount; f++) {
+            Quaternion q = rotations[(size_t)f * boneCount + b];
+            if (q.x * prev.x + q.y * prev.y + q.z * prev.z + q.w * prev.w < 0.0f) {
+                q = (Quaternion) { -q.x, -q.y, -q.z, -q.w };
+            }
+            values[f * 4 + 0] = q.x; values[f * 4 + 1] = q.y;
+            values[f * 4 + 2] = q.z; values[f * 4 + 3] = q.w;
+            prev = q;
+        }
+        keyCount = r3d_anim_reduce(keep, values, 4, frameCount, tolR, true, stack);
+        offset = r3d_anim_write_channel(&track->rotation, anim->keyData, offset, values, keep, keyCount, frameCount, true);
+
+        // Scale
+        for (int f = 0; f < frameCount; f++) {
+            Vector3 v = scales[(size_t)f * boneCount + b];
+            values[f * 3 + 0] = v.x; values[f * 3 + 1] = v.y; values[f * 3 + 2] = v.z;
+        }
+        keyCount = r3d_anim_reduce(keep, values, 3, frameCount, tolS, false, stack);
+        offset = r3d_anim_write_channel(&track->scale, anim->keyData, offset, values, keep, keyCount, frameCount, false);
+    }
+
+    /* --- Shrink the key data, keeping one padding word --- */
+
+    anim->keyData[offset] = 0;
+    anim->keyDataSize = offset;
+
+    unsigned short* shrunk = RL_REALLOC(anim->keyData, (offset + 1) * sizeof(unsigned short));
+    if (shrunk != NULL) anim->keyData = shrunk;
+
+cleanup:
+    if (!success) {
+        r3d_anim_release(anim);
+    }
+
+    RL_FREE(translations);
+    RL_FREE(rotations);
+    RL_FREE(scales);
+    RL_FREE(values);
+    RL_FREE(keep);
+    RL_FREE(stack);
+
+    return success;
+}
+
+void r3d_anim_release(R3D_ModelAnimation* anim)
+{
+    RL_FREE(anim->tracks);
+    RL_FREE(anim->keyData);
+    RL_FREE(anim->boneOrder);
+
+    anim->tracks = NULL;
+    anim->keyData = NULL;
+    anim->boneOrder = NULL;
+    anim->keyDataSize = 0;
+}
+
+float r3d_anim_wrap_frame(const R3D_ModelAnimation* anim, float frame)
+{
+    float count = (float)anim->frameCount;
+
+    frame = fmodf(frame, count);
+    if (frame < 0.0f) frame += count;
+
+    return frame;
+}
+
+void r3d_anim_sample_local(const R3D_ModelAnimation* anim, float frame, bool loop, r3d_anim_transform_t* outLocals)
+{
+    float loopEnd = loop ? (float)anim->frameCount : 0.0f;
+    frame = Clamp(frame, 0.0f, loop ? loopEnd : (float)(anim->frameCount - 1));
+
+    for (int bone = 0; bone < anim->boneCount; bone++) {
+        const R3D_AnimationTrack* track = &anim->tracks[bone];
+        r3d_anim_sample_channel(outLocals[bone].translation, &track->translation, anim->keyData, frame, loopEnd, false);
+        r3d_anim_sample_channel(outLocals[bone].rotation, &track->rotation, anim->keyData, frame, loopEnd, true);
+        r3d_anim_sample_channel(outLocals[bone].scale, &track->scale, anim->keyData, frame, loopEnd, false);
+    }
+}
+
+void r3d_anim_compose(const R3D_ModelAnimation* skeleton, const r3d_anim_transform_t* locals, Matrix* outPoses)
+{
+    for (int i = 0; i < skeleton->boneCount; i++)
+    {
+        int bone = skeleton->boneOrder[i];
+        const r3d_anim_transform_t* t = &locals[bone];
+
+        Vector3 translation = { t->translation[0], t->translation[1], t->translation[2] };
+        Quaternion rotation = { t->rotation[0], t->rotation[1], t->rotation[2], t->rotation[3] };
+        Vector3 scale = { t->scale[0], t->scale[1], t->scale[2] };
+
+        Matrix local = r3d_matrix_scale_rotq_translate(&scale, &rotation, &translation);
+
+        // Parents are always composed before their children
+        int parent = skeleton->bones[bone].parent;
+        outPoses[bone] = (parent >= 0) ? r3d_matrix_multiply(&local, &outPoses[parent]) : local;
+    }
+}
+
+void r3d_anim_sample_poses(const R3D_ModelAnimation* anim, float frame, bool loop, Matrix* outPoses)
+{
+    r3d_anim_transform_t stack[R3D_ANIM_STACK_TRANSFORMS];
+    r3d_anim_transform_t* locals = r3d_anim_scratch_alloc(stack, anim->boneCount);
+    if (locals == NULL) return;
+
+    r3d_anim_sample_local(anim, frame, loop, locals);
+    r3d_anim_compose(anim, locals, outPoses);
+
+    r3d_anim_scratch_free(locals, stack);
+}
+
+bool r3d_anim_blend_local(const R3D_AnimationLayer* layers, int layerCount, r3d_anim_transform_t* outLocals)
+{
+    int boneCount = layers[0].anim->boneCount;
+
+    r3d_anim_transform_t stack[R3D_ANIM_STACK_TRANSFORMS];
+    r3d_anim_transform_t* scratch = r3d_anim_scratch_alloc(stack, 2 * boneCount);
+    if (scratch == NULL) return false;
+
+    r3d_anim_blend_layers(layers, layerCount, outLocals, scratch);
+
+    r3d_anim_scratch_free(scratch, stack);
+
+    return true;
+}
+
+void r3d_anim_blend_poses(const R3D_AnimationLayer* layers, int layerCount, Matrix* outPoses)
+{
+    r3d_anim_transform_t stack[R3D_ANIM_STACK_TRANSFORMS];
+    r3d_anim_transform_t* locals = r3d_anim_scratch_alloc(stack, layers[0].anim->boneCount);
+    if (locals == NULL) return;
+
+    if (r3d_anim_blend_local(layers, layerCount, locals)) {
+        r3d_anim_compose(layers[0].anim, locals, outPoses);
+    }
+
+    r3d_anim_scratch_free(locals, stack);
+}
+
+void r3d_anim_sample_poses_reduced(const R3D_ModelAnimation* anim, float frame, bool loop, int level,
+                                   const unsigned char* heights, const Matrix* restLocals, Matrix* outPoses)
+{
+    float loopEnd = loop ? (float)anim->frameCount : 0.0f;
+    frame = Clamp(frame, 0.0f, loop ? loopEnd : (float)(anim->frameCount - 1));
+
+    for (int i = 0; i < anim->boneCount; i++)
+    {
+        int bone = anim->boneOrder[i];
+        int parent = anim->bones[bone].parent;
+
+        Matrix local;
+
+        if (heights[bone] < level) {
+            local = restLocals[bone];
+        }
+        else {
+            const R3D_AnimationTrack* track = &anim->tracks[bone];
+            r3d_anim_transform_t t;
+
+            r3d_anim_sample_channel(t.translation, &track->translation, anim->keyData, frame, loopEnd, false);
+            r3d_anim_sample_channel(t.rotation, &track->rotation, anim->keyData, frame, loopEnd, true);
+            r3d_anim_sample_channel(t.scale, &track->scale, anim->keyData, frame, loopEnd, false);
+
+            Vector3 translation = { t.translation[0], t.translation[1], t.translation[2] };
+            Quaternion rotation = { t.rotation[0], t.rotation[1], t.rotation[2], t.rotation[3] };
+            Vector3 scale = { t.scale[0], t.scale[1], t.scale[2] };
+
+            local = r3d_matrix_scale_rotq_translate(&scale, &rotation, &translation);
+        }
+
+        outPoses[bone] = (parent >= 0) ? r3d_matrix_multiply(&local, &outPoses[parent]) : local;
+    }
+}
+
+R3D_AnimationCache* r3d_anim_cache_create(void)
+{
+    static unsigned int phase = 0;
+
+    R3D_AnimationCache* cache = RL_CALLOC(1, sizeof(R3D_AnimationCache));
+    if (cache == NULL) return NULL;
+
+    // Consecutive caches get spread phases so that models loaded together update on different frames
+    cache->phase = phase;
+    phase += 7;
+
+    return cache;
+}
+
+void r3d_anim_cache_destroy(R3D_AnimationCache* cache)
+{
+    if (cache == NULL) return;
+
+    for (int i = 0; i < cache->entryCount; i++) {
+        RL_FREE(cache->entries[i].poses);
+        RL_FREE(cache->entries[i].restLocals);
+        RL_FREE(cache->entries[i].heights);
+    }
+
+    RL_FREE(cache->entries);
+    RL_FREE(cache);
+}
+
+r3d_anim_cache_entry_t* r3d_anim_cache_acquire(R3D_AnimationCache* cache, unsigned int tick)
+{
+    if (cache->tick != tick) {
+        cache->tick = tick;
+        cache->drawCount = 0;
+    }
+
+    int index = cache->drawCount;
+
+    if (index >= cache->entryCount) {
+        int count = (cache->entryCount > 0) ? 2 * cache->entryCount : 1;
+        r3d_anim_cache_entry_t* entries = RL_REALLOC(cache->entries, count * sizeof(r3d_anim_cache_entry_t));
+        if (entries == NULL) return NULL;
+
+        // Instances of a same model are staggered like the models themselves
+        memset(&entries[cache->entryCount], 0, (count - cache->entryCount) * sizeof(r3d_anim_cache_entry_t));
+        for (int i = cache->entryCount; i < count; i++) {
+            entries[i].phase = cache->phase + 3 * (unsigned int)i;
+        }
+
+        cache->entries = entries;
+        cache->entryCount = count;
+    }
+
+    cache->drawCount++;
+
+    return &cache->entries[index];
+}
+
+bool r3d_anim_cache_evaluate(r3d_anim_cache_entry_t* entry, const R3D_ModelAnimation* anim, float frame,
+                             int interval, int level, unsigned int tick, Matrix* outPoses)
+{
+    int boneCount = anim->boneCount;
+
+    /* --- Bind the entry to the skeleton --- */
+
+    if (entry->anim != anim)
+    {
+        if (boneCount > entry->capacity) {
+            Matrix* poses = RL_REALLOC(entry->poses, 2 * boneCount * sizeof(Matrix));
+            if (poses != NULL) entry->poses = poses;
+            Matrix* restLocals = RL_REALLOC(entry->restLocals, boneCount * sizeof(Matrix));
+            if (restLocals != NULL) entry->restLocals = restLocals;
+            unsigned char* heights = RL_REALLOC(entry->heights, boneCount);
+            if (heights != NULL) entry->heights = heights;
+            if (poses == NULL || restLocals == NULL || heights == NULL) {
+                return false;
+            }
+            entry->capacity = boneCount;
+        }
+
+        r3d_anim_transform_t stack[R3D_ANIM_STACK_TRANSFORMS];
+        r3d_anim_transform_t* locals = r3d_anim_scratch_alloc(stack, boneCount);
+        if (locals == NULL) return false;
+
+        r3d_anim_sample_local(anim, 0.0f, false, locals);
+        for (int bone = 0; bone < boneCount; bone++) {
+            const r3d_anim_transform_t* t = &locals[bone];
+            Vector3 translation = { t->translation[0], t->translation[1], t->translation[2] };
+            Quaternion rotation = { t->rotation[0], t->rotation[1], t->rotation[2], t->rotation[3] };
+            Vector3 scale = { t->scale[0], t->scale[1], t->scale[2] };
+            entry->restLocals[bone] = r3d_matrix_scale_rotq_translate(&scale, &rotation, &translation);
+        }
+
+        r3d_anim_scratch_free(locals, stack);
+
+        // Children always come after their parent, so walking backwards sees every child first
+        memset(entry->heights, 0, boneCount * sizeof(unsigned char));
+        for (int i = boneCount - 1; i >= 0; i--) {
+            int bone = anim->boneOrder[i];
+            int parent = anim->bones[bone].parent;
+            if (parent >= 0 && entry->heights[parent] <= entry->heights[bone] && entry->heights[bone] < 255) {
+                entry->heights[parent] = entry->heights[bone] + 1;
+            }
+        }
+
+        entry->anim = anim;
+        entry->valid = false;
+    }
+
+    /* --- Sample the poses around the frame when needed --- */
+
+    if (interval < 1) interval = 1;
+
+    float step = frame - entry->lastFrame;
+    if (step < 0.0f || step > (float)interval) step = 0.0f;
+    entry->lastFrame = frame;
+
+    Matrix* poses0 = entry->poses;
+    Matrix* poses1 = entry->poses + boneCount;
+
+    // Instances only refresh on the ticks of their phase, unless the frame left the cached range
+    unsigned int slot = (tick + entry->phase) % (unsigned int)interval;
+
+    bool inRange = entry->valid && entry->level == level &&
+                   frame >= entry->frames[0] && frame <= entry->frames[1];
+
+    if (!inRange || slot == 0)
+    {
+        // With a steady playback the frame reaches the next pose right on the refresh tick
+        if (inRange && frame == entry->frames[1]) {
+            memcpy(poses0, poses1, boneCount * sizeof(Matrix));
+        }
+        else {
+            r3d_anim_sample_poses_reduced(anim, r3d_anim_wrap_frame(anim, frame), true, level, entry->heights, entry->restLocals, poses0);
+        }
+
+        // The next pose is sampled where the frame should be on the next refresh tick
+        entry->frames[0] = frame;
+        entry->frames[1] = frame + step * (float)(interval - slot);
+
+        if (entry->frames[1] > entry->frames[0]) {
+            r3d_anim_sample_poses_reduced(anim, r3d_anim_wrap_frame(anim, entry->frames[1]), true, level, entry->heights, entry->restLocals, poses1);
+        }
+        else {
+            memcpy(poses1, poses0, boneCount * sizeof(Matrix));
+        }
+
+        entry->level = level;
+        entry->valid = true;
+    }
+
+    /* --- Interpolate between the cached poses --- */
+
+    float range = entry->frames[1] - entry->frames[0];
+    float t = (range > 0.0f) ? Clamp((frame - entry->frames[0]) / range, 0.0f, 1.0f) : 0.0f;
+
+    const float* a = (const float*)poses0;
+    const float* b = (const float*)poses1;
+    float* out = (float*)outPoses;
+
+    for (int i = 0; i < 16 * boneCount; i++) {
+        out[i] = a[i] + t * (b[i] - a[i]);
+    }
+
+    return true;
+}
+
+BoundingBox r3d_anim_skinned_mesh_aabb(const R3D_Mesh* mesh, const Matrix* skinMatrices, int boneCount)
+{
+    if (mesh->boneBounds == NULL) {
+        return mesh->aabb;
+    }
+
+    BoundingBox aabb = {
+        .min = { +FLT_MAX, +FLT_MAX, +FLT_MAX },
+        .max = { -FLT_MAX, -FLT_MAX, -FLT_MAX }
+    };
+
+    // Skinned vertices are weighted sums of their bone transforms,
+    // so they stay within the union of the moved bone bounds
+    for (int i = 0; i < mesh->boneBoundsCount; i++) {
+        const R3D_BoneBounds* bounds = &mesh->boneBounds[i];
+        if (bounds->bone >= boneCount) {
+            return mesh->aabb;
+        }
+        BoundingBox moved = r3d_matrix_transform_aabb(&skinMatrices[bounds->bone], &bounds->aabb);
+        aabb.min = Vector3Min(aabb.min, moved.min);
+        aabb.max = Vector3Max(aabb.max, moved.max);
+    }
+
+    return (aabb.min.x <= aabb.max.x) ? aabb : mesh->aabb;
+}
+
+size_t r3d_anim_pack_bones(const Matrix* matrices, size_t count, bool half, void* out)
+{
+    // raylib matrices are stored row by row, the last row of an affine transform is dropped
+    if (half) {
+        r3d_half_t* rows = out;
+        for (size_t i = 0; i < count; i++) {
+            const float* m = (const float*)&matrices[i];
+            for (int j = 0; j < 12; j++) {
+                rows[12 * i + j] = r3d_cvt_fh(m[j]);
+            }
+        }
+        return count * R3D_ANIM_BONE_TEXELS * 4 * sizeof(r3d_half_t);
+    }
+
+    float* rows = out;
+    for (size_t i = 0; i < count; i++) {
+        memmove(&rows[12 * i], &matrices[i], 12 * sizeof(float));
+    }
+
+    return count * R3D_ANIM_BONE_TEXELS * 4 * sizeof(float);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_ANIM_H
+#define R3D_DETAILS_ANIM_H
+
+#include "r3d.h"
+
+/* === Defines === */
+
+/*
+ * Number of RGBA texels used by a bone in the skinning buffer textures.
+ * Bones are stored as the three first rows of their affine matrix, see 'r3d_anim_pack_bones'.
+ */
+#define R3D_ANIM_BONE_TEXELS 3
+
+/*
+ * Number of bone transforms the sampling and blending functions keep on the stack,
+ * larger skeletons having their temporary transforms allocated for the call.
+ */
+#define R3D_ANIM_STACK_TRANSFORMS 128
+
+/* === Types === */
+
+/*
+ * Local transform of a bone, each member padded to four lanes for the blending kernels.
+ * The fourth lane of the translation and the scale is unused.
+ */
+typedef struct {
+    float translation[4];
+    float rotation[4];
+    float scale[4];
+} r3d_anim_transform_t;
+
+/*
+ * Poses of one drawn instance of a model kept between frames by the animation level of detail.
+ * Two poses are evaluated ahead of time and interpolated while the frame stays between them.
+ */
+typedef struct {
+    const R3D_ModelAnimation* anim; //< Skeleton the cached data belongs to
+    Matrix* poses;                  //< Model space poses at 'frames[0]' then at 'frames[1]', one matrix per bone each
+    Matrix* restLocals;             //< Local transforms at frame 0, used for the bones dropped by reduced skeletons
+    unsigned char* heights;         //< Height of each bone in the hierarchy, 0 for leaf bones
+    int capacity;                   //< Number of bones the buffers can hold
+    float frames[2];                //< Frames of the two cached poses
+    float lastFrame;                //< Frame requested by the previous evaluation
+    int level;                      //< Skeleton reduction of the cached poses
+    unsigned int phase;             //< Offset spreading the updates of the instances over the frames
+    bool valid;
+} r3d_anim_cache_entry_t;
+
+/*
+ * Cached poses of a model, one entry per draw of the model within a frame.
+ * Entries are matched to the draws by their order, the n-th draw of a frame
+ * always using the n-th entry, so each instance keeps its own state.
+ */
+struct R3D_AnimationCache {
+    r3d_anim_cache_entry_t* entries;
+    int entryCount;
+    int drawCount;                  //< Entries acquired during the current tick
+    unsigned int tick;              //< Tick of the last acquired entry
+    unsigned int phase;             //< Phase of the first entry, the next ones being spread from it
+};
+
+/* === Functions === */
+
+/*
+ * Builds the compressed tracks of an animation from its sampled bone transforms.
+ * 'localPoses' holds 'frameCount * boneCount' matrices, indexed by [frame * boneCount + bone],
+ * each one relative to the parent bone given by 'anim->bones[bone].parent'.
+ * The bone hierarchy and the frame count of the animation must already be set.
+ */
+bool r3d_anim_compress(R3D_ModelAnimation* anim, const Matrix* localPoses, float tolerance);
+
+/*
+ * Releases the compressed tracks of an animation.
+ */
+void r3d_anim_release(R3D_ModelAnimation* anim);
+
+/*
+ * Wraps a frame around the frame count of the animation.
+ */
+float r3d_anim_wrap_frame(const R3D_ModelAnimation* anim, float frame);
+
+/*
+ * Decompresses the local transform of every bone at the given fractional frame (clamped to the animation).
+ * Looping clips interpolate from their last frame back to their first one, up to 'frameCount'.
+ */
+void r3d_anim_sample_local(const R3D_ModelAnimation* anim, float frame, bool loop, r3d_anim_transform_t* outLocals);
+
+/*
+ * Cross-fades the regular layers by weight then applies the additive ones, relative to their first frame.
+ * The first layer defines the skeleton, layers with another bone count are skipped. Layers loop.
+ * 'outLocals' receives one transform per bone of the first layer. Returns false on allocation failure.
+ */
+bool r3d_anim_blend_local(const R3D_AnimationLayer* layers, int layerCount, r3d_anim_transform_t* outLocals);
+
+/*
+ * Combines local transforms along the hierarchy of the skeleton, writing the model space pose of each bone.
+ */
+void r3d_anim_compose(const R3D_ModelAnimation* skeleton, const r3d_anim_transform_t* locals, Matrix* outPoses);
+
+/*
+ * Samples then composes the pose of every bone at the given frame, see 'r3d_anim_sample_local'.
+ */
+void r3d_anim_sample_poses(const R3D_ModelAnimation* anim, float frame, bool loop, Matrix* outPoses);
+
+/*
+ * Blends then composes the pose of every bone, see 'r3d_anim_blend_local'.
+ */
+void r3d_anim_blend_poses(const R3D_AnimationLayer* layers, int layerCount, Matrix* outPoses);
+
+/*
+ * Samples then composes the pose of every bone, the bones whose height is below 'level'
+ * keeping their local transform at frame 0 ('restLocals', see 'r3d_anim_cache_evaluate').
+ */
+void r3d_anim_sample_poses_reduced(const R3D_ModelAnimation* anim, float frame, bool loop, int level,
+                                   const unsigned char* heights, const Matrix* restLocals, Matrix* outPoses);
+
+/*
+ * Creates an empty animation cache, or destroys one (NULL is ignored).
+ */
+R3D_AnimationCache* r3d_anim_cache_create(void);
+void r3d_anim_cache_destroy(R3D_AnimationCache* cache);
+
+/*
+ * Returns the entry of the next draw of the model during 'tick', to be called for every draw
+ * of the model so that the entries keep following the same instances.
+ * Returns NULL on allocation failure.
+ */
+r3d_anim_cache_entry_t* r3d_anim_cache_acquire(R3D_AnimationCache* cache, unsigned int tick);
+
+/*
+ * Evaluates the pose of an animation at a frame through a cache entry.
+ * With an interval above one, the pose is only sampled every 'interval' frames of the animation,
+ * on the ticks matching the phase of the entry, and interpolated in between.
+ * The bones whose height is below 'level' are frozen in their pose at frame 0, the local
+ * transforms at frame 0 and the bone heights being computed when the entry changes of animation.
+ * Returns false if the entry could not be used, in which case nothing is written.
+ */
+bool r3d_anim_cache_evaluate(r3d_anim_cache_entry_t* entry, const R3D_ModelAnimation* anim, float frame,
+                             int interval, int level, unsigned int tick, Matrix* outPoses);
+
+/*
+ * Bounds of a skinned mesh posed by 'skinMatrices', from the bounds of the vertices influenced by each bone.
+ * Returns the bind pose bounds of the mesh if it has no bone bounds or if they reference bones past 'boneCount'.
+ */
+BoundingBox r3d_anim_skinned_mesh_aabb(const R3D_Mesh* mesh, const Matrix* skinMatrices, int boneCount);
+
+/*
+ * Writes the three first rows of each matrix to 'out', as floats or as half floats.
+ * 'out' must hold 'count * 12' values, returns the number of bytes written.
+ * Full precision rows can be packed in place, 'out' being the matrices themselves.
+ */
+size_t r3d_anim_pack_bones(const Matrix* matrices, size_t count, bool half, void* out);
+
+#endif // R3D_DETAILS_ANIM_H
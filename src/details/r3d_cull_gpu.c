@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_cull_gpu.h"
+
+#include "../r3d_state.h"
+
+#include <raylib.h>
+#include <raymath.h>
+#include <glad.h>
+
+#include <stdint.h>
+#include <string.h>
+
+/* === Internal data === */
+
+// The input buffer is filled once per frame and read by the culling of every pass,
+// the output and indirect buffers are orphaned on each culling so a draw still
+// reading the previous instances never stalls the next one
+static GLuint r3d_cull_gpu_input = 0;
+static GLuint r3d_cull_gpu_output = 0;
+static GLuint r3d_cull_gpu_indirect = 0;
+
+static size_t r3d_cull_gpu_input_capacity = 0;
+static unsigned char* r3d_cull_gpu_mapped = NULL;
+
+// Required alignment of the offsets bound to the storage buffers, queried on first use
+static size_t r3d_cull_gpu_alignment = 0;
+
+/* === Internal functions === */
+
+// Layout of the instances, in 32-bit words as read by the shader, returns the number of words
+static size_t r3d_cull_gpu_layout(const r3d_cull_gpu_input_t* input, size_t* colorOffset, size_t* paramsOffset)
+{
+    size_t count = input->count;
+
+    *colorOffset = (input->colors != NULL) ? 16 * count : 0;
+    *paramsOffset = (input->params != NULL) ? 16 * count + (input->colors != NULL ? count : 0) : 0;
+
+    size_t words = 16 * count;
+    if (input->colors != NULL) words += count;
+    if (input->params != NULL) words += 8 * count;
+
+    return words;
+}
+
+// Copies 'count' elements of 'size' bytes separated by 'stride' bytes ('0' meaning tightly packed)
+static unsigned char* r3d_cull_gpu_gather(unsigned char* dst, const void* src, size_t stride, size_t size, size_t count)
+{
+    if (stride == 0 || stride == size) {
+        memcpy(dst, src, count * size);
+        return dst + count * size;
+    }
+
+    const unsigned char* bytes = src;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(dst, bytes + i * stride, size);
+        dst += size;
+    }
+
+    return dst;
+}
+
+/* === Public functions === */
+
+bool r3d_cull_gpu_is_available(void)
+{
+    return R3D.shader.raster.cull.id != 0;
+}
+
+size_t r3d_cull_gpu_input_size(const r3d_cull_gpu_input_t* input)
+{
+    if (r3d_cull_gpu_alignment == 0) {
+        GLint alignment = 0;
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        r3d_cull_gpu_alignment = (alignment > 0) ? (size_t)alignment : 256;
+    }
+
+    size_t colorOffset, paramsOffset;
+    size_t size = r3d_cull_gpu_layout(input, &colorOffset, &paramsOffset) * sizeof(uint32_t);
+
+    // Rounded up so the next input starts on an offset that can be bound
+    return (size + r3d_cull_gpu_alignment - 1) / r3d_cull_gpu_alignment * r3d_cull_gpu_alignment;
+}
+
+bool r3d_cull_gpu_begin_upload(size_t size)
+{
+    if (!r3d_cull_gpu_is_available() || size == 0) {
+        return false;
+    }
+
+    if (r3d_cull_gpu_input == 0) {
+        glGenBuffers(1, &r3d_cull_gpu_input);
+        glGenBuffers(1, &r3d_cull_gpu_output);
+        glGenBuffers(1, &r3d_cull_gpu_indirect);
+    }
+
+    if (size > r3d_cull_gpu_input_capacity) {
+        size_t capacity = (r3d_cull_gpu_input_capacity > 0) ? r3d_cull_gpu_input_capacity : 65536;
+        while (capacity < size) capacity *= 2;
+        r3d_cull_gpu_input_capacity = capacity;
+    }
+
+    // Orphan the storage so we don't wait for the previous frame to be done with it
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, r3d_cull_gpu_input);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, r3d_cull_gpu_input_capacity, NULL, GL_STREAM_DRAW);
+
+    r3d_cull_gpu_mapped = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    return (r3d_cull_gpu_mapped != NULL);
+}
+
+void r3d_cull_gpu_upload(const r3d_cull_gpu_input_t* input, size_t offset)
+{
+    unsigned char* dst = r3d_cull_gpu_mapped + offset;
+
+    dst = r3d_cull_gpu_gather(dst, input->transforms, input->transStride, sizeof(Matrix), input->count);
+    if (input->colors != NULL) {
+        dst = r3d_cull_gpu_gather(dst, input->colors, input->colStride, sizeof(Color), input->count);
+    }
+    if (input->params != NULL) {
+        r3d_cull_gpu_gather(dst, input->params, 0, sizeof(R3D_InstanceParams), input->count);
+    }
+}
+
+bool r3d_cull_gpu_end_upload(void)
+{
+    r3d_cull_gpu_mapped = NULL;
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, r3d_cull_gpu_input);
+    GLboolean intact = glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // The content is undefined if the storage was lost while mapped
+    return (intact == GL_TRUE);
+}
+
+void r3d_cull_gpu_run(r3d_cull_gpu_output_t* output, const r3d_cull_gpu_input_t* input, size_t offset, const Matrix* matModel, const Matrix* matVP)
+{
+    size_t colorOffset, paramsOffset;
+    size_t size = r3d_cull_gpu_layout(input, &colorOffset, &paramsOffset) * sizeof(uint32_t);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, r3d_cull_gpu_output);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, size, NULL, GL_STREAM_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Same first two members for 'glDrawElementsIndirect' and 'glDrawArraysIndirect',
+    // the instance count being incremented by the shader for each visible instance
+    GLuint command[5] = { (GLuint)input->elementCount, 0, 0, 0, 0 };
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, r3d_cull_gpu_indirect);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, input->indexed ? 5 * sizeof(GLuint) : 4 * sizeof(GLuint), command, GL_STREAM_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    /* --- Cull the instances --- */
+
+    // The culling happens in the middle of a draw call, whose shader must be restored
+    GLint program = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, r3d_cull_gpu_input, (GLintptr)offset, (GLsizeiptr)size);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, r3d_cull_gpu_output);
+    glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 0, r3d_cull_gpu_indirect);
+
+    r3d_shader_enable(raster.cull);
+
+    r3d_shader_set_mat4(raster.cull, uMatModel, *matModel);
+    r3d_shader_set_mat4(raster.cull, uMatVP, *matVP);
+    r3d_shader_set_vec3(raster.cull, uAabbMin, input->aabb.min);
+    r3d_shader_set_vec3(raster.cull, uAabbMax, input->aabb.max);
+    r3d_shader_set_int(raster.cull, uBillboard, input->billboard);
+    r3d_shader_set_int(raster.cull, uInstanceCount, (int)input->count);
+    r3d_shader_set_int(raster.cull, uColorOffset, (int)colorOffset);
+    r3d_shader_set_int(raster.cull, uParamsOffset, (int)paramsOffset);
+
+    glDispatchCompute((GLuint)((input->count + 63) / 64), 1, 1);
+
+    glUseProgram((GLuint)program);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+    glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 0, 0);
+
+    // The draw reads the written instances as attributes and the instance count as a command
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+    output->buffer = r3d_cull_gpu_output;
+    output->indirect = r3d_cull_gpu_indirect;
+    output->colorOffset = colorOffset * sizeof(uint32_t);
+    output->paramsOffset = paramsOffset * sizeof(uint32_t);
+}
+
+void r3d_cull_gpu_unload(void)
+{
+    if (r3d_cull_gpu_input != 0) {
+        glDeleteBuffers(1, &r3d_cull_gpu_input);
+        glDeleteBuffers(1, &r3d_cull_gpu_output);
+        glDeleteBuffers(1, &r3d_cull_gpu_indirect);
+    }
+
+    r3d_cull_gpu_input = 0;
+    r3d_cull_gpu_output = 0;
+    r3d_cull_gpu_indirect = 0;
+    r3d_cull_gpu_input_capacity = 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_CULL_GPU_H
+#define R3D_DETAILS_CULL_GPU_H
+
+#include "r3d.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* === Defines === */
+
+/*
+ * Below this number of instances a draw call is not culled on the GPU,
+ * the dispatch and the indirect draw costing more than the instances they would discard.
+ */
+#define R3D_CULL_GPU_MIN_INSTANCES 256
+
+/* === Types === */
+
+/*
+ * Instances of a draw call to cull, read with the same strides as the instance buffers
+ * ('0' meaning tightly packed). Only the transforms are required.
+ */
+typedef struct {
+    const Matrix* transforms;
+    size_t transStride;
+    const Color* colors;                //< Can be NULL
+    size_t colStride;
+    const R3D_InstanceParams* params;   //< Can be NULL
+    size_t count;
+    BoundingBox aabb;                   //< Bounds of the geometry in the local space of an instance
+    bool billboard;                     //< Bounds tested as a sphere around the origin, whatever the rotation
+    bool indexed;                       //< Arguments of 'glDrawElementsIndirect' rather than 'glDrawArraysIndirect'
+    int elementCount;                   //< Number of indices, or vertices if not indexed, drawn per instance
+} r3d_cull_gpu_input_t;
+
+/*
+ * Visible instances compacted on the GPU, valid until the next culling.
+ * Each stream is tightly packed in 'buffer' from its offset, in the order of the visible instances.
+ */
+typedef struct {
+    unsigned int buffer;        //< Transforms, colors then parameters of the visible instances
+    unsigned int indirect;      //< Arguments of the indirect draw, the instance count being written by the GPU
+    size_t colorOffset;         //< Offset of the colors in 'buffer' (0 = no colors)
+    size_t paramsOffset;        //< Offset of the parameters in 'buffer' (0 = no parameters)
+} r3d_cull_gpu_output_t;
+
+/* === Functions === */
+
+/*
+ * Returns true if the culling shader could be loaded, which requires OpenGL 4.3.
+ */
+bool r3d_cull_gpu_is_available(void);
+
+/*
+ * Uploads the instances of the frame once, every pass then culls them from the same buffer.
+ * 'begin' makes room for 'size' bytes, the sum of 'r3d_cull_gpu_input_size' for every input,
+ * then each input is copied at its own offset within that range until 'end' is called.
+ * 'end' returns false if the uploaded instances were lost, none can then be culled this frame.
+ */
+size_t r3d_cull_gpu_input_size(const r3d_cull_gpu_input_t* input);
+bool r3d_cull_gpu_begin_upload(size_t size);
+void r3d_cull_gpu_upload(const r3d_cull_gpu_input_t* input, size_t offset);
+bool r3d_cull_gpu_end_upload(void);
+
+/*
+ * Tests the bounds of every instance uploaded at 'offset' against the frustum of 'matVP',
+ * the instances being transformed by 'matModel' first, and writes the visible ones and the
+ * arguments of their draw. No instance count is read back, the draw must be issued with the indirect buffer.
+ * The visible instances are compacted in no particular order, only opaque instances should be culled.
+ */
+void r3d_cull_gpu_run(r3d_cull_gpu_output_t* output, const r3d_cull_gpu_input_t* input, size_t offset, const Matrix* matModel, const Matrix* matVP);
+
+/*
+ * Releases the buffers used for culling.
+ */
+void r3d_cull_gpu_unload(void);
+
+#endif // R3D_DETAILS_CULL_GPU_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_CURVE_H
+#define R3D_DETAILS_CURVE_H
+
+#include "r3d.h"
+
+#include <string.h>
+
+/* === Defines === */
+
+/*
+ * The lookup table of a curve is followed in the same allocation by the keyframe array and count it was baked from.
+ * Curves are passed by value and share their table with their copies, so a copy that gained keyframes or whose array
+ * was reallocated since the bake no longer matches the stamp and ignores the table.
+ */
+#define R3D_CURVE_LUT_SIZE  ((R3D_CURVE_LUT_RESOLUTION + 1) * sizeof(float))
+#define R3D_CURVE_LUT_ALLOC (R3D_CURVE_LUT_SIZE + sizeof(r3d_curve_lut_stamp_t))
+
+/* === Types === */
+
+typedef struct {
+    const R3D_Keyframe* keyframes;
+    unsigned int count;
+} r3d_curve_lut_stamp_t;
+
+/* === Functions === */
+
+/*
+ * Records the keyframes of the curve as the source of its lookup table, or reads them back.
+ * The stamp is not aligned after the table, it is always copied.
+ */
+static inline void r3d_curve_stamp_lut(const R3D_InterpolationCurve* curve)
+{
+    r3d_curve_lut_stamp_t stamp = { curve->keyframes, curve->count };
+    memcpy((char*)curve->lut + R3D_CURVE_LUT_SIZE, &stamp, sizeof(stamp));
+}
+
+/*
+ * Returns the lookup table of the curve if it was baked from its current keyframes, NULL otherwise.
+ * Values modified in place can't be detected, these still require 'R3D_BakeCurve'.
+ */
+static inline const float* r3d_curve_get_lut(const R3D_InterpolationCurve* curve)
+{
+    if (curve->lut == NULL) {
+        return NULL;
+    }
+
+    r3d_curve_lut_stamp_t stamp;
+    memcpy(&stamp, (const char*)curve->lut + R3D_CURVE_LUT_SIZE, sizeof(stamp));
+
+    if (stamp.keyframes != curve->keyframes || stamp.count != curve->count) {
+        return NULL;
+    }
+
+    return curve->lut;
+}
+
+/*
+ * Reads the lookup table of a baked curve at a time clamped to [0, 1],
+ * interpolating linearly between the two surrounding samples.
+ * The vectorized kernels sampling the tables must follow the same operations.
+ */
+static inline float r3d_curve_sample_lut(const float* lut, float time)
+{
+    float x = (time > 0.0f) ? time : 0.0f;
+    x = (x < 1.0f) ? x : 1.0f;
+    x *= R3D_CURVE_LUT_RESOLUTION;
+
+    int i = (int)x;
+    if (i > R3D_CURVE_LUT_RESOLUTION - 1) i = R3D_CURVE_LUT_RESOLUTION - 1;
+
+    float f = x - (float)i;
+    return lut[i] + f * (lut[i + 1] - lut[i]);
+}
+
+/*
+ * Gives the range of the values of a curve, which are interpolated linearly between the keyframes.
+ * A curve without keyframes evaluates to zero.
+ */
+static inline void r3d_curve_range(const R3D_InterpolationCurve* curve, float* outMin, float* outMax)
+{
+    float lo = (curve->count > 0) ? curve->keyframes[0].value : 0.0f;
+    float hi = lo;
+
+    for (unsigned int i = 1; i < curve->count; i++) {
+        float value = curve->keyframes[i].value;
+        if (value < lo) lo = value;
+        if (value > hi) hi = value;
+    }
+
+    *outMin = lo;
+    *outMax = hi;
+}
+
+#endif // R3D_DETAILS_CURVE_H
@@ -20,6 +20,9 @@
 #include "./r3d_drawcall.h"
 
 #include "./r3d_primitives.h"
+#include "./r3d_instance.h"
+#include "./r3d_sort.h"
+#include "./r3d_cull_gpu.h"
 #include "./r3d_frustum.h"
 #include "../r3d_state.h"
 #include "./r3d_math.h"
@@ -30,6 +33,7 @@
 #include <glad.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <float.h>
 
@@ -40,9 +44,18 @@ static void r3d_drawcall_apply_cull_mode(R3D_CullMode mode);
 static void r3d_drawcall_apply_blend_mode(R3D_BlendMode mode);
 static void r3d_drawcall_apply_shadow_cast_mode(R3D_ShadowCastMode mode);
 
+// Face currently culled by OpenGL (GL_NONE, GL_BACK or GL_FRONT), used for meshlet cone culling
+static GLenum r3d_drawcall_culled_face = GL_BACK;
+
 // This function supports instanced rendering when necessary
-static void r3d_drawcall(const r3d_drawcall_t* call);
-static void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor);
+static void r3d_drawcall(const r3d_drawcall_t* call, const Matrix* matMVP, bool shadow);
+static void r3d_drawcall_instanced(const r3d_drawcall_t* call, const uint32_t* order, int locInstanceModel, int locInstanceColor, int locInstanceAnim, int locInstanceParams);
+
+// Draws the visible instances only after culling them on the GPU, returns false if the draw call cannot be culled this way
+static bool r3d_drawcall_instanced_gpu_culled(const r3d_drawcall_t* call, const uint32_t* order, int locInstanceModel, int locInstanceColor, int locInstanceParams);
+
+// Uploads per-instance data, gathered in 'order' when not NULL so the source array is never reordered
+static unsigned int r3d_drawcall_load_instance_buffer(const void* data, size_t stride, size_t size, size_t count, const uint32_t* order);
 
 // Comparison functions for sorting draw calls in the arrays
 static int r3d_drawcall_compare_front_to_back(const void* a, const void* b);
@@ -71,15 +84,22 @@ bool r3d_drawcall_geometry_is_visible(const r3d_drawcall_t* call)
 {
     if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
         if (r3d_matrix_is_identity(&call->transform)) {
-            return r3d_frustum_is_aabb_in(&R3D.state.frustum.shape, &call->geometry.model.mesh->aabb);
+            return r3d_frustum_is_aabb_in(&R3D.state.frustum.shape, &call->geometry.model.aabb);
         }
-        return r3d_frustum_is_obb_in(&R3D.state.frustum.shape, &call->geometry.model.mesh->aabb, &call->transform);
+        return r3d_frustum_is_obb_in(&R3D.state.frustum.shape, &call->geometry.model.aabb, &call->transform);
     }
 
     if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
         return r3d_frustum_is_points_in(&R3D.state.frustum.shape, call->geometry.sprite.quad, 4);
     }
 
+    if (call->geometryType == R3D_DRAWCALL_GEOMETRY_IMPOSTOR) {
+        const R3D_Impostor* impostor = call->geometry.impostor.impostor;
+        Vector3 center = Vector3Transform(impostor->center, call->transform);
+        float radius = impostor->radius * r3d_matrix_max_scale(&call->transform);
+        return r3d_frustum_is_sphere_in(&R3D.state.frustum.shape, &center, radius);
+    }
+
     return false;
 }
 
@@ -96,20 +116,6 @@ bool r3d_drawcall_instanced_geometry_is_visible(const r3d_drawcall_t* call)
     return r3d_frustum_is_obb_in(&R3D.state.frustum.shape, &call->instanced.allAabb, &call->transform);
 }
 
-void r3d_drawcall_update_model_animation(const r3d_drawcall_t* call)
-{
-    int frame = call->geometry.model.frame;
-    if (frame >= call->geometry.model.anim->frameCount) {
-        frame = frame % call->geometry.model.anim->frameCount;
-    }
-
-    for (int boneId = 0; boneId < call->geometry.model.anim->boneCount; boneId++) {
-        const Matrix* offsetMatrix = &call->geometry.model.boneOffsets[boneId];
-        const Matrix* targetMatrix = &call->geometry.model.anim->framePoses[frame][boneId];
-        call->geometry.model.mesh->boneMatrices[boneId] = r3d_matrix_multiply(offsetMatrix, targetMatrix);
-    }
-}
-
 void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool shadow)
 {
     if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL) {
@@ -134,8 +140,9 @@ void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool shadow)
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.depth, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.depth, uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.depth, uBoneOffset, call->geometry.model.boneOffset);
                 r3d_shader_set_int(raster.depth, uUseSkinning, true);
             }
             else {
@@ -149,6 +156,9 @@ void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool shadow)
             r3d_shader_set_int(raster.depth, uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
     // Send alpha and bind albedo
@@ -164,7 +174,7 @@ void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool shadow)
     }
 
     // Rendering the object corresponding to the draw call
-    r3d_drawcall(call);
+    r3d_drawcall(call, &matMVP, shadow);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -196,6 +206,9 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool shadow)
     r3d_shader_set_mat4(raster.depthInst, uMatModel, matModel);
     r3d_shader_set_mat4(raster.depthInst, uMatVP, matVP);
 
+    // Send the format of the instances
+    r3d_shader_set_int(raster.depthInst, uPackedInstances, call->instanced.packed != NULL);
+
     // Send billboard related data
     r3d_shader_set_int(raster.depthInst, uBillboardMode, call->material.billboardMode);
     if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
@@ -207,11 +220,27 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool shadow)
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.depthInst, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+            if (call->instanced.vertexAnim != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.depthInst, uTexVertexAnim, call->instanced.vertexAnim->texture);
+                r3d_shader_set_int(raster.depthInst, uVertexAnimBase, call->instanced.vertexAnimBase);
+                r3d_shader_set_int(raster.depthInst, uUseVertexAnimation, true);
+                r3d_shader_set_int(raster.depthInst, uUseSkinning, false);
+            }
+            else if (call->instanced.animTexture != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.depthInst, uTexBoneMatrices, call->instanced.animTexture->texture);
+                r3d_shader_set_int(raster.depthInst, uUseInstanceAnimation, true);
+                r3d_shader_set_int(raster.depthInst, uUseVertexAnimation, false);
+                r3d_shader_set_int(raster.depthInst, uUseSkinning, true);
+            }
+            else if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.depthInst, uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.depthInst, uBoneOffset, call->geometry.model.boneOffset);
+                r3d_shader_set_int(raster.depthInst, uUseInstanceAnimation, false);
+                r3d_shader_set_int(raster.depthInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.depthInst, uUseSkinning, true);
             }
             else {
+                r3d_shader_set_int(raster.depthInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.depthInst, uUseSkinning, false);
             }
         }
@@ -219,11 +248,21 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool shadow)
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
         {
             // Send bone matrices and animation related data
+            r3d_shader_set_int(raster.depthInst, uUseVertexAnimation, false);
             r3d_shader_set_int(raster.depthInst, uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
+    // Set texcoord offset/scale, the sprite frames of the instances being mapped within it
+    r3d_shader_set_vec2(raster.depthInst, uTexCoordOffset, call->material.uvOffset);
+    r3d_shader_set_vec2(raster.depthInst, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.depthInst, uSpriteFrameCount, (call->instanced.params != NULL)
+        ? (Vector2) { (float)call->instanced.xFrameCount, (float)call->instanced.yFrameCount } : (Vector2) { 0 });
+
     // Send alpha and bind albedo
     r3d_shader_set_float(raster.depthInst, uAlpha, ((float)call->material.albedo.color.a / 255));
     r3d_shader_bind_sampler2D_opt(raster.depthInst, uTexAlbedo, call->material.albedo.texture.id, white);
@@ -237,7 +276,7 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool shadow)
     }
 
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, -1);
+    r3d_drawcall_instanced(call, NULL, 10, -1, 15, 8);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -275,8 +314,9 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool shadow)
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.depthCube, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.depthCube, uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.depthCube, uBoneOffset, call->geometry.model.boneOffset);
                 r3d_shader_set_int(raster.depthCube, uUseSkinning, true);
             }
             else {
@@ -290,6 +330,9 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool shadow)
             r3d_shader_set_int(raster.depthCube, uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
     // Send alpha and bind albedo
@@ -297,8 +340,9 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool shadow)
     r3d_shader_bind_sampler2D_opt(raster.depthCube, uTexAlbedo, call->material.albedo.texture.id, white);
 
     // Send bone matrices if necessary
-    if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-        r3d_shader_set_mat4_v(raster.depthCube, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+    if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+        r3d_shader_bind_samplerBuffer(raster.depthCube, uTexBoneMatrices, R3D.skinning.paletteTexture);
+        r3d_shader_set_int(raster.depthCube, uBoneOffset, call->geometry.model.boneOffset);
         r3d_shader_set_int(raster.depthCube, uUseSkinning, true);
     }
     else {
@@ -314,7 +358,7 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool shadow)
     }
 
     // Rendering the object corresponding to the draw call
-    r3d_drawcall(call);
+    r3d_drawcall(call, &matMVP, shadow);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -346,6 +390,9 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool shadow
     r3d_shader_set_mat4(raster.depthCubeInst, uMatModel, matModel);
     r3d_shader_set_mat4(raster.depthCubeInst, uMatVP, matVP);
 
+    // Send the format of the instances
+    r3d_shader_set_int(raster.depthCubeInst, uPackedInstances, call->instanced.packed != NULL);
+
     // Send billboard related data
     r3d_shader_set_int(raster.depthCubeInst, uBillboardMode, call->material.billboardMode);
     if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
@@ -357,11 +404,27 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool shadow
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.depthCubeInst, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+            if (call->instanced.vertexAnim != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.depthCubeInst, uTexVertexAnim, call->instanced.vertexAnim->texture);
+                r3d_shader_set_int(raster.depthCubeInst, uVertexAnimBase, call->instanced.vertexAnimBase);
+                r3d_shader_set_int(raster.depthCubeInst, uUseVertexAnimation, true);
+                r3d_shader_set_int(raster.depthCubeInst, uUseSkinning, false);
+            }
+            else if (call->instanced.animTexture != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.depthCubeInst, uTexBoneMatrices, call->instanced.animTexture->texture);
+                r3d_shader_set_int(raster.depthCubeInst, uUseInstanceAnimation, true);
+                r3d_shader_set_int(raster.depthCubeInst, uUseVertexAnimation, false);
+                r3d_shader_set_int(raster.depthCubeInst, uUseSkinning, true);
+            }
+            else if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.depthCubeInst, uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.depthCubeInst, uBoneOffset, call->geometry.model.boneOffset);
+                r3d_shader_set_int(raster.depthCubeInst, uUseInstanceAnimation, false);
+                r3d_shader_set_int(raster.depthCubeInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.depthCubeInst, uUseSkinning, true);
             }
             else {
+                r3d_shader_set_int(raster.depthCubeInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.depthCubeInst, uUseSkinning, false);
             }
         }
@@ -369,11 +432,21 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool shadow
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
         {
             // Send bone matrices and animation related data
+            r3d_shader_set_int(raster.depthCubeInst, uUseVertexAnimation, false);
             r3d_shader_set_int(raster.depthCubeInst, uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
+    // Set texcoord offset/scale, the sprite frames of the instances being mapped within it
+    r3d_shader_set_vec2(raster.depthCubeInst, uTexCoordOffset, call->material.uvOffset);
+    r3d_shader_set_vec2(raster.depthCubeInst, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.depthCubeInst, uSpriteFrameCount, (call->instanced.params != NULL)
+        ? (Vector2) { (float)call->instanced.xFrameCount, (float)call->instanced.yFrameCount } : (Vector2) { 0 });
+
     // Send alpha and bind albedo
     r3d_shader_set_float(raster.depthCubeInst, uAlpha, ((float)call->material.albedo.color.a / 255));
     r3d_shader_bind_sampler2D_opt(raster.depthCubeInst, uTexAlbedo, call->material.albedo.texture.id, white);
@@ -387,7 +460,7 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool shadow
     }
 
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, -1);
+    r3d_drawcall_instanced(call, NULL, 10, -1, 15, 8);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -398,7 +471,7 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool shadow
     r3d_shader_unbind_sampler2D(raster.depthCubeInst, uTexAlbedo);
 }
 
-void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call)
+void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call, r3d_shader_geometry_variant_t variant)
 {
     Matrix matModel, matNormal, matMVP, temp;
 
@@ -416,69 +489,78 @@ void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call)
     matMVP = r3d_matrix_multiply(&matMVP, &temp);
 
     // Set additional matrix uniforms
-    r3d_shader_set_mat4(raster.geometry, uMatNormal, matNormal);
-    r3d_shader_set_mat4(raster.geometry, uMatModel, matModel);
-    r3d_shader_set_mat4(raster.geometry, uMatMVP, matMVP);
+    r3d_shader_set_mat4(raster.geometry[variant], uMatNormal, matNormal);
+    r3d_shader_set_mat4(raster.geometry[variant], uMatModel, matModel);
+    r3d_shader_set_mat4(raster.geometry[variant], uMatMVP, matMVP);
 
     // Set factor material maps
-    r3d_shader_set_float(raster.geometry, uEmissionEnergy, call->material.emission.energy);
-    r3d_shader_set_float(raster.geometry, uNormalScale, call->material.normal.scale);
-    r3d_shader_set_float(raster.geometry, uOcclusion, call->material.orm.occlusion);
-    r3d_shader_set_float(raster.geometry, uRoughness, call->material.orm.roughness);
-    r3d_shader_set_float(raster.geometry, uMetalness, call->material.orm.metalness);
+    r3d_shader_set_float(raster.geometry[variant], uEmissionEnergy, call->material.emission.energy);
+    r3d_shader_set_float(raster.geometry[variant], uNormalScale, call->material.normal.scale);
+    r3d_shader_set_float(raster.geometry[variant], uOcclusion, call->material.orm.occlusion);
+    r3d_shader_set_float(raster.geometry[variant], uRoughness, call->material.orm.roughness);
+    r3d_shader_set_float(raster.geometry[variant], uMetalness, call->material.orm.metalness);
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.geometry, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.geometry, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.geometry[variant], uTexCoordOffset, call->material.uvOffset);
+    r3d_shader_set_vec2(raster.geometry[variant], uTexCoordScale, call->material.uvScale);
 
     // Set color material maps
-    r3d_shader_set_col3(raster.geometry, uAlbedoColor, call->material.albedo.color);
-    r3d_shader_set_col3(raster.geometry, uEmissionColor, call->material.emission.color);
+    r3d_shader_set_col3(raster.geometry[variant], uAlbedoColor, call->material.albedo.color);
+    r3d_shader_set_col3(raster.geometry[variant], uEmissionColor, call->material.emission.color);
+
+    // Set dithered cross-fade
+    if (variant == R3D_SHADER_GEOMETRY_DITHER) {
+        r3d_shader_set_float(raster.geometry[variant], uDitherFade, call->ditherFade);
+    }
 
     // Bind active texture maps
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexAlbedo, call->material.albedo.texture.id, white);
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexNormal, call->material.normal.texture.id, normal);
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexEmission, call->material.emission.texture.id, black);
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexORM, call->material.orm.texture.id, white);
+    r3d_shader_bind_sampler2D_opt(raster.geometry[variant], uTexAlbedo, call->material.albedo.texture.id, white);
+    r3d_shader_bind_sampler2D_opt(raster.geometry[variant], uTexNormal, call->material.normal.texture.id, normal);
+    r3d_shader_bind_sampler2D_opt(raster.geometry[variant], uTexEmission, call->material.emission.texture.id, black);
+    r3d_shader_bind_sampler2D_opt(raster.geometry[variant], uTexORM, call->material.orm.texture.id, white);
 
     // Setup geometry type related uniforms
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.geometry, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
-                r3d_shader_set_int(raster.geometry, uUseSkinning, true);
+            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.geometry[variant], uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.geometry[variant], uBoneOffset, call->geometry.model.boneOffset);
+                r3d_shader_set_int(raster.geometry[variant], uUseSkinning, true);
             }
             else {
-                r3d_shader_set_int(raster.geometry, uUseSkinning, false);
+                r3d_shader_set_int(raster.geometry[variant], uUseSkinning, false);
             }
         }
         break;
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
         {
             // Send bone matrices and animation related data
-            r3d_shader_set_int(raster.geometry, uUseSkinning, false);
+            r3d_shader_set_int(raster.geometry[variant], uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
     // Applying material parameters that are independent of shaders
     r3d_drawcall_apply_cull_mode(call->material.cullMode);
 
     // Rendering the object corresponding to the draw call
-    r3d_drawcall(call);
+    r3d_drawcall(call, &matMVP, false);
 
     // Unbind all bound texture maps
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexAlbedo);
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexNormal);
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexEmission);
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexORM);
+    r3d_shader_unbind_sampler2D(raster.geometry[variant], uTexAlbedo);
+    r3d_shader_unbind_sampler2D(raster.geometry[variant], uTexNormal);
+    r3d_shader_unbind_sampler2D(raster.geometry[variant], uTexEmission);
+    r3d_shader_unbind_sampler2D(raster.geometry[variant], uTexORM);
 }
 
 void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
 {
-    if (call->instanced.count == 0 || call->instanced.transforms == NULL) {
+    if (call->instanced.count == 0 || (call->instanced.transforms == NULL && call->instanced.packed == NULL && call->instanced.buffer == 0)) {
         return;
     }
 
@@ -508,10 +590,17 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
     r3d_shader_set_vec2(raster.geometryInst, uTexCoordOffset, call->material.uvOffset);
     r3d_shader_set_vec2(raster.geometryInst, uTexCoordScale, call->material.uvScale);
 
+    // Sprite frames of the instances are mapped within the texcoord offset/scale by the shader
+    r3d_shader_set_vec2(raster.geometryInst, uSpriteFrameCount, (call->instanced.params != NULL)
+        ? (Vector2) { (float)call->instanced.xFrameCount, (float)call->instanced.yFrameCount } : (Vector2) { 0 });
+
     // Set color material maps
     r3d_shader_set_col3(raster.geometryInst, uAlbedoColor, call->material.albedo.color);
     r3d_shader_set_col3(raster.geometryInst, uEmissionColor, call->material.emission.color);
 
+    // Send the format of the instances
+    r3d_shader_set_int(raster.geometryInst, uPackedInstances, call->instanced.packed != NULL);
+
     // Setup billboard mode
     r3d_shader_set_int(raster.geometryInst, uBillboardMode, call->material.billboardMode);
     if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
@@ -523,11 +612,27 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.geometryInst, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+            if (call->instanced.vertexAnim != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.geometryInst, uTexVertexAnim, call->instanced.vertexAnim->texture);
+                r3d_shader_set_int(raster.geometryInst, uVertexAnimBase, call->instanced.vertexAnimBase);
+                r3d_shader_set_int(raster.geometryInst, uUseVertexAnimation, true);
+                r3d_shader_set_int(raster.geometryInst, uUseSkinning, false);
+            }
+            else if (call->instanced.animTexture != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.geometryInst, uTexBoneMatrices, call->instanced.animTexture->texture);
+                r3d_shader_set_int(raster.geometryInst, uUseInstanceAnimation, true);
+                r3d_shader_set_int(raster.geometryInst, uUseVertexAnimation, false);
+                r3d_shader_set_int(raster.geometryInst, uUseSkinning, true);
+            }
+            else if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.geometryInst, uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.geometryInst, uBoneOffset, call->geometry.model.boneOffset);
+                r3d_shader_set_int(raster.geometryInst, uUseInstanceAnimation, false);
+                r3d_shader_set_int(raster.geometryInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.geometryInst, uUseSkinning, true);
             }
             else {
+                r3d_shader_set_int(raster.geometryInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.geometryInst, uUseSkinning, false);
             }
         }
@@ -535,9 +640,13 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
         {
             // Send bone matrices and animation related data
+            r3d_shader_set_int(raster.geometryInst, uUseVertexAnimation, false);
             r3d_shader_set_int(raster.geometryInst, uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
     // Bind active texture maps
@@ -550,7 +659,7 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
     r3d_drawcall_apply_cull_mode(call->material.cullMode);
 
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, 14);
+    r3d_drawcall_instanced(call, NULL, 10, 14, 15, 8);
 
     // Unbind all bound texture maps
     r3d_shader_unbind_sampler2D(raster.geometryInst, uTexAlbedo);
@@ -559,6 +668,108 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
     r3d_shader_unbind_sampler2D(raster.geometryInst, uTexORM);
 }
 
+void r3d_drawcall_raster_impostor(const r3d_drawcall_t* call, Vector3 viewPosition)
+{
+    const R3D_Impostor* impostor = call->geometry.impostor.impostor;
+
+    Matrix matModel, matNormal, matVP, temp;
+
+    // Calculate transform matrix
+    temp = rlGetMatrixTransform();
+    matModel = r3d_matrix_multiply(&call->transform, &temp);
+
+    // Calculate normal matrix
+    matNormal = r3d_matrix_normal(&matModel);
+
+    // Calculate view projection
+    matVP = rlGetMatrixModelview();
+    temp = rlGetMatrixProjection();
+    matVP = r3d_matrix_multiply(&matVP, &temp);
+
+    // Set matrix uniforms
+    r3d_shader_set_mat4(raster.impostor, uMatNormal, matNormal);
+    r3d_shader_set_mat4(raster.impostor, uMatModel, matModel);
+    r3d_shader_set_mat4(raster.impostor, uMatVP, matVP);
+
+    // Set impostor parameters
+    r3d_shader_set_vec3(raster.impostor, uViewPosition, viewPosition);
+    r3d_shader_set_vec3(raster.impostor, uCenter, impostor->center);
+    r3d_shader_set_float(raster.impostor, uRadius, impostor->radius);
+    r3d_shader_set_int(raster.impostor, uFrames, impostor->frames);
+    r3d_shader_set_float(raster.impostor, uDitherFade, call->ditherFade);
+
+    // Bind impostor atlases
+    r3d_shader_bind_sampler2D(raster.impostor, uTexAlbedo, impostor->albedo.id);
+    r3d_shader_bind_sampler2D(raster.impostor, uTexEmission, impostor->emission.id);
+    r3d_shader_bind_sampler2D(raster.impostor, uTexNormal, impostor->normal.id);
+    r3d_shader_bind_sampler2D(raster.impostor, uTexORM, impostor->orm.id);
+    r3d_shader_bind_sampler2D(raster.impostor, uTexDepth, impostor->depth.id);
+
+    // The quad always faces the camera
+    glDisable(GL_CULL_FACE);
+
+    // Rendering the impostor quad
+    r3d_drawcall(call, NULL, false);
+
+    // Unbind all bound texture maps
+    r3d_shader_unbind_sampler2D(raster.impostor, uTexAlbedo);
+    r3d_shader_unbind_sampler2D(raster.impostor, uTexEmission);
+    r3d_shader_unbind_sampler2D(raster.impostor, uTexNormal);
+    r3d_shader_unbind_sampler2D(raster.impostor, uTexORM);
+    r3d_shader_unbind_sampler2D(raster.impostor, uTexDepth);
+}
+
+void r3d_drawcall_raster_impostor_inst(const r3d_drawcall_t* call, Vector3 viewPosition)
+{
+    if (call->instanced.count == 0 || (call->instanced.transforms == NULL && call->instanced.packed == NULL && call->instanced.buffer == 0)) {
+        return;
+    }
+
+    const R3D_Impostor* impostor = call->geometry.impostor.impostor;
+
+    Matrix matModel, matVP, temp;
+
+    // Calculate transform
+    temp = rlGetMatrixTransform();
+    matModel = r3d_matrix_multiply(&call->transform, &temp);
+
+    // Calculate view projection
+    matVP = rlGetMatrixModelview();
+    temp = rlGetMatrixProjection();
+    matVP = r3d_matrix_multiply(&matVP, &temp);
+
+    // Set matrix uniforms
+    r3d_shader_set_mat4(raster.impostorInst, uMatModel, matModel);
+    r3d_shader_set_mat4(raster.impostorInst, uMatVP, matVP);
+
+    // Set impostor parameters
+    r3d_shader_set_vec3(raster.impostorInst, uViewPosition, viewPosition);
+    r3d_shader_set_vec3(raster.impostorInst, uCenter, impostor->center);
+    r3d_shader_set_float(raster.impostorInst, uRadius, impostor->radius);
+    r3d_shader_set_int(raster.impostorInst, uFrames, impostor->frames);
+    r3d_shader_set_float(raster.impostorInst, uDitherFade, call->ditherFade);
+
+    // Bind impostor atlases
+    r3d_shader_bind_sampler2D(raster.impostorInst, uTexAlbedo, impostor->albedo.id);
+    r3d_shader_bind_sampler2D(raster.impostorInst, uTexEmission, impostor->emission.id);
+    r3d_shader_bind_sampler2D(raster.impostorInst, uTexNormal, impostor->normal.id);
+    r3d_shader_bind_sampler2D(raster.impostorInst, uTexORM, impostor->orm.id);
+    r3d_shader_bind_sampler2D(raster.impostorInst, uTexDepth, impostor->depth.id);
+
+    // The quads always face the camera
+    glDisable(GL_CULL_FACE);
+
+    // Rendering the impostor quads
+    r3d_drawcall_instanced(call, NULL, 10, -1, -1, -1);
+
+    // Unbind all bound texture maps
+    r3d_shader_unbind_sampler2D(raster.impostorInst, uTexAlbedo);
+    r3d_shader_unbind_sampler2D(raster.impostorInst, uTexEmission);
+    r3d_shader_unbind_sampler2D(raster.impostorInst, uTexNormal);
+    r3d_shader_unbind_sampler2D(raster.impostorInst, uTexORM);
+    r3d_shader_unbind_sampler2D(raster.impostorInst, uTexDepth);
+}
+
 void r3d_drawcall_raster_forward(const r3d_drawcall_t* call)
 {
     Matrix matModel, matNormal, matMVP, temp;
@@ -610,8 +821,9 @@ void r3d_drawcall_raster_forward(const r3d_drawcall_t* call)
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.forward, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.forward, uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.forward, uBoneOffset, call->geometry.model.boneOffset);
                 r3d_shader_set_int(raster.forward, uUseSkinning, true);
             }
             else {
@@ -625,6 +837,9 @@ void r3d_drawcall_raster_forward(const r3d_drawcall_t* call)
             r3d_shader_set_int(raster.forward, uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
     // Applying material parameters that are independent of shaders
@@ -632,7 +847,7 @@ void r3d_drawcall_raster_forward(const r3d_drawcall_t* call)
     r3d_drawcall_apply_blend_mode(call->material.blendMode);
 
     // Rendering the object corresponding to the draw call
-    r3d_drawcall(call);
+    r3d_drawcall(call, &matMVP, false);
 
     // Unbind all bound texture maps
     r3d_shader_unbind_sampler2D(raster.forward, uTexAlbedo);
@@ -643,7 +858,7 @@ void r3d_drawcall_raster_forward(const r3d_drawcall_t* call)
 
 void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
 {
-    if (call->instanced.count == 0 || call->instanced.transforms == NULL) {
+    if (call->instanced.count == 0 || (call->instanced.transforms == NULL && call->instanced.packed == NULL && call->instanced.buffer == 0)) {
         return;
     }
 
@@ -676,10 +891,17 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
     r3d_shader_set_vec2(raster.forwardInst, uTexCoordOffset, call->material.uvOffset);
     r3d_shader_set_vec2(raster.forwardInst, uTexCoordScale, call->material.uvScale);
 
+    // Sprite frames of the instances are mapped within the texcoord offset/scale by the shader
+    r3d_shader_set_vec2(raster.forwardInst, uSpriteFrameCount, (call->instanced.params != NULL)
+        ? (Vector2) { (float)call->instanced.xFrameCount, (float)call->instanced.yFrameCount } : (Vector2) { 0 });
+
     // Set color material maps
     r3d_shader_set_col4(raster.forwardInst, uAlbedoColor, call->material.albedo.color);
     r3d_shader_set_col3(raster.forwardInst, uEmissionColor, call->material.emission.color);
 
+    // Send the format of the instances
+    r3d_shader_set_int(raster.forwardInst, uPackedInstances, call->instanced.packed != NULL);
+
     // Setup billboard mode
     r3d_shader_set_int(raster.forwardInst, uBillboardMode, call->material.billboardMode);
     if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
@@ -691,11 +913,27 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
-                r3d_shader_set_mat4_v(raster.forwardInst, uBoneMatrices, call->geometry.model.mesh->boneMatrices, call->geometry.model.mesh->boneCount);
+            if (call->instanced.vertexAnim != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.forwardInst, uTexVertexAnim, call->instanced.vertexAnim->texture);
+                r3d_shader_set_int(raster.forwardInst, uVertexAnimBase, call->instanced.vertexAnimBase);
+                r3d_shader_set_int(raster.forwardInst, uUseVertexAnimation, true);
+                r3d_shader_set_int(raster.forwardInst, uUseSkinning, false);
+            }
+            else if (call->instanced.animTexture != NULL) {
+                r3d_shader_bind_samplerBuffer(raster.forwardInst, uTexBoneMatrices, call->instanced.animTexture->texture);
+                r3d_shader_set_int(raster.forwardInst, uUseInstanceAnimation, true);
+                r3d_shader_set_int(raster.forwardInst, uUseVertexAnimation, false);
+                r3d_shader_set_int(raster.forwardInst, uUseSkinning, true);
+            }
+            else if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL && !call->geometry.model.preSkinned) {
+                r3d_shader_bind_samplerBuffer(raster.forwardInst, uTexBoneMatrices, R3D.skinning.paletteTexture);
+                r3d_shader_set_int(raster.forwardInst, uBoneOffset, call->geometry.model.boneOffset);
+                r3d_shader_set_int(raster.forwardInst, uUseInstanceAnimation, false);
+                r3d_shader_set_int(raster.forwardInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.forwardInst, uUseSkinning, true);
             }
             else {
+                r3d_shader_set_int(raster.forwardInst, uUseVertexAnimation, false);
                 r3d_shader_set_int(raster.forwardInst, uUseSkinning, false);
             }
         }
@@ -703,9 +941,13 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
         {
             // Send bone matrices and animation related data
+            r3d_shader_set_int(raster.forwardInst, uUseVertexAnimation, false);
             r3d_shader_set_int(raster.forwardInst, uUseSkinning, false);
         }
         break;
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
+        // Drawn by the impostor shaders, see 'r3d_drawcall_raster_impostor'
+        break;
     }
 
     // Bind active texture maps
@@ -718,8 +960,19 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
     r3d_drawcall_apply_cull_mode(call->material.cullMode);
     r3d_drawcall_apply_blend_mode(call->material.blendMode);
 
+    // Order transparent instances from back to front, instances read from a GPU buffer keep their order
+    const uint32_t* order = NULL;
+    if ((R3D.state.flags & R3D_FLAG_INSTANCE_SORTING) && call->material.blendMode != R3D_BLEND_OPAQUE
+        && call->instanced.buffer == 0 && call->instanced.count > 1)
+    {
+        Matrix matModelView = r3d_matrix_multiply(&matModel, &R3D.state.transform.view);
+        order = (call->instanced.packed != NULL)
+            ? r3d_sort_packed_back_to_front(call->instanced.packed, call->instanced.count, &matModelView)
+            : r3d_sort_instances_back_to_front(call->instanced.transforms, call->instanced.transStride, call->instanced.count, &matModelView);
+    }
+
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, 14);
+    r3d_drawcall_instanced(call, order, 10, 14, 15, 8);
 
     // Unbind all bound texture maps
     r3d_shader_unbind_sampler2D(raster.forwardInst, uTexAlbedo);
@@ -736,14 +989,17 @@ void r3d_drawcall_apply_cull_mode(R3D_CullMode mode)
     {
     case R3D_CULL_NONE:
         glDisable(GL_CULL_FACE);
+        r3d_drawcall_culled_face = GL_NONE;
         break;
     case R3D_CULL_BACK:
         glEnable(GL_CULL_FACE);
         glCullFace(GL_BACK);
+        r3d_drawcall_culled_face = GL_BACK;
         break;
     case R3D_CULL_FRONT:
         glEnable(GL_CULL_FACE);
         glCullFace(GL_FRONT);
+        r3d_drawcall_culled_face = GL_FRONT;
         break;
     }
 }
@@ -778,14 +1034,17 @@ static void r3d_drawcall_apply_shadow_cast_mode(R3D_ShadowCastMode mode)
     {
     case R3D_SHADOW_CAST_ALL_FACES:
         glDisable(GL_CULL_FACE);
+        r3d_drawcall_culled_face = GL_NONE;
         break;
     case R3D_SHADOW_CAST_FRONT_FACES:
         glEnable(GL_CULL_FACE);
         glCullFace(GL_BACK);
+        r3d_drawcall_culled_face = GL_BACK;
         break;
     case R3D_SHADOW_CAST_BACK_FACES:
         glEnable(GL_CULL_FACE);
         glCullFace(GL_FRONT);
+        r3d_drawcall_culled_face = GL_FRONT;
         break;
 
     case R3D_SHADOW_CAST_DISABLED:
@@ -830,6 +1089,28 @@ static void r3d_drawcall_bind_geometry_mesh(const R3D_Mesh* mesh)
     }
 }
 
+static void r3d_drawcall_bind_preskinned_vertices(const r3d_drawcall_t* call)
+{
+    // Positions, normals and tangents are read from the vertices skinned for this frame,
+    // the other attributes still come from the mesh
+    const size_t stride = 10 * sizeof(float);
+    size_t offset = call->geometry.model.skinnedVertex * stride;
+
+    glBindBuffer(GL_ARRAY_BUFFER, R3D.skinning.vertexBuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (const void*)(offset));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (const void*)(offset + 3 * sizeof(float)));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (const void*)(offset + 6 * sizeof(float)));
+}
+
+static void r3d_drawcall_unbind_preskinned_vertices(const R3D_Mesh* mesh)
+{
+    // Restore the layout of the mesh, the vertex array is shared by all its draws
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(R3D_Vertex), (const void*)offsetof(R3D_Vertex, position));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(R3D_Vertex), (const void*)offsetof(R3D_Vertex, normal));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(R3D_Vertex), (const void*)offsetof(R3D_Vertex, tangent));
+}
+
 static void r3d_drawcall_unbind_geometry_mesh(void)
 {
     rlDisableVertexArray();
@@ -837,37 +1118,204 @@ static void r3d_drawcall_unbind_geometry_mesh(void)
     rlDisableVertexBufferElement();
 }
 
-void r3d_drawcall(const r3d_drawcall_t* call)
+static void r3d_drawcall_draw_mesh_ranges(const R3D_Mesh* mesh, const Matrix* matMVP)
+{
+    #define MAX_RANGES_PER_DRAW 64
+
+    GLsizei counts[MAX_RANGES_PER_DRAW];
+    const void* offsets[MAX_RANGES_PER_DRAW];
+    int drawCount = 0;
+
+    // Frustum planes expressed in the local space of the mesh,
+    // which allows testing the range AABBs directly in every pass
+    r3d_frustum_t frustum = r3d_frustum_create(*matMVP);
+
+    for (int i = 0; i < mesh->rangeCount; i++)
+    {
+        const R3D_MeshRange* range = &mesh->ranges[i];
+
+        if (!r3d_frustum_is_aabb_in(&frustum, &range->aabb)) {
+            continue;
+        }
+
+        // Contiguous visible ranges are coalesced into a single one
+        if (drawCount > 0) {
+            size_t prevEnd = (size_t)offsets[drawCount - 1] / sizeof(unsigned int) + counts[drawCount - 1];
+            if (prevEnd == (size_t)range->indexOffset) {
+                counts[drawCount - 1] += range->indexCount;
+                continue;
+            }
+        }
+
+        if (drawCount == MAX_RANGES_PER_DRAW) {
+            glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, drawCount);
+            drawCount = 0;
+        }
+
+        counts[drawCount] = range->indexCount;
+        offsets[drawCount] = (const void*)(range->indexOffset * sizeof(unsigned int));
+        drawCount++;
+    }
+
+    if (drawCount > 0) {
+        glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, drawCount);
+    }
+
+    #undef MAX_RANGES_PER_DRAW
+}
+
+static void r3d_drawcall_draw_mesh_meshlets(const R3D_Meshlet* meshlets, int meshletCount, const Matrix* matTransform, const Matrix* matMVP)
+{
+    #define MAX_MESHLETS_PER_DRAW 64
+
+    GLsizei counts[MAX_MESHLETS_PER_DRAW];
+    const void* offsets[MAX_MESHLETS_PER_DRAW];
+    int drawCount = 0;
+
+    // Frustum planes expressed in the local space of the mesh
+    r3d_frustum_t frustum = r3d_frustum_create(*matMVP);
+
+    // The viewer in local space is the point projected to infinity (0, 0, 1, 0) in clip space,
+    // it degenerates into a view direction with orthographic projections
+    Matrix invMVP = MatrixInvert(*matMVP);
+    Vector3 viewer = { invMVP.m8, invMVP.m9, invMVP.m10 };
+    bool orthographic = fabsf(invMVP.m11) <= 1e-6f * Vector3Length(viewer);
+    viewer = orthographic ? Vector3Normalize(viewer) : Vector3Scale(viewer, 1.0f / invMVP.m11);
+
+    // The cone test is done against the faces culled by OpenGL,
+    // which are swapped when the transform mirrors the geometry
+    float coneSign = 0.0f;
+    if (r3d_drawcall_culled_face != GL_NONE) {
+        coneSign = (r3d_drawcall_culled_face == GL_BACK) ? 1.0f : -1.0f;
+        if (MatrixDeterminant(*matTransform) < 0.0f) coneSign = -coneSign;
+    }
+
+    for (int i = 0; i < meshletCount; i++)
+    {
+        const R3D_Meshlet* meshlet = &meshlets[i];
+
+        if (!r3d_frustum_is_sphere_in(&frustum, &meshlet->center, meshlet->radius)) {
+            continue;
+        }
+
+        // Skip clusters whose triangles all face the culled side
+        if (coneSign != 0.0f && meshlet->coneCutoff < 1.0f) {
+            Vector3 axis = Vector3Scale(meshlet->coneAxis, coneSign);
+            if (orthographic) {
+                if (Vector3DotProduct(viewer, axis) >= meshlet->coneCutoff) continue;
+            }
+            else {
+                Vector3 toCenter = Vector3Subtract(meshlet->center, viewer);
+                float dist = Vector3Length(toCenter);
+                if (Vector3DotProduct(toCenter, axis) >= meshlet->coneCutoff * dist + meshlet->radius) continue;
+            }
+        }
+
+        // Contiguous visible meshlets are coalesced into a single range
+        if (drawCount > 0) {
+            size_t prevEnd = (size_t)offsets[drawCount - 1] / sizeof(unsigned int) + counts[drawCount - 1];
+            if (prevEnd == (size_t)meshlet->indexOffset) {
+                counts[drawCount - 1] += meshlet->indexCount;
+                continue;
+            }
+        }
+
+        if (drawCount == MAX_MESHLETS_PER_DRAW) {
+            glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, drawCount);
+            drawCount = 0;
+        }
+
+        counts[drawCount] = meshlet->indexCount;
+        offsets[drawCount] = (const void*)(meshlet->indexOffset * sizeof(unsigned int));
+        drawCount++;
+    }
+
+    if (drawCount > 0) {
+        glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, drawCount);
+    }
+
+    #undef MAX_MESHLETS_PER_DRAW
+}
+
+void r3d_drawcall(const r3d_drawcall_t* call, const Matrix* matMVP, bool shadow)
 {
     if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
-        r3d_drawcall_bind_geometry_mesh(call->geometry.model.mesh);
-        if (call->geometry.model.mesh->indices == NULL) {
-            glDrawArrays(GL_TRIANGLES, 0, call->geometry.model.mesh->vertexCount);
+        const R3D_Mesh* mesh = call->geometry.model.mesh;
+        r3d_drawcall_bind_geometry_mesh(mesh);
+
+        if (call->geometry.model.preSkinned) {
+            r3d_drawcall_bind_preskinned_vertices(call);
+        }
+
+        // Shadow passes can use coarser levels of detail than the view,
+        // meshes close enough to be drawn in full keep their full geometry
+        int lod = call->geometry.model.lod;
+        if (shadow && lod > 0) {
+            lod += R3D.state.lod.shadowBias;
+            if (lod > mesh->lodCount) lod = mesh->lodCount;
+        }
+
+        if (lod > 0 && lod <= mesh->lodCount && mesh->lods[lod - 1].ebo != 0) {
+            const R3D_MeshLOD* level = &mesh->lods[lod - 1];
+            rlEnableVertexBufferElement(level->ebo);
+            if (level->meshletCount > 1 && call->geometry.model.anim == NULL) {
+                r3d_drawcall_draw_mesh_meshlets(level->meshlets, level->meshletCount, &call->transform, matMVP);
+            }
+            else {
+                glDrawElements(GL_TRIANGLES, level->indexCount, GL_UNSIGNED_INT, NULL);
+            }
+            // The element buffer is part of the vertex array state
+            rlEnableVertexBufferElement(mesh->ebo);
+        }
+        else if (mesh->indices == NULL) {
+            glDrawArrays(GL_TRIANGLES, 0, mesh->vertexCount);
+        }
+        else if (mesh->meshletCount > 1 && mesh->ebo != 0 && call->geometry.model.anim == NULL) {
+            r3d_drawcall_draw_mesh_meshlets(mesh->meshlets, mesh->meshletCount, &call->transform, matMVP);
+        }
+        else if (mesh->rangeCount > 1 && mesh->ebo != 0 && call->geometry.model.anim == NULL) {
+            r3d_drawcall_draw_mesh_ranges(mesh, matMVP);
         }
         else {
-            glDrawElements(GL_TRIANGLES, call->geometry.model.mesh->indexCount, GL_UNSIGNED_INT, NULL);
+            glDrawElements(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT, NULL);
+        }
+
+        if (call->geometry.model.preSkinned) {
+            r3d_drawcall_unbind_preskinned_vertices(mesh);
         }
+
         r3d_drawcall_unbind_geometry_mesh();
     }
 
-    // Sprite mode only requires to render a generic quad
-    else if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
+    // Sprite and impostor modes only require to render a generic quad
+    else if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE ||
+             call->geometryType == R3D_DRAWCALL_GEOMETRY_IMPOSTOR) {
         r3d_primitive_bind_and_draw_quad();
     }
 }
 
-void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor)
+void r3d_drawcall_instanced(const r3d_drawcall_t* call, const uint32_t* order, int locInstanceModel, int locInstanceColor, int locInstanceAnim, int locInstanceParams)
 {
     // Bind the geometry
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         r3d_drawcall_bind_geometry_mesh(call->geometry.model.mesh);
+        if (call->geometry.model.preSkinned) {
+            r3d_drawcall_bind_preskinned_vertices(call);
+        }
         break;
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
         r3d_primitive_bind(&R3D.primitive.quad);
         break;
     }
 
+    // Instances culled on the GPU are drawn right away, only the mesh is left to unbind
+    if (r3d_drawcall_instanced_gpu_culled(call, order, locInstanceModel, locInstanceColor, locInstanceParams)) {
+        r3d_drawcall_unbind_geometry_mesh();
+        return;
+    }
+
     // WARNING: Always use the same attribute locations in shaders for instance matrices and colors.
     // If attribute locations differ between shaders (e.g., between the depth shader and the geometry shader),
     // it will break the rendering. This is because the vertex attributes are assigned based on specific 
@@ -877,11 +1325,40 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
 
     unsigned int vboTransforms = 0;
     unsigned int vboColors = 0;
-
+    unsigned int vboAnims = 0;
+    unsigned int vboParams = 0;
+
+    // Instances stored in a GPU buffer are read in place, the buffer is owned by its producer
+    if (call->instanced.buffer != 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, call->instanced.buffer);
+        if (locInstanceModel >= 0) {
+            for (int i = 0; i < 4; i++) {
+                rlSetVertexAttribute(locInstanceModel + i, 4, RL_FLOAT, false, (int)call->instanced.transStride, i * sizeof(Vector4));
+                rlSetVertexAttributeDivisor(locInstanceModel + i, 1);
+                rlEnableVertexAttribute(locInstanceModel + i);
+            }
+        }
+    }
+    // Packed instances are read from the locations of the matrix, see 'r3d_instance.h'
+    else if (call->instanced.packed != NULL) {
+        vboTransforms = r3d_drawcall_load_instance_buffer(call->instanced.packed, sizeof(R3D_PackedInstance), sizeof(R3D_PackedInstance), call->instanced.count, order);
+        rlEnableVertexBuffer(vboTransforms);
+        if (locInstanceModel >= 0) {
+            glVertexAttribPointer(locInstanceModel + 0, 3, GL_FLOAT, GL_FALSE, sizeof(R3D_PackedInstance), (void*)R3D_INSTANCE_POSITION_OFFSET);
+            glVertexAttribPointer(locInstanceModel + 1, 4, GL_SHORT, GL_TRUE, sizeof(R3D_PackedInstance), (void*)R3D_INSTANCE_ROTATION_OFFSET);
+            glVertexAttribPointer(locInstanceModel + 2, 4, GL_HALF_FLOAT, GL_FALSE, sizeof(R3D_PackedInstance), (void*)R3D_INSTANCE_SCALE_OFFSET);
+            for (int i = 0; i < 3; i++) {
+                rlSetVertexAttributeDivisor(locInstanceModel + i, 1);
+                rlEnableVertexAttribute(locInstanceModel + i);
+            }
+            rlDisableVertexAttribute(locInstanceModel + 3);
+        }
+    }
     // Enable the attribute for the transformation matrix (decomposed into 4 vec4 vectors)
-    if (locInstanceModel >= 0 && call->instanced.transforms) {
+    else if (locInstanceModel >= 0 && call->instanced.transforms) {
         size_t stride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
-        vboTransforms = rlLoadVertexBuffer(call->instanced.transforms, (int)(call->instanced.count * stride), true);
+        vboTransforms = r3d_drawcall_load_instance_buffer(call->instanced.transforms, stride, sizeof(Matrix), call->instanced.count, order);
+        if (order != NULL) stride = sizeof(Matrix);
         rlEnableVertexBuffer(vboTransforms);
         for (int i = 0; i < 4; i++) {
             rlSetVertexAttribute(locInstanceModel + i, 4, RL_FLOAT, false, (int)stride, i * sizeof(Vector4));
@@ -903,11 +1380,22 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
     }
 
     // Handle per-instance colors if available
-    if (locInstanceColor >= 0 && call->instanced.colors) {
+    if (locInstanceColor >= 0 && call->instanced.buffer != 0) {
+        rlSetVertexAttribute(locInstanceColor, 4, RL_FLOAT, false, (int)call->instanced.transStride, (int)call->instanced.bufferColorOffset);
+        rlSetVertexAttributeDivisor(locInstanceColor, 1);
+        rlEnableVertexAttribute(locInstanceColor);
+    }
+    else if (locInstanceColor >= 0 && call->instanced.packed != NULL) {
+        rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, sizeof(R3D_PackedInstance), R3D_INSTANCE_COLOR_OFFSET);
+        rlSetVertexAttributeDivisor(locInstanceColor, 1);
+        rlEnableVertexAttribute(locInstanceColor);
+    }
+    else if (locInstanceColor >= 0 && call->instanced.colors) {
         size_t stride = (call->instanced.colStride == 0) ? sizeof(Color) : call->instanced.colStride;
-        vboColors = rlLoadVertexBuffer(call->instanced.colors, (int)(call->instanced.count * stride), true);
+        vboColors = r3d_drawcall_load_instance_buffer(call->instanced.colors, stride, sizeof(Color), call->instanced.count, order);
+        if (order != NULL) stride = sizeof(Color);
         rlEnableVertexBuffer(vboColors);
-        rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, (int)call->instanced.colStride, 0);
+        rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, (int)stride, 0);
         rlSetVertexAttributeDivisor(locInstanceColor, 1);
         rlEnableVertexAttribute(locInstanceColor);
     }
@@ -917,6 +1405,38 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
         rlDisableVertexAttribute(locInstanceColor);
     }
 
+    // Handle per-instance animation states if available
+    if (locInstanceAnim >= 0 && (call->instanced.animTexture || call->instanced.vertexAnim)) {
+        const r3d_instance_anim_t* anims = (const r3d_instance_anim_t*)R3D.container.aInstanceAnim.data + call->instanced.animOffset;
+        vboAnims = r3d_drawcall_load_instance_buffer(anims, sizeof(r3d_instance_anim_t), sizeof(r3d_instance_anim_t), call->instanced.count, order);
+        rlEnableVertexBuffer(vboAnims);
+        glVertexAttribIPointer(locInstanceAnim, 3, GL_UNSIGNED_INT, sizeof(r3d_instance_anim_t), (void*)0);
+        rlSetVertexAttributeDivisor(locInstanceAnim, 1);
+        rlEnableVertexAttribute(locInstanceAnim);
+    }
+
+    // Handle per-instance material parameters if available, the UV transform then the frame and factors on the next location
+    if (locInstanceParams >= 0 && call->instanced.params) {
+        vboParams = r3d_drawcall_load_instance_buffer(call->instanced.params, sizeof(R3D_InstanceParams), sizeof(R3D_InstanceParams), call->instanced.count, order);
+        rlEnableVertexBuffer(vboParams);
+        rlSetVertexAttribute(locInstanceParams + 0, 4, RL_FLOAT, false, sizeof(R3D_InstanceParams), offsetof(R3D_InstanceParams, uvOffset));
+        rlSetVertexAttribute(locInstanceParams + 1, 4, RL_FLOAT, false, sizeof(R3D_InstanceParams), offsetof(R3D_InstanceParams, frame));
+        for (int i = 0; i < 2; i++) {
+            rlSetVertexAttributeDivisor(locInstanceParams + i, 1);
+            rlEnableVertexAttribute(locInstanceParams + i);
+        }
+    }
+    else if (locInstanceParams >= 0) {
+        const float defaultParams[2 * 4] = {
+            0, 0, 1, 1,
+            0, 1, 1, 1
+        };
+        for (int i = 0; i < 2; i++) {
+            glVertexAttrib4fv(locInstanceParams + i, defaultParams + i * 4);
+            rlDisableVertexAttribute(locInstanceParams + i);
+        }
+    }
+
     // Draw the geometry
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
@@ -928,15 +1448,34 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
         }
         break;
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
         r3d_primitive_draw_instanced(&R3D.primitive.quad, (int)call->instanced.count);
         break;
     }
 
     // Clean up instanced data
+    if (call->instanced.buffer != 0) {
+        if (locInstanceModel >= 0) {
+            for (int i = 0; i < 4; i++) {
+                rlDisableVertexAttribute(locInstanceModel + i);
+                rlSetVertexAttributeDivisor(locInstanceModel + i, 0);
+            }
+        }
+        if (locInstanceColor >= 0) {
+            rlDisableVertexAttribute(locInstanceColor);
+            rlSetVertexAttributeDivisor(locInstanceColor, 0);
+        }
+    }
     if (vboTransforms > 0) {
-        for (int i = 0; i < 4; i++) {
-            rlDisableVertexAttribute(locInstanceModel + i);
-            rlSetVertexAttributeDivisor(locInstanceModel + i, 0);
+        if (locInstanceModel >= 0) {
+            for (int i = 0; i < 4; i++) {
+                rlDisableVertexAttribute(locInstanceModel + i);
+                rlSetVertexAttributeDivisor(locInstanceModel + i, 0);
+            }
+        }
+        if (locInstanceColor >= 0 && call->instanced.packed != NULL) {
+            rlDisableVertexAttribute(locInstanceColor);
+            rlSetVertexAttributeDivisor(locInstanceColor, 0);
         }
         rlUnloadVertexBuffer(vboTransforms);
     }
@@ -945,27 +1484,195 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
         rlSetVertexAttributeDivisor(locInstanceColor, 0);
         rlUnloadVertexBuffer(vboColors);
     }
+    if (vboAnims > 0) {
+        rlDisableVertexAttribute(locInstanceAnim);
+        rlSetVertexAttributeDivisor(locInstanceAnim, 0);
+        rlUnloadVertexBuffer(vboAnims);
+    }
+    if (vboParams > 0) {
+        for (int i = 0; i < 2; i++) {
+            rlDisableVertexAttribute(locInstanceParams + i);
+            rlSetVertexAttributeDivisor(locInstanceParams + i, 0);
+        }
+        rlUnloadVertexBuffer(vboParams);
+    }
 
     // Unbind the geometry
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
+        if (call->geometry.model.preSkinned) {
+            r3d_drawcall_unbind_preskinned_vertices(call->geometry.model.mesh);
+        }
         r3d_drawcall_unbind_geometry_mesh();
         break;
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
+    case R3D_DRAWCALL_GEOMETRY_IMPOSTOR:
         r3d_primitive_unbind();
         break;
     }
 }
 
+bool r3d_drawcall_instanced_gpu_cull_input(const r3d_drawcall_t* call, r3d_cull_gpu_input_t* input)
+{
+    if (!(R3D.state.flags & R3D_FLAG_GPU_INSTANCE_CULLING) || !r3d_cull_gpu_is_available()) {
+        return false;
+    }
+
+    // Only instances of a static mesh given as matrices are culled
+    // Skinned and per-instance animated vertices can leave the bounds of the mesh
+    if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL
+        || call->instanced.count < R3D_CULL_GPU_MIN_INSTANCES || call->instanced.transforms == NULL
+        || call->instanced.packed != NULL || call->instanced.buffer != 0
+        || call->instanced.animTexture != NULL || call->instanced.vertexAnim != NULL
+        || call->geometry.model.anim != NULL || call->geometry.model.preSkinned) {
+        return false;
+    }
+
+    // The visible instances are compacted in any order, which would flicker once blended
+    if (call->material.blendMode != R3D_BLEND_OPAQUE) {
+        return false;
+    }
+
+    const R3D_Mesh* mesh = call->geometry.model.mesh;
+
+    *input = (r3d_cull_gpu_input_t) {
+        .transforms = call->instanced.transforms,
+        .transStride = call->instanced.transStride,
+        .colors = call->instanced.colors,
+        .colStride = call->instanced.colStride,
+        .params = call->instanced.params,
+        .count = call->instanced.count,
+        .aabb = mesh->aabb,
+        .billboard = (call->material.billboardMode != R3D_BILLBOARD_DISABLED),
+        .indexed = (mesh->indices != NULL),
+        .elementCount = (mesh->indices != NULL) ? mesh->indexCount : mesh->vertexCount
+    };
+
+    return true;
+}
+
+bool r3d_drawcall_instanced_gpu_culled(const r3d_drawcall_t* call, const uint32_t* order, int locInstanceModel, int locInstanceColor, int locInstanceParams)
+{
+    // Instances are uploaded once per frame before the passes, and drawn in their order when culled
+    if (!call->instanced.cullUploaded || order != NULL || locInstanceModel < 0) {
+        return false;
+    }
+
+    r3d_cull_gpu_input_t input;
+    if (!r3d_drawcall_instanced_gpu_cull_input(call, &input)) {
+        return false;
+    }
+
+    Matrix matModel, matVP, temp;
+
+    // Same matrices as the ones sent to the shader of the pass
+    temp = rlGetMatrixTransform();
+    matModel = r3d_matrix_multiply(&call->transform, &temp);
+    matVP = rlGetMatrixModelview();
+    temp = rlGetMatrixProjection();
+    matVP = r3d_matrix_multiply(&matVP, &temp);
+
+    r3d_cull_gpu_output_t output;
+    r3d_cull_gpu_run(&output, &input, call->instanced.cullOffset, &matModel, &matVP);
+
+    // Visible instances are tightly packed, see 'r3d_cull_gpu.h'
+    glBindBuffer(GL_ARRAY_BUFFER, output.buffer);
+
+    for (int i = 0; i < 4; i++) {
+        rlSetVertexAttribute(locInstanceModel + i, 4, RL_FLOAT, false, sizeof(Matrix), i * sizeof(Vector4));
+        rlSetVertexAttributeDivisor(locInstanceModel + i, 1);
+        rlEnableVertexAttribute(locInstanceModel + i);
+    }
+
+    if (locInstanceColor >= 0 && input.colors != NULL) {
+        rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, sizeof(Color), (int)output.colorOffset);
+        rlSetVertexAttributeDivisor(locInstanceColor, 1);
+        rlEnableVertexAttribute(locInstanceColor);
+    }
+    else if (locInstanceColor >= 0) {
+        const float defaultColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        glVertexAttrib4fv(locInstanceColor, defaultColor);
+        rlDisableVertexAttribute(locInstanceColor);
+    }
+
+    if (locInstanceParams >= 0 && input.params != NULL) {
+        rlSetVertexAttribute(locInstanceParams + 0, 4, RL_FLOAT, false, sizeof(R3D_InstanceParams), (int)(output.paramsOffset + offsetof(R3D_InstanceParams, uvOffset)));
+        rlSetVertexAttribute(locInstanceParams + 1, 4, RL_FLOAT, false, sizeof(R3D_InstanceParams), (int)(output.paramsOffset + offsetof(R3D_InstanceParams, frame)));
+        for (int i = 0; i < 2; i++) {
+            rlSetVertexAttributeDivisor(locInstanceParams + i, 1);
+            rlEnableVertexAttribute(locInstanceParams + i);
+        }
+    }
+    else if (locInstanceParams >= 0) {
+        const float defaultParams[2 * 4] = {
+            0, 0, 1, 1,
+            0, 1, 1, 1
+        };
+        for (int i = 0; i < 2; i++) {
+            glVertexAttrib4fv(locInstanceParams + i, defaultParams + i * 4);
+            rlDisableVertexAttribute(locInstanceParams + i);
+        }
+    }
+
+    // The instance count written by the culling is never read back
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, output.indirect);
+    if (input.indexed) {
+        glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL);
+    }
+    else {
+        glDrawArraysIndirect(GL_TRIANGLES, NULL);
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    // Clean up instanced data
+    for (int i = 0; i < 4; i++) {
+        rlDisableVertexAttribute(locInstanceModel + i);
+        rlSetVertexAttributeDivisor(locInstanceModel + i, 0);
+    }
+    if (locInstanceColor >= 0 && input.colors != NULL) {
+        rlDisableVertexAttribute(locInstanceColor);
+        rlSetVertexAttributeDivisor(locInstanceColor, 0);
+    }
+    if (locInstanceParams >= 0 && input.params != NULL) {
+        for (int i = 0; i < 2; i++) {
+            rlDisableVertexAttribute(locInstanceParams + i);
+            rlSetVertexAttributeDivisor(locInstanceParams + i, 0);
+        }
+    }
+
+    return true;
+}
+
+unsigned int r3d_drawcall_load_instance_buffer(const void* data, size_t stride, size_t size, size_t count, const uint32_t* order)
+{
+    if (order == NULL) {
+        return rlLoadVertexBuffer(data, (int)(count * stride), true);
+    }
+
+    unsigned int vbo = rlLoadVertexBuffer(NULL, (int)(count * size), true);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    unsigned char* dst = glMapBufferRange(GL_ARRAY_BUFFER, 0, count * size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (dst != NULL) {
+        const unsigned char* src = data;
+        for (size_t i = 0; i < count; i++) {
+            memcpy(dst + i * size, src + order[i] * stride, size);
+        }
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+
+    return vbo;
+}
+
 // Helper function to calculate AABB center distance in view space
 static float r3d_drawcall_calculate_center_distance_to_camera(const r3d_drawcall_t* drawCall)
 {
     // Calculate AABB center in local space
     Vector3 center = { 0 };
     if (drawCall->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
-        center.x = (drawCall->geometry.model.mesh->aabb.min.x + drawCall->geometry.model.mesh->aabb.max.x) * 0.5f;
-        center.y = (drawCall->geometry.model.mesh->aabb.min.y + drawCall->geometry.model.mesh->aabb.max.y) * 0.5f;
-        center.z = (drawCall->geometry.model.mesh->aabb.min.z + drawCall->geometry.model.mesh->aabb.max.z) * 0.5f;
+        center.x = (drawCall->geometry.model.aabb.min.x + drawCall->geometry.model.aabb.max.x) * 0.5f;
+        center.y = (drawCall->geometry.model.aabb.min.y + drawCall->geometry.model.aabb.max.y) * 0.5f;
+        center.z = (drawCall->geometry.model.aabb.min.z + drawCall->geometry.model.aabb.max.z) * 0.5f;
     }
     
     // Transform to world space
@@ -988,14 +1695,14 @@ static float r3d_drawcall_calculate_max_distance_to_camera(const r3d_drawcall_t*
     }
 
     Vector3 corners[8] = {
-        {drawCall->geometry.model.mesh->aabb.min.x, drawCall->geometry.model.mesh->aabb.min.y, drawCall->geometry.model.mesh->aabb.min.z},
-        {drawCall->geometry.model.mesh->aabb.max.x, drawCall->geometry.model.mesh->aabb.min.y, drawCall->geometry.model.mesh->aabb.min.z},
-        {drawCall->geometry.model.mesh->aabb.min.x, drawCall->geometry.model.mesh->aabb.max.y, drawCall->geometry.model.mesh->aabb.min.z},
-        {drawCall->geometry.model.mesh->aabb.max.x, drawCall->geometry.model.mesh->aabb.max.y, drawCall->geometry.model.mesh->aabb.min.z},
-        {drawCall->geometry.model.mesh->aabb.min.x, drawCall->geometry.model.mesh->aabb.min.y, drawCall->geometry.model.mesh->aabb.max.z},
-        {drawCall->geometry.model.mesh->aabb.max.x, drawCall->geometry.model.mesh->aabb.min.y, drawCall->geometry.model.mesh->aabb.max.z},
-        {drawCall->geometry.model.mesh->aabb.min.x, drawCall->geometry.model.mesh->aabb.max.y, drawCall->geometry.model.mesh->aabb.max.z},
-        {drawCall->geometry.model.mesh->aabb.max.x, drawCall->geometry.model.mesh->aabb.max.y, drawCall->geometry.model.mesh->aabb.max.z}
+        {drawCall->geometry.model.aabb.min.x, drawCall->geometry.model.aabb.min.y, drawCall->geometry.model.aabb.min.z},
+        {drawCall->geometry.model.aabb.max.x, drawCall->geometry.model.aabb.min.y, drawCall->geometry.model.aabb.min.z},
+        {drawCall->geometry.model.aabb.min.x, drawCall->geometry.model.aabb.max.y, drawCall->geometry.model.aabb.min.z},
+        {drawCall->geometry.model.aabb.max.x, drawCall->geometry.model.aabb.max.y, drawCall->geometry.model.aabb.min.z},
+        {drawCall->geometry.model.aabb.min.x, drawCall->geometry.model.aabb.min.y, drawCall->geometry.model.aabb.max.z},
+        {drawCall->geometry.model.aabb.max.x, drawCall->geometry.model.aabb.min.y, drawCall->geometry.model.aabb.max.z},
+        {drawCall->geometry.model.aabb.min.x, drawCall->geometry.model.aabb.max.y, drawCall->geometry.model.aabb.max.z},
+        {drawCall->geometry.model.aabb.max.x, drawCall->geometry.model.aabb.max.y, drawCall->geometry.model.aabb.max.z}
     };
 
     float maxDistSq = 0.0f;
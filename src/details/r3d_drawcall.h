@@ -23,15 +23,19 @@
 #include "r3d.h"
 
 #include "./containers/r3d_array.h"
+#include "./r3d_shaders.h"
+#include "./r3d_cull_gpu.h"
 
 #include <raylib.h>
+#include <stdint.h>
 #include <stddef.h>
 
 /* === Types === */
 
 typedef enum {
     R3D_DRAWCALL_GEOMETRY_MODEL,    //< Simple meshes are also considered as model here
-    R3D_DRAWCALL_GEOMETRY_SPRITE
+    R3D_DRAWCALL_GEOMETRY_SPRITE,
+    R3D_DRAWCALL_GEOMETRY_IMPOSTOR  //< Rendered with the impostor shaders, in their own arrays
 } r3d_drawcall_geometry_e;
 
 typedef enum {
@@ -39,6 +43,12 @@ typedef enum {
     R3D_DRAWCALL_RENDER_FORWARD
 } r3d_drawcall_render_mode_e;
 
+// Read by the shaders as a single 'uvec3' attribute, integer offsets staying exact past 2^24
+typedef struct {
+    uint32_t frameOffsets[2];   //< First matrix or vertex of the two baked frames surrounding the time of the instance
+    float blend;                //< Interpolation factor between the two frames, read back with 'uintBitsToFloat'
+} r3d_instance_anim_t;
+
 typedef struct {
 
     Matrix transform;
@@ -47,19 +57,29 @@ typedef struct {
     r3d_drawcall_geometry_e geometryType;
     r3d_drawcall_render_mode_e renderMode;
 
+    float ditherFade;   //< Dithered cross-fade, positive fades in, negative fades out (0 = disabled)
+
     union {
 
         struct {
             const R3D_Mesh* mesh;               //< Mesh to render
+            BoundingBox aabb;                   //< Bounds of the mesh in local space, following the animation if skinned
             const R3D_ModelAnimation* anim;     //< Animation to apply to the mesh (can be NULL)
             const Matrix* boneOffsets;          //< Bone offset matrices from the R3D_Model
-            int frame;                          //< Animation frame to apply to the mesh
+            int boneOffset;                     //< Index of the first skinning matrix of the model in the bone palette
+            int lod;                            //< Level of detail selected for the view (0 = full mesh)
+            int skinnedVertex;                  //< Index of the first vertex of the mesh in the pre-skinned vertex buffer
+            bool preSkinned;                    //< True if 'skinnedVertex' is valid, the mesh is then drawn without skinning
         } model;
 
         struct {
             Vector3 quad[4];    //< Used only to represent the sprite in world space
         } sprite;
 
+        struct {
+            const R3D_Impostor* impostor;
+        } impostor;
+
     } geometry;
 
     struct {
@@ -69,6 +89,18 @@ typedef struct {
         size_t transStride;
         size_t colStride;
         size_t count;
+        const R3D_AnimationTexture* animTexture;    //< Baked animations sampled per instance (can be NULL)
+        const R3D_VertexAnimation* vertexAnim;      //< Baked vertex animation sampled per instance (can be NULL)
+        int vertexAnimBase;                         //< Index of the first vertex of the mesh in a baked frame
+        size_t animOffset;                          //< Index of the first instance state in 'aInstanceAnim'
+        const R3D_PackedInstance* packed;           //< Packed instances read in place of 'transforms' and 'colors' (can be NULL)
+        unsigned int buffer;                        //< GPU buffer read in place of 'transforms' and 'colors' (0 = none)
+        size_t bufferColorOffset;                   //< Offset of the float colors in 'buffer', its stride being 'transStride'
+        const R3D_InstanceParams* params;           //< Material parameters of the instances (can be NULL)
+        int xFrameCount;                            //< Number of frames along X of the sprite sheet, zero if the frames of 'params' are not used
+        int yFrameCount;                            //< Number of frames along Y of the sprite sheet, zero if the frames of 'params' are not used
+        size_t cullOffset;                          //< Offset of the instances in the input buffer of the GPU culling
+        bool cullUploaded;                          //< True if 'cullOffset' is valid, the instances are then culled on the GPU
     } instanced;
 
 } r3d_drawcall_t;
@@ -82,7 +114,8 @@ void r3d_drawcall_sort_mixed_forward(r3d_drawcall_t* calls, size_t count);
 bool r3d_drawcall_geometry_is_visible(const r3d_drawcall_t* call);
 bool r3d_drawcall_instanced_geometry_is_visible(const r3d_drawcall_t* call);
 
-void r3d_drawcall_update_model_animation(const r3d_drawcall_t* call);
+// Describes the instances to cull on the GPU, returns false if the draw call is never culled this way
+bool r3d_drawcall_instanced_gpu_cull_input(const r3d_drawcall_t* call, r3d_cull_gpu_input_t* input);
 
 void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool shadow);
 void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool shadow);
@@ -90,9 +123,13 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool shadow);
 void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool shadow);
 void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool shadow);
 
-void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call);
+void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call, r3d_shader_geometry_variant_t variant);
 void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call);
 
+// Impostor quads face 'viewPosition', the camera or the light when rendering shadow maps
+void r3d_drawcall_raster_impostor(const r3d_drawcall_t* call, Vector3 viewPosition);
+void r3d_drawcall_raster_impostor_inst(const r3d_drawcall_t* call, Vector3 viewPosition);
+
 void r3d_drawcall_raster_forward(const r3d_drawcall_t* call);
 void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call);
 
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_INSTANCE_H
+#define R3D_DETAILS_INSTANCE_H
+
+#include "r3d.h"
+
+#include "./misc/r3d_half.h"
+
+#include <math.h>
+
+/* === Defines === */
+
+/*
+ * Attribute layout of a 'R3D_PackedInstance', read from the locations of the instance matrix:
+ * the position as three floats at the first one, the rotation as four normalized shorts
+ * at the second one and the scale as four half floats at the third one, the fourth being unused.
+ */
+#define R3D_INSTANCE_POSITION_OFFSET    0
+#define R3D_INSTANCE_COLOR_OFFSET       12
+#define R3D_INSTANCE_ROTATION_OFFSET    16
+#define R3D_INSTANCE_SCALE_OFFSET       24
+
+/* === Functions === */
+
+/*
+ * Packs an instance from a unit quaternion, rounding the rotation to nearest
+ * like the '_mm_cvtps_epi32' conversions of the SIMD paths.
+ */
+static inline void r3d_instance_pack(R3D_PackedInstance* dst, const Vector3* position, const Quaternion* rotation, const Vector3* scale, Color color)
+{
+    dst->position = *position;
+    dst->color = color;
+
+    dst->rotation[0] = (short)lrintf(rotation->x * 32767.0f);
+    dst->rotation[1] = (short)lrintf(rotation->y * 32767.0f);
+    dst->rotation[2] = (short)lrintf(rotation->z * 32767.0f);
+    dst->rotation[3] = (short)lrintf(rotation->w * 32767.0f);
+
+    dst->scale[0] = r3d_cvt_fh(scale->x);
+    dst->scale[1] = r3d_cvt_fh(scale->y);
+    dst->scale[2] = r3d_cvt_fh(scale->z);
+    dst->scale[3] = 0;
+}
+
+/*
+ * Quaternion of the rotation built by 'r3d_matrix_scale_rotxyz_translate', from the sines
+ * and cosines of the half angles, written so the SIMD paths can evaluate it the same way.
+ */
+static inline Quaternion r3d_instance_quat_from_half_angles(float sx, float cx, float sy, float cy, float sz, float cz)
+{
+    return (Quaternion) {
+        sx * cy * cz + cx * sy * sz,
+        cx * sy * cz - sx * cy * sz,
+        sx * sy * cz + cx * cy * sz,
+        cx * cy * cz - sx * sy * sz
+    };
+}
+
+#endif // R3D_DETAILS_INSTANCE_H
@@ -385,4 +385,37 @@ static inline Matrix r3d_matrix_normal(const Matrix* transform)
     return result;
 }
 
+static inline float r3d_matrix_max_scale(const Matrix* transform)
+{
+    // Largest scale factor of the basis vectors, used to scale bounding spheres
+    float sx = transform->m0 * transform->m0 + transform->m1 * transform->m1 + transform->m2 * transform->m2;
+    float sy = transform->m4 * transform->m4 + transform->m5 * transform->m5 + transform->m6 * transform->m6;
+    float sz = transform->m8 * transform->m8 + transform->m9 * transform->m9 + transform->m10 * transform->m10;
+    return sqrtf(fmaxf(sx, fmaxf(sy, sz)));
+}
+
+static inline BoundingBox r3d_matrix_transform_aabb(const Matrix* transform, const BoundingBox* aabb)
+{
+    // Transforms the center then projects the extents on each axis, cheaper than the eight corners
+    Vector3 c = { (aabb->min.x + aabb->max.x) * 0.5f, (aabb->min.y + aabb->max.y) * 0.5f, (aabb->min.z + aabb->max.z) * 0.5f };
+    Vector3 e = { (aabb->max.x - aabb->min.x) * 0.5f, (aabb->max.y - aabb->min.y) * 0.5f, (aabb->max.z - aabb->min.z) * 0.5f };
+
+    Vector3 center = {
+        transform->m0 * c.x + transform->m4 * c.y + transform->m8 * c.z + transform->m12,
+        transform->m1 * c.x + transform->m5 * c.y + transform->m9 * c.z + transform->m13,
+        transform->m2 * c.x + transform->m6 * c.y + transform->m10 * c.z + transform->m14
+    };
+
+    Vector3 extent = {
+        fabsf(transform->m0) * e.x + fabsf(transform->m4) * e.y + fabsf(transform->m8) * e.z,
+        fabsf(transform->m1) * e.x + fabsf(transform->m5) * e.y + fabsf(transform->m9) * e.z,
+        fabsf(transform->m2) * e.x + fabsf(transform->m6) * e.y + fabsf(transform->m10) * e.z
+    };
+
+    return (BoundingBox) {
+        { center.x - extent.x, center.y - extent.y, center.z - extent.z },
+        { center.x + extent.x, center.y + extent.y, center.z + extent.z }
+    };
+}
+
 #endif // R3D_MATH_H
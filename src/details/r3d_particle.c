@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "./r3d_particle.h"
+
+#include "./r3d_instance.h"
+#include "./r3d_curve.h"
+#include "./r3d_math.h"
+#include "./r3d_simd.h"
+
+#include <raylib.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* === Internal functions === */
+
+static float* r3d_particle_take_array(float** cursor, size_t count)
+{
+    float* array = *cursor;
+    *cursor += count;
+    return array;
+}
+
+#if defined(R3D_HAS_SSE2)
+
+// Sine and cosine of four angles, Cephes polynomials after a reduction to [-pi/4, pi/4]
+// Accurate to a couple of ulps as long as the angles stay within a few thousand radians
+static inline void r3d_particle_sincos(__m128 x, __m128* outSin, __m128* outCos)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    __m128 signSin = _mm_and_ps(x, signMask);
+    x = _mm_andnot_ps(signMask, x);
+
+    // Octant of the angle, rounded up to an even one
+    __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+    j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+    __m128 y = _mm_cvtepi32_ps(j);
+
+    __m128 swapSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+    __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+    signSin = _mm_xor_ps(signSin, swapSin);
+
+    // Extended precision reduction, x - y * pi/4 in three steps
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+
+    __m128 z = _mm_mul_ps(x, x);
+
+    __m128 c = _mm_set1_ps(2.443315711809948e-5f);
+    c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(-1.388731625493765e-3f));
+    c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+    c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+    c = _mm_sub_ps(c, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    c = _mm_add_ps(c, _mm_set1_ps(1.0f));
+
+    __m128 s = _mm_set1_ps(-1.9515295891e-4f);
+    s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(8.3321608736e-3f));
+    s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(-1.6666654611e-1f));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), x), x);
+
+    __m128 sinValue = _mm_or_ps(_mm_and_ps(polyMask, s), _mm_andnot_ps(polyMask, c));
+    __m128 cosValue = _mm_or_ps(_mm_and_ps(polyMask, c), _mm_andnot_ps(polyMask, s));
+
+    *outSin = _mm_xor_ps(sinValue, signSin);
+    *outCos = _mm_xor_ps(cosValue, signCos);
+}
+
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+
+// Sine and cosine of four angles, see the SSE2 version
+static inline void r3d_particle_sincos(float32x4_t x, float32x4_t* outSin, float32x4_t* outCos)
+{
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+
+    uint32x4_t signSin = vandq_u32(vreinterpretq_u32_f32(x), signMask);
+    x = vabsq_f32(x);
+
+    uint32x4_t j = vcvtq_u32_f32(vmulq_n_f32(x, 1.27323954473516f));
+    j = vandq_u32(vaddq_u32(j, vdupq_n_u32(1)), vdupq_n_u32(~1u));
+    float32x4_t y = vcvtq_f32_u32(j);
+
+    uint32x4_t swapSin = vshlq_n_u32(vandq_u32(j, vdupq_n_u32(4)), 29);
+    uint32x4_t signCos = vshlq_n_u32(vbicq_u32(vdupq_n_u32(4), vsubq_u32(j, vdupq_n_u32(2))), 29);
+    uint32x4_t polyMask = vceqq_u32(vandq_u32(j, vdupq_n_u32(2)), vdupq_n_u32(0));
+    signSin = veorq_u32(signSin, swapSin);
+
+    x = vaddq_f32(x, vmulq_n_f32(y, -0.78515625f));
+    x = vaddq_f32(x, vmulq_n_f32(y, -2.4187564849853515625e-4f));
+    x = vaddq_f32(x, vmulq_n_f32(y, -3.77489497744594108e-8f));
+
+    float32x4_t z = vmulq_f32(x, x);
+
+    float32x4_t c = vdupq_n_f32(2.443315711809948e-5f);
+    c = vaddq_f32(vmulq_f32(c, z), vdupq_n_f32(-1.388731625493765e-3f));
+    c = vaddq_f32(vmulq_f32(c, z), vdupq_n_f32(4.166664568298827e-2f));
+    c = vmulq_f32(vmulq_f32(c, z), z);
+    c = vsubq_f32(c, vmulq_n_f32(z, 0.5f));
+    c = vaddq_f32(c, vdupq_n_f32(1.0f));
+
+    float32x4_t s = vdupq_n_f32(-1.9515295891e-4f);
+    s = vaddq_f32(vmulq_f32(s, z), vdupq_n_f32(8.3321608736e-3f));
+    s = vaddq_f32(vmulq_f32(s, z), vdupq_n_f32(-1.6666654611e-1f));
+    s = vaddq_f32(vmulq_f32(vmulq_f32(s, z), x), x);
+
+    float32x4_t sinValue = vbslq_f32(polyMask, s, c);
+    float32x4_t cosValue = vbslq_f32(polyMask, c, s);
+
+    *outSin = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sinValue), signSin));
+    *outCos = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosValue), signCos));
+}
+
+#endif
+
+/* === Public functions (storage) === */
+
+bool r3d_particle_storage_create(R3D_Particles* particles, int capacity)
+{
+    memset(particles, 0, sizeof(R3D_Particles));
+
+    if (capacity <= 0) {
+        return false;
+    }
+
+    // Padding the arrays to eight elements keeps each of them aligned for AVX
+    size_t padded = ((size_t)capacity + 7) & ~(size_t)7;
+
+    size_t size = padded * sizeof(R3D_PackedInstance)   //< instances
+                + padded * 25 * sizeof(float)               //< lifetime and the eight vectors
+                + padded * sizeof(Color)                    //< colors
+                + padded * sizeof(unsigned char);           //< base opacities
+
+    uint8_t* block = RL_MALLOC(size);
+    if (block == NULL) {
+        return false;
+    }
+
+    particles->instances = (R3D_PackedInstance*)block;
+    float* floats = (float*)(block + padded * sizeof(R3D_PackedInstance));
+
+    particles->lifetime = r3d_particle_take_array(&floats, padded);
+
+    R3D_Vector3Array* vectors[] = {
+        &particles->position, &particles->rotation, &particles->scale,
+        &particles->velocity, &particles->angularVelocity,
+        &particles->baseScale, &particles->baseVelocity, &particles->baseAngularVelocity
+    };
+
+    for (int i = 0; i < (int)(sizeof(vectors) / sizeof(*vectors)); i++) {
+        vectors[i]->x = r3d_particle_take_array(&floats, padded);
+        vectors[i]->y = r3d_particle_take_array(&floats, padded);
+        vectors[i]->z = r3d_particle_take_array(&floats, padded);
+    }
+
+    particles->colors = (Color*)floats;
+    particles->baseOpacity = (unsigned char*)(particles->colors + padded);
+
+    return true;
+}
+
+void r3d_particle_storage_destroy(R3D_Particles* particles)
+{
+    RL_FREE(particles->instances);
+    memset(particles, 0, sizeof(R3D_Particles));
+}
+
+void r3d_particle_move(R3D_Particles* particles, int dst, int src)
+{
+    R3D_Vector3Array* vectors[] = {
+        &particles->position, &particles->rotation, &particles->scale,
+        &particles->velocity, &particles->angularVelocity,
+        &particles->baseScale, &particles->baseVelocity, &particles->baseAngularVelocity
+    };
+
+    for (int i = 0; i < (int)(sizeof(vectors) / sizeof(*vectors)); i++) {
+        vectors[i]->x[dst] = vectors[i]->x[src];
+        vectors[i]->y[dst] = vectors[i]->y[src];
+        vectors[i]->z[dst] = vectors[i]->z[src];
+    }
+
+    particles->lifetime[dst] = particles->lifetime[src];
+    particles->instances[dst] = particles->instances[src];
+    particles->colors[dst] = particles->colors[src];
+    particles->baseOpacity[dst] = particles->baseOpacity[src];
+}
+
+int r3d_particle_compact(R3D_Particles* particles, int count)
+{
+    const float* lifetime = particles->lifetime;
+
+    int i = count - 1;
+    while (i >= 0)
+    {
+        // Skip four alive particles at once, deaths are rare compared to the particle count
+        if (i >= 3) {
+#if defined(R3D_HAS_SSE)
+            __m128 dead = _mm_cmple_ps(_mm_loadu_ps(lifetime + i - 3), _mm_setzero_ps());
+            if (_mm_movemask_ps(dead) == 0) { i -= 4; continue; }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+            uint32x4_t dead = vcleq_f32(vld1q_f32(lifetime + i - 3), vdupq_n_f32(0.0f));
+            uint32x2_t any = vorr_u32(vget_low_u32(dead), vget_high_u32(dead));
+            if ((vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) == 0) { i -= 4; continue; }
+#endif
+        }
+
+        if (lifetime[i] <= 0.0f) {
+            r3d_particle_move(particles, i, --count);
+        }
+
+        i--;
+    }
+
+    return count;
+}
+
+/* === Public functions (kernels) === */
+
+void r3d_particle_build_instances(R3D_Particles* particles, int count)
+{
+    const R3D_Vector3Array* s = &particles->scale;
+    const R3D_Vector3Array* r = &particles->rotation;
+    const R3D_Vector3Array* t = &particles->position;
+
+    int i = 0;
+
+#if defined(R3D_HAS_SSE2)
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 snorm = _mm_set1_ps(32767.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 sx, cx, sy, cy, sz, cz;
+        r3d_particle_sincos(_mm_mul_ps(_mm_loadu_ps(r->x + i), half), &sx, &cx);
+        r3d_particle_sincos(_mm_mul_ps(_mm_loadu_ps(r->y + i), half), &sy, &cy);
+        r3d_particle_sincos(_mm_mul_ps(_mm_loadu_ps(r->z + i), half), &sz, &cz);
+
+        // Same expressions as 'r3d_instance_quat_from_half_angles', lane per particle
+        __m128 cycz = _mm_mul_ps(cy, cz), sysz = _mm_mul_ps(sy, sz);
+        __m128 sycz = _mm_mul_ps(sy, cz), cysz = _mm_mul_ps(cy, sz);
+
+        __m128i q[4] = {
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(sx, cycz), _mm_mul_ps(cx, sysz)), snorm)),
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cx, sycz), _mm_mul_ps(sx, cysz)), snorm)),
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(sx, sycz), _mm_mul_ps(cx, cysz)), snorm)),
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cx, cycz), _mm_mul_ps(sx, sysz)), snorm))
+        };
+
+        int32_t rotation[4][4];
+        for (int c = 0; c < 4; c++) {
+            _mm_storeu_si128((__m128i*)rotation[c], q[c]);
+        }
+
+        for (int j = 0; j < 4; j++) {
+            R3D_PackedInstance* dst = &particles->instances[i + j];
+            dst->position = (Vector3) { t->x[i + j], t->y[i + j], t->z[i + j] };
+            dst->color = particles->colors[i + j];
+            for (int c = 0; c < 4; c++) {
+                dst->rotation[c] = (short)rotation[c][j];
+            }
+            dst->scale[0] = r3d_cvt_fh(s->x[i + j]);
+            dst->scale[1] = r3d_cvt_fh(s->y[i + j]);
+            dst->scale[2] = r3d_cvt_fh(s->z[i + j]);
+            dst->scale[3] = 0;
+        }
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    const float32x4_t snorm = vdupq_n_f32(32767.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t sx, cx, sy, cy, sz, cz;
+        r3d_particle_sincos(vmulq_n_f32(vld1q_f32(r->x + i), 0.5f), &sx, &cx);
+        r3d_particle_sincos(vmulq_n_f32(vld1q_f32(r->y + i), 0.5f), &sy, &cy);
+        r3d_particle_sincos(vmulq_n_f32(vld1q_f32(r->z + i), 0.5f), &sz, &cz);
+
+        float32x4_t cycz = vmulq_f32(cy, cz), sysz = vmulq_f32(sy, sz);
+        float32x4_t sycz = vmulq_f32(sy, cz), cysz = vmulq_f32(cy, sz);
+
+        float32x4_t q[4] = {
+            vaddq_f32(vmulq_f32(sx, cycz), vmulq_f32(cx, sysz)),
+            vsubq_f32(vmulq_f32(cx, sycz), vmulq_f32(sx, cysz)),
+            vaddq_f32(vmulq_f32(sx, sycz), vmulq_f32(cx, cysz)),
+            vsubq_f32(vmulq_f32(cx, cycz), vmulq_f32(sx, sysz))
+        };
+
+        // Rounded with 'lrintf', ARMv7 has no conversion to nearest
+        float rotation[4][4];
+        for (int c = 0; c < 4; c++) {
+            vst1q_f32(rotation[c], vmulq_f32(q[c], snorm));
+        }
+
+        for (int j = 0; j < 4; j++) {
+            R3D_PackedInstance* dst = &particles->instances[i + j];
+            dst->position = (Vector3) { t->x[i + j], t->y[i + j], t->z[i + j] };
+            dst->color = particles->colors[i + j];
+            for (int c = 0; c < 4; c++) {
+                dst->rotation[c] = (short)lrintf(rotation[c][j]);
+            }
+            dst->scale[0] = r3d_cvt_fh(s->x[i + j]);
+            dst->scale[1] = r3d_cvt_fh(s->y[i + j]);
+            dst->scale[2] = r3d_cvt_fh(s->z[i + j]);
+            dst->scale[3] = 0;
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        r3d_particle_pack_instance(particles, i);
+    }
+}
+
+void r3d_particle_pack_instance(R3D_Particles* particles, int i)
+{
+    float hx = 0.5f * particles->rotation.x[i];
+    float hy = 0.5f * particles->rotation.y[i];
+    float hz = 0.5f * particles->rotation.z[i];
+
+    Quaternion rotation = r3d_instance_quat_from_half_angles(sinf(hx), cosf(hx), sinf(hy), cosf(hy), sinf(hz), cosf(hz));
+    Vector3 position = { particles->position.x[i], particles->position.y[i], particles->position.z[i] };
+    Vector3 scale = { particles->scale.x[i], particles->scale.y[i], particles->scale.z[i] };
+
+    r3d_instance_pack(&particles->instances[i], &position, &rotation, &scale, particles->colors[i]);
+}
+
+void r3d_particle_add(float* values, float x, int count)
+{
+    int i = 0;
+
+#if defined(R3D_HAS_AVX)
+    __m256 x8 = _mm256_set1_ps(x);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(values + i, _mm256_add_ps(_mm256_loadu_ps(values + i), x8));
+    }
+#endif
+
+#if defined(R3D_HAS_SSE)
+    __m128 x4 = _mm_set1_ps(x);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), x4));
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    float32x4_t x4 = vdupq_n_f32(x);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(values + i, vaddq_f32(vld1q_f32(values + i), x4));
+    }
+#endif
+
+    for (; i < count; i++) {
+        values[i] += x;
+    }
+}
+
+void r3d_particle_mul(float* dst, const float* base, const float* factors, int count)
+{
+    int i = 0;
+
+#if defined(R3D_HAS_AVX)
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(base + i), _mm256_loadu_ps(factors + i)));
+    }
+#endif
+
+#if defined(R3D_HAS_SSE)
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(base + i), _mm_loadu_ps(factors + i)));
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(base + i), vld1q_f32(factors + i)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] = base[i] * factors[i];
+    }
+}
+
+void r3d_particle_madd(float* dst, const float* src, float a, float b, int count)
+{
+    // The products are not fused, to match the rounding of the scalar path
+    int i = 0;
+
+#if defined(R3D_HAS_AVX)
+    __m256 a8 = _mm256_set1_ps(a);
+    __m256 b8 = _mm256_set1_ps(b);
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), a8), b8);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), v));
+    }
+#endif
+
+#if defined(R3D_HAS_SSE)
+    __m128 a4 = _mm_set1_ps(a);
+    __m128 b4 = _mm_set1_ps(b);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(src + i), a4), b4);
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), v));
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vmulq_n_f32(vmulq_n_f32(vld1q_f32(src + i), a), b);
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), v));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] += src[i] * a * b;
+    }
+}
+
+void r3d_particle_madd_range(float* dst, const float* src, float a, float b, int count, float* outMin, float* outMax)
+{
+    // Same operations as 'r3d_particle_madd', the bounds are gathered while the results are in registers
+    float lo = *outMin, hi = *outMax;
+    int i = 0;
+
+#if defined(R3D_HAS_AVX)
+    __m256 a8 = _mm256_set1_ps(a);
+    __m256 b8 = _mm256_set1_ps(b);
+    __m256 lo8 = _mm256_set1_ps(lo);
+    __m256 hi8 = _mm256_set1_ps(hi);
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), a8), b8);
+        v = _mm256_add_ps(_mm256_loadu_ps(dst + i), v);
+        _mm256_storeu_ps(dst + i, v);
+        lo8 = _mm256_min_ps(lo8, v);
+        hi8 = _mm256_max_ps(hi8, v);
+    }
+    float lanes[2][8];
+    _mm256_storeu_ps(lanes[0], lo8);
+    _mm256_storeu_ps(lanes[1], hi8);
+    for (int j = 0; j < 8; j++) {
+        if (lanes[0][j] < lo) lo = lanes[0][j];
+        if (lanes[1][j] > hi) hi = lanes[1][j];
+    }
+#endif
+
+#if defined(R3D_HAS_SSE)
+    __m128 a4 = _mm_set1_ps(a);
+    __m128 b4 = _mm_set1_ps(b);
+    __m128 lo4 = _mm_set1_ps(lo);
+    __m128 hi4 = _mm_set1_ps(hi);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(src + i), a4), b4);
+        v = _mm_add_ps(_mm_loadu_ps(dst + i), v);
+        _mm_storeu_ps(dst + i, v);
+        lo4 = _mm_min_ps(lo4, v);
+        hi4 = _mm_max_ps(hi4, v);
+    }
+    float lanes4[2][4];
+    _mm_storeu_ps(lanes4[0], lo4);
+    _mm_storeu_ps(lanes4[1], hi4);
+    for (int j = 0; j < 4; j++) {
+        if (lanes4[0][j] < lo) lo = lanes4[0][j];
+        if (lanes4[1][j] > hi) hi = lanes4[1][j];
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    float32x4_t lo4 = vdupq_n_f32(lo);
+    float32x4_t hi4 = vdupq_n_f32(hi);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vmulq_n_f32(vmulq_n_f32(vld1q_f32(src + i), a), b);
+        v = vaddq_f32(vld1q_f32(dst + i), v);
+        vst1q_f32(dst + i, v);
+        lo4 = vminq_f32(lo4, v);
+        hi4 = vmaxq_f32(hi4, v);
+    }
+    float lanes4[2][4];
+    vst1q_f32(lanes4[0], lo4);
+    vst1q_f32(lanes4[1], hi4);
+    for (int j = 0; j < 4; j++) {
+        if (lanes4[0][j] < lo) lo = lanes4[0][j];
+        if (lanes4[1][j] > hi) hi = lanes4[1][j];
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] += src[i] * a * b;
+        if (dst[i] < lo) lo = dst[i];
+        if (dst[i] > hi) hi = dst[i];
+    }
+
+    *outMin = lo;
+    *outMax = hi;
+}
+
+void r3d_particle_range(const float* values, int count, float* outMin, float* outMax)
+{
+    float lo = *outMin, hi = *outMax;
+    int i = 0;
+
+#if defined(R3D_HAS_SSE)
+    __m128 lo4 = _mm_set1_ps(lo);
+    __m128 hi4 = _mm_set1_ps(hi);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(values + i);
+        lo4 = _mm_min_ps(lo4, v);
+        hi4 = _mm_max_ps(hi4, v);
+    }
+    float lanes[2][4];
+    _mm_storeu_ps(lanes[0], lo4);
+    _mm_storeu_ps(lanes[1], hi4);
+    for (int j = 0; j < 4; j++) {
+        if (lanes[0][j] < lo) lo = lanes[0][j];
+        if (lanes[1][j] > hi) hi = lanes[1][j];
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    float32x4_t lo4 = vdupq_n_f32(lo);
+    float32x4_t hi4 = vdupq_n_f32(hi);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vld1q_f32(values + i);
+        lo4 = vminq_f32(lo4, v);
+        hi4 = vmaxq_f32(hi4, v);
+    }
+    float lanes[2][4];
+    vst1q_f32(lanes[0], lo4);
+    vst1q_f32(lanes[1], hi4);
+    for (int j = 0; j < 4; j++) {
+        if (lanes[0][j] < lo) lo = lanes[0][j];
+        if (lanes[1][j] > hi) hi = lanes[1][j];
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (values[i] < lo) lo = values[i];
+        if (values[i] > hi) hi = values[i];
+    }
+
+    *outMin = lo;
+    *outMax = hi;
+}
+
+void r3d_particle_progress(float* dst, const float* lifetime, float total, int count)
+{
+    int i = 0;
+
+#if defined(R3D_HAS_AVX)
+    __m256 one8 = _mm256_set1_ps(1.0f);
+    __m256 total8 = _mm256_set1_ps(total);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_sub_ps(one8, _mm256_div_ps(_mm256_loadu_ps(lifetime + i), total8)));
+    }
+#endif
+
+#if defined(R3D_HAS_SSE)
+    __m128 one4 = _mm_set1_ps(1.0f);
+    __m128 total4 = _mm_set1_ps(total);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_sub_ps(one4, _mm_div_ps(_mm_loadu_ps(lifetime + i), total4)));
+    }
+#elif defined(__aarch64__)
+    // Vector division is only available on AArch64
+    float32x4_t one4 = vdupq_n_f32(1.0f);
+    float32x4_t total4 = vdupq_n_f32(total);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vsubq_f32(one4, vdivq_f32(vld1q_f32(lifetime + i), total4)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] = 1.0f - (lifetime[i] / total);
+    }
+}
+
+void r3d_particle_sample_curve(float* dst, const float* lut, const float* progress, int count)
+{
+    int i = 0;
+
+#if defined(R3D_HAS_AVX2)
+    __m256 zero8 = _mm256_setzero_ps();
+    __m256 one8 = _mm256_set1_ps(1.0f);
+    __m256 res8 = _mm256_set1_ps((float)R3D_CURVE_LUT_RESOLUTION);
+    __m256 last8 = _mm256_set1_ps((float)(R3D_CURVE_LUT_RESOLUTION - 1));
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(progress + i), zero8), one8), res8);
+        __m256i index = _mm256_cvttps_epi32(_mm256_min_ps(x, last8));
+        __m256 f = _mm256_sub_ps(x, _mm256_cvtepi32_ps(index));
+        __m256 a = _mm256_i32gather_ps(lut, index, 4);
+        __m256 b = _mm256_i32gather_ps(lut + 1, index, 4);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(a, _mm256_mul_ps(f, _mm256_sub_ps(b, a))));
+    }
+#endif
+
+    // Without gathers the lookups are scalar, the rest of the evaluation stays vectorized
+#if defined(R3D_HAS_SSE2)
+    __m128 zero4 = _mm_setzero_ps();
+    __m128 one4 = _mm_set1_ps(1.0f);
+    __m128 res4 = _mm_set1_ps((float)R3D_CURVE_LUT_RESOLUTION);
+    __m128 last4 = _mm_set1_ps((float)(R3D_CURVE_LUT_RESOLUTION - 1));
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(progress + i), zero4), one4), res4);
+        __m128i index = _mm_cvttps_epi32(_mm_min_ps(x, last4));
+        __m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(index));
+        int32_t k[4];
+        _mm_storeu_si128((__m128i*)k, index);
+        __m128 a = _mm_setr_ps(lut[k[0]], lut[k[1]], lut[k[2]], lut[k[3]]);
+        __m128 b = _mm_setr_ps(lut[k[0] + 1], lut[k[1] + 1], lut[k[2] + 1], lut[k[3] + 1]);
+        _mm_storeu_ps(dst + i, _mm_add_ps(a, _mm_mul_ps(f, _mm_sub_ps(b, a))));
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    float32x4_t zero4 = vdupq_n_f32(0.0f);
+    float32x4_t one4 = vdupq_n_f32(1.0f);
+    float32x4_t last4 = vdupq_n_f32((float)(R3D_CURVE_LUT_RESOLUTION - 1));
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(progress + i), zero4), one4), (float)R3D_CURVE_LUT_RESOLUTION);
+        int32x4_t index = vcvtq_s32_f32(vminq_f32(x, last4));
+        float32x4_t f = vsubq_f32(x, vcvtq_f32_s32(index));
+        int32_t k[4];
+        vst1q_s32(k, index);
+        float a[4] = { lut[k[0]], lut[k[1]], lut[k[2]], lut[k[3]] };
+        float b[4] = { lut[k[0] + 1], lut[k[1] + 1], lut[k[2] + 1], lut[k[3] + 1] };
+        float32x4_t va = vld1q_f32(a);
+        vst1q_f32(dst + i, vaddq_f32(va, vmulq_f32(f, vsubq_f32(vld1q_f32(b), va))));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] = r3d_curve_sample_lut(lut, progress[i]);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_DETAILS_PARTICLE_H
+#define R3D_DETAILS_PARTICLE_H
+
+#include "r3d.h"
+
+/* === Functions === */
+
+/*
+ * Allocates the arrays of a particle storage in a single block, each float array
+ * starting on a 32-byte boundary relative to the block. Returns false on failure.
+ */
+bool r3d_particle_storage_create(R3D_Particles* particles, int capacity);
+
+/*
+ * Releases the block of a particle storage and clears its arrays.
+ */
+void r3d_particle_storage_destroy(R3D_Particles* particles);
+
+/*
+ * Copies every attribute of the particle at 'src' over the one at 'dst'.
+ */
+void r3d_particle_move(R3D_Particles* particles, int dst, int src);
+
+/*
+ * Removes the particles whose lifetime is over and returns the new count.
+ * Each dead particle is replaced by the last one, scanning backward, so that the
+ * resulting order is the same as the one of the scalar update it replaces.
+ */
+int r3d_particle_compact(R3D_Particles* particles, int count);
+
+/*
+ * Packs the instances of the first 'count' particles from their scale, rotation, position and color,
+ * or of the single particle 'i'. The rotation is converted to a quaternion from the half angles,
+ * the vectorized paths evaluating sine and cosine with polynomials, within a few ulps of the C library.
+ */
+void r3d_particle_build_instances(R3D_Particles* particles, int count);
+void r3d_particle_pack_instance(R3D_Particles* particles, int i);
+
+/*
+ * Vectorized kernels over 'count' floats, evaluated in the same order as their
+ * scalar expression so that every code path gives bit-identical results:
+ *   add:      values[i] += x
+ *   mul:      dst[i] = base[i] * factors[i]
+ *   madd:     dst[i] += src[i] * a * b
+ *   progress: dst[i] = 1 - lifetime[i] / total
+ * 'r3d_particle_madd_range' also extends [*outMin, *outMax] with the results,
+ * and 'r3d_particle_range' extends it with the values.
+ */
+void r3d_particle_add(float* values, float x, int count);
+void r3d_particle_mul(float* dst, const float* base, const float* factors, int count);
+void r3d_particle_madd(float* dst, const float* src, float a, float b, int count);
+void r3d_particle_madd_range(float* dst, const float* src, float a, float b, int count, float* outMin, float* outMax);
+void r3d_particle_progress(float* dst, const float* lifetime, float total, int count);
+void r3d_particle_range(const float* values, int count, float* outMin, float* outMax);
+
+/*
+ * Evaluates a baked curve for 'count' particles, giving the same results as 'r3d_curve_sample_lut'.
+ */
+void r3d_particle_sample_curve(float* dst, const float* lut, const float* progress, int count);
+
+#endif // R3D_DETAILS_PARTICLE_H
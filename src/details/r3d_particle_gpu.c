@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_particle_gpu.h"
+#include "./r3d_curve.h"
+
+#include "../r3d_state.h"
+
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <glad.h>
+
+#include <stdlib.h>
+#include <math.h>
+
+/* === Internal functions === */
+
+static void r3d_particle_gpu_clear_buffer(unsigned int buffer, size_t size)
+{
+    // Dead particles are recognized by their lifetime, all slots must start at zero
+    static const float zeros[4096] = { 0 };
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_DYNAMIC_COPY);
+
+    for (size_t offset = 0; offset < size; offset += sizeof(zeros)) {
+        size_t chunk = size - offset;
+        if (chunk > sizeof(zeros)) chunk = sizeof(zeros);
+        glBufferSubData(GL_ARRAY_BUFFER, offset, chunk, zeros);
+    }
+}
+
+static float r3d_particle_gpu_bake_curve(const R3D_InterpolationCurve* curve, float* table, int channel)
+{
+    if (curve == NULL) {
+        return 0.0f;
+    }
+
+    // Curves without a valid lookup table are sampled the same way it would be baked
+    const float* lut = r3d_curve_get_lut(curve);
+
+    for (int i = 0; i <= R3D_CURVE_LUT_RESOLUTION; i++) {
+        table[4 * i + channel] = (lut != NULL)
+            ? lut[i] : R3D_EvaluateCurve(*curve, (float)i / R3D_CURVE_LUT_RESOLUTION);
+    }
+
+    return 1.0f;
+}
+
+/* === Public functions === */
+
+R3D_ParticleGPU* r3d_particle_gpu_create(int capacity)
+{
+    if (capacity <= 0 || R3D.shader.raster.particles.id == 0) {
+        return NULL;
+    }
+
+    R3D_ParticleGPU* gpu = calloc(1, sizeof(R3D_ParticleGPU));
+    if (gpu == NULL) {
+        return NULL;
+    }
+
+    gpu->expiries = calloc(capacity, sizeof(double));
+    if (gpu->expiries == NULL) {
+        free(gpu);
+        return NULL;
+    }
+
+    gpu->capacity = capacity;
+    gpu->originTime = -1.0f;
+
+    glGenBuffers(2, gpu->buffers);
+    glGenVertexArrays(2, gpu->vaos);
+
+    for (int i = 0; i < 2; i++)
+    {
+        glBindVertexArray(gpu->vaos[i]);
+        r3d_particle_gpu_clear_buffer(gpu->buffers[i], (size_t)capacity * R3D_PARTICLE_GPU_STRIDE);
+
+        for (int attrib = 0; attrib < 11; attrib++) {
+            glEnableVertexAttribArray(attrib);
+            glVertexAttribPointer(
+                attrib, 4, GL_FLOAT, GL_FALSE, R3D_PARTICLE_GPU_STRIDE,
+                (void*)(attrib * 4 * sizeof(float))
+            );
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenTextures(1, &gpu->curveTexture);
+    glBindTexture(GL_TEXTURE_1D, gpu->curveTexture);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA32F, R3D_CURVE_LUT_RESOLUTION + 1, 0, GL_RGBA, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_1D, 0);
+
+    return gpu;
+}
+
+void r3d_particle_gpu_destroy(R3D_ParticleGPU* gpu)
+{
+    if (gpu == NULL) return;
+
+    glDeleteVertexArrays(2, gpu->vaos);
+    glDeleteBuffers(2, gpu->buffers);
+    glDeleteTextures(1, &gpu->curveTexture);
+
+    free(gpu->expiries);
+    free(gpu);
+}
+
+void r3d_particle_gpu_update(R3D_ParticleGPU* gpu, const R3D_ParticleSystem* system, float deltaTime)
+{
+    /* --- Release the slots of the particles known to be dead --- */
+
+    gpu->time += deltaTime;
+
+    // Expiries only follow the emission order while the lifetime is unchanged,
+    // stopping at the first slot still alive can only keep dead slots reserved
+    while (gpu->alive > 0 && gpu->expiries[gpu->tail] <= gpu->time) {
+        gpu->tail = (gpu->tail + 1) % gpu->capacity;
+        gpu->alive--;
+    }
+
+    /* --- Reserve the free slots following the alive ones, the other emissions are dropped --- */
+
+    int emitFirst = gpu->head;
+    int emitFree = gpu->capacity - gpu->alive;
+    int emitCount = (gpu->pending < emitFree) ? gpu->pending : emitFree;
+
+    // The emission update is not counted, which can only delay the release
+    double expiry = gpu->time + system->lifetime + fabsf(system->lifetimeVariance);
+
+    for (int i = 0; i < emitCount; i++) {
+        gpu->expiries[(emitFirst + i) % gpu->capacity] = expiry;
+    }
+
+    gpu->pending = 0;
+    gpu->alive += emitCount;
+    gpu->head = (gpu->head + emitCount) % gpu->capacity;
+    gpu->used = (gpu->used + emitCount < gpu->capacity) ? gpu->used + emitCount : gpu->capacity;
+
+    if (gpu->used == 0) {
+        return;
+    }
+
+    /* --- Send the parameters of the system --- */
+
+    // Make sure raylib is done with its own batch before changing the bindings
+    rlDrawRenderBatchActive();
+
+    r3d_shader_enable(raster.particles);
+
+    r3d_shader_set_float(raster.particles, uDeltaTime, deltaTime);
+    r3d_shader_set_vec3(raster.particles, uGravity, system->gravity);
+
+    r3d_shader_set_int(raster.particles, uCapacity, gpu->capacity);
+    r3d_shader_set_int(raster.particles, uEmitFirst, emitFirst);
+    r3d_shader_set_int(raster.particles, uEmitCount, emitCount);
+    r3d_shader_set_int(raster.particles, uSeed, (int)(system->seed ^ (gpu->updates++ * 0x9E3779B9u)));
+
+    r3d_shader_set_vec3(raster.particles, uPosition, system->position);
+    r3d_shader_set_vec3(raster.particles, uInitialScale, system->initialScale);
+    r3d_shader_set_float(raster.particles, uScaleVariance, system->scaleVariance);
+    r3d_shader_set_vec3(raster.particles, uInitialRotation, system->initialRotation);
+    r3d_shader_set_vec3(raster.particles, uRotationVariance, system->rotationVariance);
+    r3d_shader_set_vec3(raster.particles, uInitialVelocity, system->initialVelocity);
+    r3d_shader_set_vec3(raster.particles, uVelocityVariance, system->velocityVariance);
+    r3d_shader_set_vec3(raster.particles, uInitialAngularVelocity, system->initialAngularVelocity);
+    r3d_shader_set_vec3(raster.particles, uAngularVelocityVariance, system->angularVelocityVariance);
+    r3d_shader_set_float(raster.particles, uLifetime, system->lifetime);
+    r3d_shader_set_float(raster.particles, uLifetimeVariance, system->lifetimeVariance);
+    r3d_shader_set_float(raster.particles, uSpreadAngle, system->spreadAngle);
+
+    // Colors are kept in the 0-255 range to reproduce the integer variance of the CPU emission
+    r3d_shader_set_vec4(raster.particles, uInitialColor, (Vector4) {
+        system->initialColor.r, system->initialColor.g, system->initialColor.b, system->initialColor.a
+    });
+    r3d_shader_set_vec4(raster.particles, uColorVariance, (Vector4) {
+        system->colorVariance.r, system->colorVariance.g, system->colorVariance.b, system->colorVariance.a
+    });
+
+    /* --- Send the lookup tables of the curves, one per channel --- */
+
+    float table[4 * (R3D_CURVE_LUT_RESOLUTION + 1)] = { 0 };
+
+    Vector4 mask = {
+        r3d_particle_gpu_bake_curve(system->scaleOverLifetime, table, 0),
+        r3d_particle_gpu_bake_curve(system->speedOverLifetime, table, 1),
+        r3d_particle_gpu_bake_curve(system->opacityOverLifetime, table, 2),
+        r3d_particle_gpu_bake_curve(system->angularVelocityOverLifetime, table, 3)
+    };
+
+    glBindTexture(GL_TEXTURE_1D, gpu->curveTexture);
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, R3D_CURVE_LUT_RESOLUTION + 1, GL_RGBA, GL_FLOAT, table);
+
+    r3d_shader_set_vec4(raster.particles, uCurveMask, mask);
+    r3d_shader_bind_sampler1D(raster.particles, uTexCurves, gpu->curveTexture);
+
+    /* --- Simulate every used slot into the other buffer, nothing is rasterized --- */
+
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    glBindVertexArray(gpu->vaos[gpu->current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, gpu->buffers[1 - gpu->current]);
+
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, gpu->used);
+    glEndTransformFeedback();
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    r3d_shader_unbind_sampler1D(raster.particles, uTexCurves);
+    r3d_shader_disable();
+
+    gpu->current = 1 - gpu->current;
+}
+
+unsigned int r3d_particle_gpu_get_buffer(const R3D_ParticleGPU* gpu)
+{
+    return gpu->buffers[gpu->current];
+}
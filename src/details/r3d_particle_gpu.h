@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_PARTICLE_GPU_H
+#define R3D_DETAILS_PARTICLE_GPU_H
+
+#include "r3d.h"
+
+/* === Defines === */
+
+/*
+ * Size of the state of a particle in the simulation buffers, made of eleven vec4:
+ * the four rows of its transform in the memory layout of a 'Matrix', its color
+ * as normalized floats, then the data only read back by the simulation shader.
+ */
+#define R3D_PARTICLE_GPU_STRIDE         (11 * 4 * sizeof(float))
+#define R3D_PARTICLE_GPU_COLOR_OFFSET   (4 * 4 * sizeof(float))
+
+/* === Types === */
+
+/*
+ * Simulation state of a particle system updated on the GPU by transform feedback.
+ * Particles live in a ring of slots, the emitted ones taking the free slots following 'head',
+ * and dead particles keep their slot with a null transform so nothing has to be compacted.
+ * The CPU keeps the latest time each slot can die at, from the largest lifetime the parameters
+ * allow, so that emissions never reach a slot still alive on the GPU without any read back.
+ */
+struct R3D_ParticleGPU {
+    unsigned int buffers[2];    //< Ping-pong state buffers, 'capacity * R3D_PARTICLE_GPU_STRIDE' bytes each
+    unsigned int vaos[2];       //< Vertex arrays reading the state of 'buffers[i]' as attributes
+    unsigned int curveTexture;  //< RGBA32F lookup tables of the four curves, see 'R3D_CURVE_LUT_RESOLUTION'
+    int current;                //< Index of the buffer holding the latest state
+    int capacity;               //< Number of slots of the buffers
+    int used;                   //< Number of slots written at least once, the others are never drawn
+    int head;                   //< Slot of the next emission, following the last alive one
+    int tail;                   //< Slot of the oldest particle that may still be alive
+    int alive;                  //< Number of slots from 'tail' that may still be alive, never below the real count
+    double time;                //< Simulated time, the clock of 'expiries'
+    double* expiries;           //< Time after which each slot is known to be dead
+    int pending;                //< Emissions requested since the last update
+    unsigned int updates;       //< Number of updates, combined with the seed of the system for the random numbers
+    BoundingBox origins[2];     //< Positions of the emitter over the current and the previous lifetime window
+    float originTime;           //< Time spent in the current window, negative until the first update
+};
+
+/* === Functions === */
+
+/*
+ * Creates the simulation buffers of a GPU particle system, or destroys them (NULL is ignored).
+ * Returns NULL if the particle shader is not available or on allocation failure.
+ */
+R3D_ParticleGPU* r3d_particle_gpu_create(int capacity);
+void r3d_particle_gpu_destroy(R3D_ParticleGPU* gpu);
+
+/*
+ * Emits the pending particles then advances the whole simulation by 'deltaTime',
+ * with the parameters and curves of the particle system.
+ */
+void r3d_particle_gpu_update(R3D_ParticleGPU* gpu, const R3D_ParticleSystem* system, float deltaTime);
+
+/*
+ * Returns the buffer holding the latest state, to be read as instance attributes.
+ */
+unsigned int r3d_particle_gpu_get_buffer(const R3D_ParticleGPU* gpu);
+
+#endif // R3D_DETAILS_PARTICLE_GPU_H
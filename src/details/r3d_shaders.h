@@ -25,13 +25,13 @@
 /* === Shader defines === */
 
 #define R3D_SHADER_FORWARD_NUM_LIGHTS 8
-#define R3D_SHADER_MAX_BONES 128
 
 /* === Uniform types === */
 
 typedef struct { int slot1D; int loc; } r3d_shader_uniform_sampler1D_t;
 typedef struct { int slot2D; int loc; } r3d_shader_uniform_sampler2D_t;
 typedef struct { int slotCube; int loc; } r3d_shader_uniform_samplerCube_t;
+typedef struct { int slotBuffer; int loc; } r3d_shader_uniform_samplerBuffer_t;
 
 typedef struct { int val; int loc; } r3d_shader_uniform_int_t;
 typedef struct { float val; int loc; } r3d_shader_uniform_float_t;
@@ -87,7 +87,8 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
     r3d_shader_uniform_mat4_t uMatNormal;
     r3d_shader_uniform_mat4_t uMatModel;
@@ -105,17 +106,31 @@ typedef struct {
     r3d_shader_uniform_float_t uMetalness;
     r3d_shader_uniform_vec3_t uAlbedoColor;
     r3d_shader_uniform_vec3_t uEmissionColor;
+    r3d_shader_uniform_float_t uDitherFade;     //< Only in the dithered variant
 } r3d_shader_raster_geometry_t;
 
+typedef enum {
+    R3D_SHADER_GEOMETRY_BASE,           //< Never discards, opaque geometry keeps early depth testing
+    R3D_SHADER_GEOMETRY_DITHER,         //< Discards the dithered pixels of draws fading with an impostor or another level of detail
+    R3D_SHADER_GEOMETRY_VARIANT_COUNT
+} r3d_shader_geometry_variant_t;
+
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uUseInstanceAnimation;
+    r3d_shader_uniform_int_t uPackedInstances;
+    r3d_shader_uniform_samplerBuffer_t uTexVertexAnim;
+    r3d_shader_uniform_int_t uVertexAnimBase;
+    r3d_shader_uniform_int_t uUseVertexAnimation;
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatVP;
     r3d_shader_uniform_vec2_t uTexCoordOffset;
     r3d_shader_uniform_vec2_t uTexCoordScale;
+    r3d_shader_uniform_vec2_t uSpriteFrameCount;
     r3d_shader_uniform_int_t uBillboardMode;
     r3d_shader_uniform_sampler2D_t uTexAlbedo;
     r3d_shader_uniform_sampler2D_t uTexNormal;
@@ -130,6 +145,39 @@ typedef struct {
     r3d_shader_uniform_vec3_t uEmissionColor;
 } r3d_shader_raster_geometry_inst_t;
 
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_mat4_t uMatNormal;
+    r3d_shader_uniform_mat4_t uMatModel;
+    r3d_shader_uniform_mat4_t uMatVP;
+    r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_vec3_t uCenter;
+    r3d_shader_uniform_float_t uRadius;
+    r3d_shader_uniform_int_t uFrames;
+    r3d_shader_uniform_sampler2D_t uTexAlbedo;
+    r3d_shader_uniform_sampler2D_t uTexEmission;
+    r3d_shader_uniform_sampler2D_t uTexNormal;
+    r3d_shader_uniform_sampler2D_t uTexORM;
+    r3d_shader_uniform_sampler2D_t uTexDepth;
+    r3d_shader_uniform_float_t uDitherFade;
+} r3d_shader_raster_impostor_t;
+
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_mat4_t uMatModel;
+    r3d_shader_uniform_mat4_t uMatVP;
+    r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_vec3_t uCenter;
+    r3d_shader_uniform_float_t uRadius;
+    r3d_shader_uniform_int_t uFrames;
+    r3d_shader_uniform_sampler2D_t uTexAlbedo;
+    r3d_shader_uniform_sampler2D_t uTexEmission;
+    r3d_shader_uniform_sampler2D_t uTexNormal;
+    r3d_shader_uniform_sampler2D_t uTexORM;
+    r3d_shader_uniform_sampler2D_t uTexDepth;
+    r3d_shader_uniform_float_t uDitherFade;
+} r3d_shader_raster_impostor_inst_t;
+
 typedef struct {
     unsigned int id;
     r3d_shader_uniform_mat4_t uMatProj;
@@ -146,7 +194,52 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
+} r3d_shader_raster_skinning_t;
+
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_float_t uDeltaTime;
+    r3d_shader_uniform_vec3_t uGravity;
+    r3d_shader_uniform_int_t uCapacity;
+    r3d_shader_uniform_int_t uEmitFirst;
+    r3d_shader_uniform_int_t uEmitCount;
+    r3d_shader_uniform_int_t uSeed;
+    r3d_shader_uniform_vec3_t uPosition;
+    r3d_shader_uniform_vec3_t uInitialScale;
+    r3d_shader_uniform_float_t uScaleVariance;
+    r3d_shader_uniform_vec3_t uInitialRotation;
+    r3d_shader_uniform_vec3_t uRotationVariance;
+    r3d_shader_uniform_vec4_t uInitialColor;
+    r3d_shader_uniform_vec4_t uColorVariance;
+    r3d_shader_uniform_vec3_t uInitialVelocity;
+    r3d_shader_uniform_vec3_t uVelocityVariance;
+    r3d_shader_uniform_vec3_t uInitialAngularVelocity;
+    r3d_shader_uniform_vec3_t uAngularVelocityVariance;
+    r3d_shader_uniform_float_t uLifetime;
+    r3d_shader_uniform_float_t uLifetimeVariance;
+    r3d_shader_uniform_float_t uSpreadAngle;
+    r3d_shader_uniform_sampler1D_t uTexCurves;
+    r3d_shader_uniform_vec4_t uCurveMask;
+} r3d_shader_raster_particles_t;
+
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_mat4_t uMatModel;
+    r3d_shader_uniform_mat4_t uMatVP;
+    r3d_shader_uniform_vec3_t uAabbMin;
+    r3d_shader_uniform_vec3_t uAabbMax;
+    r3d_shader_uniform_int_t uBillboard;
+    r3d_shader_uniform_int_t uInstanceCount;
+    r3d_shader_uniform_int_t uColorOffset;
+    r3d_shader_uniform_int_t uParamsOffset;
+} r3d_shader_raster_cull_t;
+
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
     r3d_shader_uniform_mat4_t uMatMVP;
     r3d_shader_uniform_float_t uAlpha;
@@ -156,12 +249,21 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uUseInstanceAnimation;
+    r3d_shader_uniform_int_t uPackedInstances;
+    r3d_shader_uniform_samplerBuffer_t uTexVertexAnim;
+    r3d_shader_uniform_int_t uVertexAnimBase;
+    r3d_shader_uniform_int_t uUseVertexAnimation;
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatVP;
     r3d_shader_uniform_int_t uBillboardMode;
+    r3d_shader_uniform_vec2_t uTexCoordOffset;
+    r3d_shader_uniform_vec2_t uTexCoordScale;
+    r3d_shader_uniform_vec2_t uSpriteFrameCount;
     r3d_shader_uniform_float_t uAlpha;
     r3d_shader_uniform_sampler2D_t uTexAlbedo;
     r3d_shader_uniform_float_t uAlphaCutoff;
@@ -169,7 +271,8 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
     r3d_shader_uniform_vec3_t uViewPosition;
     r3d_shader_uniform_mat4_t uMatModel;
@@ -182,14 +285,23 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uUseInstanceAnimation;
+    r3d_shader_uniform_int_t uPackedInstances;
+    r3d_shader_uniform_samplerBuffer_t uTexVertexAnim;
+    r3d_shader_uniform_int_t uVertexAnimBase;
+    r3d_shader_uniform_int_t uUseVertexAnimation;
     r3d_shader_uniform_vec3_t uViewPosition;
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatVP;
     r3d_shader_uniform_float_t uFar;
     r3d_shader_uniform_int_t uBillboardMode;
+    r3d_shader_uniform_vec2_t uTexCoordOffset;
+    r3d_shader_uniform_vec2_t uTexCoordScale;
+    r3d_shader_uniform_vec2_t uSpriteFrameCount;
     r3d_shader_uniform_float_t uAlpha;
     r3d_shader_uniform_sampler2D_t uTexAlbedo;
     r3d_shader_uniform_float_t uAlphaCutoff;
@@ -218,7 +330,8 @@ typedef struct {
         r3d_shader_uniform_int_t enabled;
         r3d_shader_uniform_int_t shadow;
     } uLights[R3D_SHADER_FORWARD_NUM_LIGHTS];
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
     r3d_shader_uniform_mat4_t uMatLightVP[R3D_SHADER_FORWARD_NUM_LIGHTS];
     r3d_shader_uniform_mat4_t uMatNormal;
@@ -273,14 +386,21 @@ typedef struct {
         r3d_shader_uniform_int_t enabled;
         r3d_shader_uniform_int_t shadow;
     } uLights[R3D_SHADER_FORWARD_NUM_LIGHTS];
-    r3d_shader_uniform_mat4_t uBoneMatrices;
+    r3d_shader_uniform_samplerBuffer_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uUseInstanceAnimation;
+    r3d_shader_uniform_int_t uPackedInstances;
+    r3d_shader_uniform_samplerBuffer_t uTexVertexAnim;
+    r3d_shader_uniform_int_t uVertexAnimBase;
+    r3d_shader_uniform_int_t uUseVertexAnimation;
     r3d_shader_uniform_mat4_t uMatLightVP[R3D_SHADER_FORWARD_NUM_LIGHTS];
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatVP;
     r3d_shader_uniform_vec2_t uTexCoordOffset;
     r3d_shader_uniform_vec2_t uTexCoordScale;
+    r3d_shader_uniform_vec2_t uSpriteFrameCount;
     r3d_shader_uniform_int_t uBillboardMode;
     r3d_shader_uniform_sampler2D_t uTexAlbedo;
     r3d_shader_uniform_sampler2D_t uTexEmission;
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_simplify.h"
+
+#include <raylib.h>
+#include <raymath.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* === Internal types === */
+
+// Symmetric 4x4 matrix of a plane quadric (a2, ab, ac, ad, b2, bc, bd, c2, cd, d2)
+typedef struct {
+    double m[10];
+} r3d_quadric_t;
+
+typedef struct {
+    double cost;
+    unsigned int from;      //< Vertex moved by the collapse
+    unsigned int to;        //< Vertex the first one is merged into
+} r3d_collapse_t;
+
+/* === Internal functions === */
+
+static uint32_t r3d_simplify_hash(const void* data, size_t size)
+{
+    // FNV-1a
+    const unsigned char* bytes = data;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Builds a remap table where equal keys (first 'keySize' bytes of each vertex) share the first vertex index
+static void r3d_simplify_build_remap(unsigned int* remap, const R3D_Vertex* vertices, int vertexCount, size_t keySize)
+{
+    uint32_t tableSize = 1;
+    while (tableSize < (uint32_t)vertexCount * 2) tableSize <<= 1;
+
+    int* table = RL_MALLOC(tableSize * sizeof(int));
+    if (table == NULL) {
+        for (int i = 0; i < vertexCount; i++) remap[i] = i;
+        return;
+    }
+
+    memset(table, -1, tableSize * sizeof(int));
+
+    for (int i = 0; i < vertexCount; i++) {
+        uint32_t slot = r3d_simplify_hash(&vertices[i], keySize) & (tableSize - 1);
+        for (;;) {
+            if (table[slot] < 0) {
+                table[slot] = i;
+                remap[i] = i;
+                break;
+            }
+            if (memcmp(&vertices[table[slot]], &vertices[i], keySize) == 0) {
+                remap[i] = table[slot];
+                break;
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+    }
+
+    RL_FREE(table);
+}
+
+static void r3d_quadric_add_plane(r3d_quadric_t* q, Vector3 p0, Vector3 p1, Vector3 p2)
+{
+    Vector3 n = Vector3CrossProduct(Vector3Subtract(p1, p0), Vector3Subtract(p2, p0));
+    float len = Vector3Length(n);
+    if (len < 1e-12f) return;
+
+    double a = n.x / len, b = n.y / len, c = n.z / len;
+    double d = -(a * p0.x + b * p0.y + c * p0.z);
+
+    q->m[0] += a * a; q->m[1] += a * b; q->m[2] += a * c; q->m[3] += a * d;
+    q->m[4] += b * b; q->m[5] += b * c; q->m[6] += b * d;
+    q->m[7] += c * c; q->m[8] += c * d;
+    q->m[9] += d * d;
+}
+
+static double r3d_quadric_error(const r3d_quadric_t* q, Vector3 p)
+{
+    double x = p.x, y = p.y, z = p.z;
+    const double* m = q->m;
+
+    double e = m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x
+             + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y
+             + m[7] * z * z + 2 * m[8] * z
+             + m[9];
+
+    return (e > 0.0) ? e : 0.0;
+}
+
+static int r3d_collapse_compare(const void* a, const void* b)
+{
+    double ca = ((const r3d_collapse_t*)a)->cost;
+    double cb = ((const r3d_collapse_t*)b)->cost;
+    return (ca < cb) ? -1 : (ca > cb);
+}
+
+static int r3d_edge_compare(const void* a, const void* b)
+{
+    uint64_t ea = *(const uint64_t*)a;
+    uint64_t eb = *(const uint64_t*)b;
+    return (ea < eb) ? -1 : (ea > eb);
+}
+
+// Checks that moving 'from' onto 'to' does not flip any of the triangles around 'from'
+static bool r3d_simplify_collapse_is_valid(
+    const unsigned int* indices, const unsigned int* pos,
+    const R3D_Vertex* vertices, const int* adjOffsets, const int* adjTris,
+    unsigned int from, unsigned int to)
+{
+    unsigned int pf = pos[from], pt = pos[to];
+    Vector3 target = vertices[to].position;
+
+    for (int i = adjOffsets[pf]; i < adjOffsets[pf + 1]; i++)
+    {
+        const unsigned int* tri = indices + 3 * adjTris[i];
+        unsigned int c0 = pos[tri[0]], c1 = pos[tri[1]], c2 = pos[tri[2]];
+
+        // Triangles sharing the collapsed edge disappear
+        if (c0 == pt || c1 == pt || c2 == pt) continue;
+
+        Vector3 p[3] = { vertices[tri[0]].position, vertices[tri[1]].position, vertices[tri[2]].position };
+        Vector3 nOld = Vector3CrossProduct(Vector3Subtract(p[1], p[0]), Vector3Subtract(p[2], p[0]));
+
+        if (c0 == pf) p[0] = target;
+        if (c1 == pf) p[1] = target;
+        if (c2 == pf) p[2] = target;
+
+        Vector3 nNew = Vector3CrossProduct(Vector3Subtract(p[1], p[0]), Vector3Subtract(p[2], p[0]));
+
+        if (Vector3DotProduct(nOld, nNew) <= 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* === Public functions === */
+
+int r3d_simplify(unsigned int* dst, const unsigned int* indices, int indexCount,
+                 const R3D_Vertex* vertices, int vertexCount,
+                 int targetIndexCount, float* outError)
+{
+    *outError = 0.0f;
+
+    if (indices != dst) {
+        memcpy(dst, indices, indexCount * sizeof(unsigned int));
+    }
+
+    indexCount -= indexCount % 3;
+    if (indexCount <= targetIndexCount || vertexCount == 0) {
+        return indexCount;
+    }
+
+    unsigned int* wedge = RL_MALLOC(vertexCount * sizeof(unsigned int));
+    unsigned int* pos = RL_MALLOC(vertexCount * sizeof(unsigned int));
+    unsigned int* collapse = RL_MALLOC(vertexCount * sizeof(unsigned int));
+    unsigned int* posWedge = RL_MALLOC(vertexCount * sizeof(unsigned int));
+    bool* locked = RL_CALLOC(vertexCount, sizeof(bool));
+    bool* touched = RL_MALLOC(vertexCount * sizeof(bool));
+    int* adjOffsets = RL_MALLOC((vertexCount + 1) * sizeof(int));
+    int* adjTris = RL_MALLOC(indexCount * sizeof(int));
+    r3d_quadric_t* quadrics = RL_CALLOC(vertexCount, sizeof(r3d_quadric_t));
+    r3d_collapse_t* candidates = RL_MALLOC(indexCount * 2 * sizeof(r3d_collapse_t));
+    uint64_t* edges = RL_MALLOC(indexCount * sizeof(uint64_t));
+
+    if (!wedge || !pos || !collapse || !posWedge || !locked || !touched ||
+        !adjOffsets || !adjTris || !quadrics || !candidates || !edges) {
+        goto cleanup;
+    }
+
+    /* --- Identical vertices are merged, vertices sharing a position are grouped --- */
+
+    r3d_simplify_build_remap(wedge, vertices, vertexCount, sizeof(R3D_Vertex));
+    r3d_simplify_build_remap(pos, vertices, vertexCount, sizeof(Vector3));
+
+    for (int i = 0; i < indexCount; i++) {
+        dst[i] = wedge[dst[i]];
+    }
+
+    // A position used by several distinct vertices lies on an attribute seam
+    for (int i = 0; i < vertexCount; i++) posWedge[i] = UINT32_MAX;
+
+    for (int i = 0; i < indexCount; i++) {
+        unsigned int v = dst[i], p = pos[v];
+        if (posWedge[p] == UINT32_MAX) posWedge[p] = v;
+        else if (posWedge[p] != v) locked[p] = true;
+    }
+
+    /* --- Open borders are locked --- */
+
+    for (int i = 0; i < indexCount; i += 3) {
+        for (int e = 0; e < 3; e++) {
+            uint64_t a = pos[dst[i + e]], b = pos[dst[i + (e + 1) % 3]];
+            edges[i + e] = (a < b) ? (a << 32 | b) : (b << 32 | a);
+        }
+    }
+
+    qsort(edges, indexCount, sizeof(uint64_t), r3d_edge_compare);
+
+    for (int i = 0; i < indexCount; ) {
+        int j = i + 1;
+        while (j < indexCount && edges[j] == edges[i]) j++;
+        if (j - i == 1) {
+            locked[edges[i] >> 32] = true;
+            locked[edges[i] & 0xFFFFFFFF] = true;
+        }
+        i = j;
+    }
+
+    /* --- Plane quadrics accumulated per position --- */
+
+    for (int i = 0; i < indexCount; i += 3) {
+        Vector3 p0 = vertices[dst[i + 0]].position;
+        Vector3 p1 = vertices[dst[i + 1]].position;
+        Vector3 p2 = vertices[dst[i + 2]].position;
+        r3d_quadric_t* q[3] = { &quadrics[pos[dst[i]]], &quadrics[pos[dst[i + 1]]], &quadrics[pos[dst[i + 2]]] };
+        for (int k = 0; k < 3; k++) r3d_quadric_add_plane(q[k], p0, p1, p2);
+    }
+
+    /* --- Collapse the cheapest edges pass after pass --- */
+
+    double maxCost = 0.0;
+
+    while (indexCount > targetIndexCount)
+    {
+        int triCount = indexCount / 3;
+
+        // Gather candidate collapses along every edge, in both directions
+        int candidateCount = 0;
+
+        for (int i = 0; i < indexCount; i += 3) {
+            for (int e = 0; e < 3; e++) {
+                unsigned int v0 = dst[i + e], v1 = dst[i + (e + 1) % 3];
+                unsigned int p0 = pos[v0], p1 = pos[v1];
+                if (p0 == p1) continue;
+
+                r3d_quadric_t q = quadrics[p0];
+                for (int k = 0; k < 10; k++) q.m[k] += quadrics[p1].m[k];
+
+                if (!locked[p0]) {
+                    candidates[candidateCount++] = (r3d_collapse_t) {
+                        r3d_quadric_error(&q, vertices[v1].position), v0, v1
+                    };
+                }
+                if (!locked[p1]) {
+                    candidates[candidateCount++] = (r3d_collapse_t) {
+                        r3d_quadric_error(&q, vertices[v0].position), v1, v0
+                    };
+                }
+            }
+        }
+
+        if (candidateCount == 0) break;
+
+        qsort(candidates, candidateCount, sizeof(r3d_collapse_t), r3d_collapse_compare);
+
+        // Triangles adjacent to each position
+        memset(adjOffsets, 0, (vertexCount + 1) * sizeof(int));
+        for (int i = 0; i < indexCount; i++) adjOffsets[pos[dst[i]] + 1]++;
+        for (int i = 0; i < vertexCount; i++) adjOffsets[i + 1] += adjOffsets[i];
+        for (int i = 0; i < indexCount; i++) adjTris[adjOffsets[pos[dst[i]]]++] = i / 3;
+        for (int i = vertexCount; i > 0; i--) adjOffsets[i] = adjOffsets[i - 1];
+        adjOffsets[0] = 0;
+
+        // Each collapse removes about two triangles
+        int collapseBudget = (triCount - targetIndexCount / 3 + 1) / 2;
+        int collapseCount = 0;
+
+        for (int i = 0; i < vertexCount; i++) {
+            collapse[i] = i;
+            touched[i] = false;
+        }
+
+        for (int i = 0; i < candidateCount && collapseCount < collapseBudget; i++)
+        {
+            const r3d_collapse_t* c = &candidates[i];
+            unsigned int pf = pos[c->from], pt = pos[c->to];
+
+            if (touched[pf] || touched[pt]) continue;
+
+            if (!r3d_simplify_collapse_is_valid(dst, pos, vertices, adjOffsets, adjTris, c->from, c->to)) {
+                continue;
+            }
+
+            // The neighborhood of the collapse is left untouched until the next pass
+            for (int k = adjOffsets[pf]; k < adjOffsets[pf + 1]; k++) {
+                const unsigned int* tri = dst + 3 * adjTris[k];
+                touched[pos[tri[0]]] = touched[pos[tri[1]]] = touched[pos[tri[2]]] = true;
+            }
+            touched[pt] = true;
+
+            collapse[c->from] = c->to;
+            for (int k = 0; k < 10; k++) quadrics[pt].m[k] += quadrics[pf].m[k];
+
+            if (c->cost > maxCost) maxCost = c->cost;
+            collapseCount++;
+        }
+
+        if (collapseCount == 0) break;
+
+        // Apply the collapses and remove the degenerate triangles
+        int writeCount = 0;
+
+        for (int i = 0; i < indexCount; i += 3) {
+            unsigned int a = collapse[dst[i + 0]];
+            unsigned int b = collapse[dst[i + 1]];
+            unsigned int c = collapse[dst[i + 2]];
+
+            if (pos[a] == pos[b] || pos[b] == pos[c] || pos[a] == pos[c]) continue;
+
+            dst[writeCount++] = a;
+            dst[writeCount++] = b;
+            dst[writeCount++] = c;
+        }
+
+        // Collapsed vertices now belong to the position of their target
+        for (int i = 0; i < vertexCount; i++) {
+            if (collapse[i] != (unsigned int)i) pos[i] = pos[collapse[i]];
+        }
+
+        indexCount = writeCount;
+    }
+
+    *outError = (float)sqrt(maxCost);
+
+cleanup:
+    RL_FREE(wedge);
+    RL_FREE(pos);
+    RL_FREE(collapse);
+    RL_FREE(posWedge);
+    RL_FREE(locked);
+    RL_FREE(touched);
+    RL_FREE(adjOffsets);
+    RL_FREE(adjTris);
+    RL_FREE(quadrics);
+    RL_FREE(candidates);
+    RL_FREE(edges);
+
+    return indexCount;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_SIMPLIFY_H
+#define R3D_DETAILS_SIMPLIFY_H
+
+#include "r3d.h"
+
+/* === Functions === */
+
+/*
+ * Simplifies an indexed triangle list with quadric error metric edge collapses.
+ * Vertices are only collapsed onto existing ones, so the result indexes the same vertex array.
+ * Vertices on open borders or attribute seams are never moved.
+ *
+ * 'dst' must be able to hold 'indexCount' indices, it can alias 'indices'.
+ * Returns the new index count and writes the geometric error (in mesh units) to 'outError'.
+ */
+int r3d_simplify(unsigned int* dst, const unsigned int* indices, int indexCount,
+                 const R3D_Vertex* vertices, int vertexCount,
+                 int targetIndexCount, float* outError);
+
+#endif // R3D_DETAILS_SIMPLIFY_H
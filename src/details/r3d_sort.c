@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_sort.h"
+
+#include "./r3d_simd.h"
+
+#include <raylib.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/* === Internal data === */
+
+// Scratch keys and indices reused between sorts, two of each for the radix passes, grown on demand
+static uint32_t* r3d_sort_scratch = NULL;
+static size_t r3d_sort_scratch_capacity = 0;
+
+/* === Internal functions === */
+
+static uint32_t* r3d_sort_get_scratch(size_t count)
+{
+    if (count > r3d_sort_scratch_capacity) {
+        uint32_t* scratch = RL_REALLOC(r3d_sort_scratch, 4 * count * sizeof(uint32_t));
+        if (scratch == NULL) return NULL;
+        r3d_sort_scratch = scratch;
+        r3d_sort_scratch_capacity = count;
+    }
+    return r3d_sort_scratch;
+}
+
+// Maps the bits of a float to an unsigned integer with the same ordering
+static inline uint32_t r3d_sort_float_key(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits ^ ((uint32_t)((int32_t)bits >> 31) | 0x80000000u);
+}
+
+// Writes the view depth of each position as a sortable key, farthest first
+// 'x', 'y' and 'z' point to the components of the first position, 'stride' separates two positions
+static void r3d_sort_compute_keys(uint32_t* keys, const float* x, const float* y, const float* z, size_t stride, size_t count, const Matrix* matModelView)
+{
+    // View space z of a point, which is negative in front of the camera
+    const float a = matModelView->m2, b = matModelView->m6;
+    const float c = matModelView->m10, d = matModelView->m14;
+
+#define R3D_SORT_AT(p, i) (*(const float*)((const unsigned char*)(p) + (i) * stride))
+
+    size_t i = 0;
+
+#if defined(R3D_HAS_SSE2)
+    const __m128 va = _mm_set1_ps(a), vb = _mm_set1_ps(b);
+    const __m128 vc = _mm_set1_ps(c), vd = _mm_set1_ps(d);
+    const __m128i sign = _mm_set1_epi32((int)0x80000000u);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_setr_ps(R3D_SORT_AT(x, i), R3D_SORT_AT(x, i + 1), R3D_SORT_AT(x, i + 2), R3D_SORT_AT(x, i + 3));
+        __m128 py = _mm_setr_ps(R3D_SORT_AT(y, i), R3D_SORT_AT(y, i + 1), R3D_SORT_AT(y, i + 2), R3D_SORT_AT(y, i + 3));
+        __m128 pz = _mm_setr_ps(R3D_SORT_AT(z, i), R3D_SORT_AT(z, i + 1), R3D_SORT_AT(z, i + 2), R3D_SORT_AT(z, i + 3));
+
+        __m128 depth = _mm_add_ps(_mm_add_ps(_mm_mul_ps(va, px), _mm_mul_ps(vb, py)), _mm_add_ps(_mm_mul_ps(vc, pz), vd));
+
+        __m128i bits = _mm_castps_si128(depth);
+        __m128i mask = _mm_or_si128(_mm_srai_epi32(bits, 31), sign);
+        _mm_storeu_si128((__m128i*)(keys + i), _mm_xor_si128(bits, mask));
+    }
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    const float32x4_t va = vdupq_n_f32(a), vb = vdupq_n_f32(b);
+    const float32x4_t vc = vdupq_n_f32(c), vd = vdupq_n_f32(d);
+    const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+
+    for (; i + 4 <= count; i += 4) {
+        const float xs[4] = { R3D_SORT_AT(x, i), R3D_SORT_AT(x, i + 1), R3D_SORT_AT(x, i + 2), R3D_SORT_AT(x, i + 3) };
+        const float ys[4] = { R3D_SORT_AT(y, i), R3D_SORT_AT(y, i + 1), R3D_SORT_AT(y, i + 2), R3D_SORT_AT(y, i + 3) };
+        const float zs[4] = { R3D_SORT_AT(z, i), R3D_SORT_AT(z, i + 1), R3D_SORT_AT(z, i + 2), R3D_SORT_AT(z, i + 3) };
+
+        float32x4_t depth = vaddq_f32(
+            vaddq_f32(vmulq_f32(va, vld1q_f32(xs)), vmulq_f32(vb, vld1q_f32(ys))),
+            vaddq_f32(vmulq_f32(vc, vld1q_f32(zs)), vd)
+        );
+
+        uint32x4_t bits = vreinterpretq_u32_f32(depth);
+        uint32x4_t mask = vorrq_u32(vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(bits), 31)), sign);
+        vst1q_u32(keys + i, veorq_u32(bits, mask));
+    }
+#endif
+
+    for (; i < count; i++) {
+        keys[i] = r3d_sort_float_key((a * R3D_SORT_AT(x, i) + b * R3D_SORT_AT(y, i)) + (c * R3D_SORT_AT(z, i) + d));
+    }
+
+#undef R3D_SORT_AT
+}
+
+// Stable LSD radix sort on bytes, passes where every key shares the same byte are skipped
+static uint32_t* r3d_sort_radix(uint32_t* keys, uint32_t* tmpKeys, uint32_t* indices, uint32_t* tmpIndices, size_t count)
+{
+    if (count < 2) {
+        return indices;
+    }
+
+    uint32_t histograms[4][256] = { 0 };
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t key = keys[i];
+        histograms[0][key & 0xFF]++;
+        histograms[1][(key >> 8) & 0xFF]++;
+        histograms[2][(key >> 16) & 0xFF]++;
+        histograms[3][key >> 24]++;
+    }
+
+    for (int pass = 0; pass < 4; pass++)
+    {
+        uint32_t* histogram = histograms[pass];
+        int shift = 8 * pass;
+
+        if (histogram[(keys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        // Convert the counts into the first output position of each byte
+        uint32_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            uint32_t n = histogram[b];
+            histogram[b] = offset;
+            offset += n;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            uint32_t dst = histogram[(keys[i] >> shift) & 0xFF]++;
+            tmpKeys[dst] = keys[i];
+            tmpIndices[dst] = indices[i];
+        }
+
+        uint32_t* swap;
+        swap = keys; keys = tmpKeys; tmpKeys = swap;
+        swap = indices; indices = tmpIndices; tmpIndices = swap;
+    }
+
+    return indices;
+}
+
+// Sorts positions spread in memory, see 'r3d_sort_compute_keys'
+static const uint32_t* r3d_sort_back_to_front(const float* x, const float* y, const float* z, size_t stride, size_t count, const Matrix* matModelView)
+{
+    uint32_t* scratch = r3d_sort_get_scratch(count);
+    if (scratch == NULL) return NULL;
+
+    uint32_t* keys = scratch;
+    uint32_t* tmpKeys = scratch + count;
+    uint32_t* indices = scratch + 2 * count;
+    uint32_t* tmpIndices = scratch + 3 * count;
+
+    r3d_sort_compute_keys(keys, x, y, z, stride, count, matModelView);
+
+    for (size_t i = 0; i < count; i++) {
+        indices[i] = (uint32_t)i;
+    }
+
+    return r3d_sort_radix(keys, tmpKeys, indices, tmpIndices, count);
+}
+
+/* === Public functions === */
+
+const uint32_t* r3d_sort_instances_back_to_front(const Matrix* transforms, size_t stride, size_t count, const Matrix* matModelView)
+{
+    if (stride == 0) stride = sizeof(Matrix);
+    return r3d_sort_back_to_front(&transforms->m12, &transforms->m13, &transforms->m14, stride, count, matModelView);
+}
+
+const uint32_t* r3d_sort_packed_back_to_front(const R3D_PackedInstance* instances, size_t count, const Matrix* matModelView)
+{
+    const Vector3* position = &instances->position;
+    return r3d_sort_back_to_front(&position->x, &position->y, &position->z, sizeof(R3D_PackedInstance), count, matModelView);
+}
+
+void r3d_sort_unload(void)
+{
+    RL_FREE(r3d_sort_scratch);
+    r3d_sort_scratch = NULL;
+    r3d_sort_scratch_capacity = 0;
+}
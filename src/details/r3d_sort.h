@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_SORT_H
+#define R3D_DETAILS_SORT_H
+
+#include "r3d.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* === Functions === */
+
+/*
+ * Orders the instances of an instanced draw from the farthest to the nearest,
+ * by the view depth of their origin through 'matModelView' (model then view transform).
+ * 'stride' is the distance in bytes between two transforms, zero meaning tightly packed.
+ * Returns the indices of the instances in drawing order, valid until the next call,
+ * or NULL on allocation failure. The transforms themselves are left untouched.
+ */
+const uint32_t* r3d_sort_instances_back_to_front(const Matrix* transforms, size_t stride, size_t count, const Matrix* matModelView);
+
+/*
+ * Same as 'r3d_sort_instances_back_to_front', by the position of packed instances.
+ */
+const uint32_t* r3d_sort_packed_back_to_front(const R3D_PackedInstance* instances, size_t count, const Matrix* matModelView);
+
+/*
+ * Releases the scratch memory used for sorting.
+ */
+void r3d_sort_unload(void);
+
+#endif // R3D_DETAILS_SORT_H
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_sprite_batch.h"
+
+#include "./r3d_drawcall.h"
+#include "./r3d_instance.h"
+#include "../r3d_state.h"
+
+#include <raylib.h>
+#include <raymath.h>
+
+#include <float.h>
+#include <math.h>
+
+/* === Internal data === */
+
+// Batch of the last sprite pushed, consecutive sprites usually share their material
+static size_t r3d_sprite_batch_last = 0;
+
+/* === Internal functions === */
+
+static bool r3d_sprite_batch_match(const r3d_sprite_batch_t* batch, const R3D_Sprite* sprite)
+{
+    const R3D_Material* a = &batch->material;
+    const R3D_Material* b = &sprite->material;
+
+    // Compared field by field, the padding of the structure is not reliable
+    // The UV transform is ignored, it is sent with each sprite along with its frame,
+    // so sprite sheets and regions of an atlas sharing a texture share a batch
+    return a->albedo.texture.id == b->albedo.texture.id
+        && ColorIsEqual(a->albedo.color, b->albedo.color)
+        && a->emission.texture.id == b->emission.texture.id
+        && ColorIsEqual(a->emission.color, b->emission.color)
+        && a->emission.energy == b->emission.energy
+        && a->normal.texture.id == b->normal.texture.id
+        && a->normal.scale == b->normal.scale
+        && a->orm.texture.id == b->orm.texture.id
+        && a->orm.occlusion == b->orm.occlusion
+        && a->orm.roughness == b->orm.roughness
+        && a->orm.metalness == b->orm.metalness
+        && a->blendMode == b->blendMode
+        && a->cullMode == b->cullMode
+        && a->shadowCastMode == b->shadowCastMode
+        && a->billboardMode == b->billboardMode
+        && a->alphaCutoff == b->alphaCutoff;
+}
+
+static r3d_sprite_batch_t* r3d_sprite_batch_get(const R3D_Sprite* sprite)
+{
+    r3d_array_t* batches = &R3D.container.aSpriteBatch;
+    r3d_sprite_batch_t* data = batches->data;
+
+    if (r3d_sprite_batch_last < batches->count && r3d_sprite_batch_match(&data[r3d_sprite_batch_last], sprite)) {
+        return &data[r3d_sprite_batch_last];
+    }
+
+    for (size_t i = 0; i < batches->count; i++) {
+        if (r3d_sprite_batch_match(&data[i], sprite)) {
+            r3d_sprite_batch_last = i;
+            return &data[i];
+        }
+    }
+
+    /* --- First sprite of this material, create its batch --- */
+
+    r3d_sprite_batch_t batch = { 0 };
+
+    batch.material = sprite->material;
+    batch.material.uvOffset = (Vector2) { 0.0f, 0.0f };
+    batch.material.uvScale = (Vector2) { 1.0f, 1.0f };
+    batch.instances = r3d_array_create(64, sizeof(R3D_PackedInstance));
+    batch.params = r3d_array_create(64, sizeof(R3D_InstanceParams));
+    batch.aabb.min = (Vector3) { +FLT_MAX, +FLT_MAX, +FLT_MAX };
+    batch.aabb.max = (Vector3) { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    if (!r3d_array_is_valid(&batch.instances) || !r3d_array_is_valid(&batch.params) || r3d_array_push_back(batches, &batch) < 0) {
+        r3d_array_destroy(&batch.instances);
+        r3d_array_destroy(&batch.params);
+        return NULL;
+    }
+
+    r3d_sprite_batch_last = batches->count - 1;
+
+    return (r3d_sprite_batch_t*)batches->data + r3d_sprite_batch_last;
+}
+
+/* === Public functions === */
+
+void r3d_sprite_batch_push(const R3D_Sprite* sprite, Vector3 position, Vector2 size, Vector3 rotationAxis, float rotationAngle, const R3D_InstanceParams* params)
+{
+    r3d_sprite_batch_t* batch = r3d_sprite_batch_get(sprite);
+    if (batch == NULL) return;
+
+    // Same transform as an unbatched sprite, the billboarding is applied by the shader
+    Vector3 scale = { fabsf(size.x) * 0.5f, -fabsf(size.y) * 0.5f, 1.0f };
+
+    // Facing the camera discards the rotation entirely
+    Quaternion rotation = QuaternionIdentity();
+    if (sprite->material.billboardMode != R3D_BILLBOARD_FRONT && Vector3LengthSqr(rotationAxis) > 1e-12f) {
+        rotation = QuaternionFromAxisAngle(rotationAxis, rotationAngle);
+    }
+
+    R3D_PackedInstance instance;
+    r3d_instance_pack(&instance, &position, &rotation, &scale, WHITE);
+
+    if (r3d_array_push_back(&batch->instances, &instance) < 0) {
+        return;
+    }
+    if (r3d_array_push_back(&batch->params, params) < 0) {
+        batch->instances.count--;
+        return;
+    }
+
+    // The quad covers the size of the sprite whatever its orientation
+    float radius = 0.5f * sqrtf(size.x * size.x + size.y * size.y);
+    batch->aabb.min = Vector3Min(batch->aabb.min, Vector3AddValue(position, -radius));
+    batch->aabb.max = Vector3Max(batch->aabb.max, Vector3AddValue(position, radius));
+}
+
+void r3d_sprite_batch_flush(void)
+{
+    const r3d_sprite_batch_t* batches = R3D.container.aSpriteBatch.data;
+
+    for (size_t i = 0; i < R3D.container.aSpriteBatch.count; i++)
+    {
+        const r3d_sprite_batch_t* batch = &batches[i];
+        if (batch->instances.count == 0) continue;
+
+        r3d_drawcall_t drawCall = { 0 };
+
+        drawCall.transform = MatrixIdentity();
+        drawCall.material = batch->material;
+        drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_SPRITE;
+        drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+        drawCall.instanced.allAabb = batch->aabb;
+        drawCall.instanced.packed = batch->instances.data;
+        drawCall.instanced.params = batch->params.data;
+        drawCall.instanced.count = batch->instances.count;
+
+        r3d_array_t* arr = &R3D.container.aDrawDeferredInst;
+
+        if (batch->material.blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+            drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+            arr = &R3D.container.aDrawForwardInst;
+        }
+
+        r3d_array_push_back(arr, &drawCall);
+    }
+}
+
+void r3d_sprite_batch_reset(void)
+{
+    r3d_array_t* batches = &R3D.container.aSpriteBatch;
+    r3d_sprite_batch_t* data = batches->data;
+
+    size_t kept = 0;
+
+    for (size_t i = 0; i < batches->count; i++)
+    {
+        r3d_sprite_batch_t* batch = &data[i];
+
+        if (batch->instances.count == 0) {
+            r3d_array_destroy(&batch->instances);
+            r3d_array_destroy(&batch->params);
+            continue;
+        }
+
+        r3d_array_clear(&batch->instances);
+        r3d_array_clear(&batch->params);
+        batch->aabb.min = (Vector3) { +FLT_MAX, +FLT_MAX, +FLT_MAX };
+        batch->aabb.max = (Vector3) { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        data[kept++] = *batch;
+    }
+
+    batches->count = kept;
+    r3d_sprite_batch_last = 0;
+}
+
+void r3d_sprite_batch_unload(void)
+{
+    r3d_sprite_batch_t* data = R3D.container.aSpriteBatch.data;
+
+    for (size_t i = 0; i < R3D.container.aSpriteBatch.count; i++) {
+        r3d_array_destroy(&data[i].instances);
+        r3d_array_destroy(&data[i].params);
+    }
+
+    r3d_array_destroy(&R3D.container.aSpriteBatch);
+    r3d_sprite_batch_last = 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_SPRITE_BATCH_H
+#define R3D_DETAILS_SPRITE_BATCH_H
+
+#include "r3d.h"
+
+#include "./containers/r3d_array.h"
+
+/* === Types === */
+
+/*
+ * Sprites of one material accumulated during a frame, drawn as a single instanced draw call.
+ * Billboarding is left to the vertex shader, the texture coordinates of each frame are sent as instance parameters.
+ * Batches are kept between frames to reuse their storage, a batch left empty for a whole frame is released.
+ */
+typedef struct {
+    R3D_Material material;  //< Material shared by the sprites, except the UV transform sent with each sprite
+    r3d_array_t instances;  //< Packed transforms of the sprites, as 'R3D_PackedInstance'
+    r3d_array_t params;     //< Texture coordinates of the frames of the sprites, as 'R3D_InstanceParams'
+    BoundingBox aabb;       //< Bounds of the sprites in any orientation
+} r3d_sprite_batch_t;
+
+/* === Functions === */
+
+/*
+ * Adds a sprite to the batch of its material, creating the batch if needed.
+ * 'params' holds the UV transform of the current frame of the sprite, composed with the one of its material.
+ * The sprite is dropped on allocation failure.
+ */
+void r3d_sprite_batch_push(const R3D_Sprite* sprite, Vector3 position, Vector2 size, Vector3 rotationAxis, float rotationAngle, const R3D_InstanceParams* params);
+
+/*
+ * Pushes one instanced draw call per non-empty batch, to be called once all sprites of the frame are drawn.
+ */
+void r3d_sprite_batch_flush(void);
+
+/*
+ * Empties the batches for a new frame, releasing those which received no sprite during the last one.
+ */
+void r3d_sprite_batch_reset(void);
+
+/*
+ * Releases all batches.
+ */
+void r3d_sprite_batch_unload(void);
+
+#endif // R3D_DETAILS_SPRITE_BATCH_H
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "r3d.h"
+
+#include "./r3d_state.h"
+
+#include <raylib.h>
+#include <glad.h>
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* === Defines === */
+
+#define R3D_ATLAS_MIN_SIZE 64
+
+/* === Internal types === */
+
+typedef struct {
+    int x, y;           //< Left end and height of the segment
+    int width;          //< Width of the segment
+} r3d_atlas_node_t;
+
+typedef struct {
+    int image;          //< Index of the packed image
+    int width, height;  //< Size of the cell, gutter and alignment included
+    int x, y;           //< Position of the cell in the atlas, -1 if it did not fit
+} r3d_atlas_cell_t;
+
+/* === Internal functions === */
+
+static bool r3d_atlas_is_default_map(Texture2D texture)
+{
+    return texture.id == 0 || r3d_texture_is_default(texture.id);
+}
+
+// True if the UV transform maps the unit square past the texture, such tiled textures
+// would repeat the whole atlas instead of their region
+static bool r3d_atlas_is_tiled(const R3D_Material* material)
+{
+    float u0 = material->uvOffset.x, u1 = u0 + material->uvScale.x;
+    float v0 = material->uvOffset.y, v1 = v0 + material->uvScale.y;
+    const float eps = 1e-4f;
+
+    return fminf(u0, u1) < -eps || fmaxf(u0, u1) > 1.0f + eps
+        || fminf(v0, v1) < -eps || fmaxf(v0, v1) > 1.0f + eps;
+}
+
+static int r3d_atlas_cell_compare(const void* a, const void* b)
+{
+    const r3d_atlas_cell_t* cellA = a;
+    const r3d_atlas_cell_t* cellB = b;
+
+    // Tallest cells first then widest, the skyline stays flatter
+    if (cellA->height != cellB->height) return cellB->height - cellA->height;
+    if (cellA->width != cellB->width) return cellB->width - cellA->width;
+
+    return cellA->image - cellB->image;
+}
+
+// Returns the lowest height at which a cell can rest on the skyline from 'node', or -1 if it does not fit
+static int r3d_atlas_skyline_fit(const r3d_atlas_node_t* nodes, int node, int width, int height, int atlasWidth, int atlasHeight)
+{
+    if (nodes[node].x + width > atlasWidth) {
+        return -1;
+    }
+
+    // The segments cover the whole width, so the cell always ends over one of them
+    int y = 0;
+    for (int remaining = width; remaining > 0; remaining -= nodes[node++].width) {
+        if (nodes[node].y > y) y = nodes[node].y;
+    }
+
+    return (y + height <= atlasHeight) ? y : -1;
+}
+
+// Places the cells with the bottom-left rule of a skyline, 'nodes' must hold 'count + 1' segments
+// Returns the number of cells placed, the others keep a negative position
+static int r3d_atlas_skyline_pack(r3d_atlas_cell_t* cells, int count, r3d_atlas_node_t* nodes, int atlasWidth, int atlasHeight)
+{
+    int nodeCount = 1;
+    nodes[0] = (r3d_atlas_node_t) { 0, 0, atlasWidth };
+
+    int packed = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        r3d_atlas_cell_t* cell = &cells[i];
+        cell->x = cell->y = -1;
+
+        /* --- Find the segment giving the lowest top, then the narrowest one --- */
+
+        int bestNode = -1;
+        int bestTop = INT_MAX;
+        int bestWidth = INT_MAX;
+
+        for (int j = 0; j < nodeCount; j++) {
+            int y = r3d_atlas_skyline_fit(nodes, j, cell->width, cell->height, atlasWidth, atlasHeight);
+            if (y < 0) continue;
+            int top = y + cell->height;
+            if (top < bestTop || (top == bestTop && nodes[j].width < bestWidth)) {
+                bestNode = j;
+                bestTop = top;
+                bestWidth = nodes[j].width;
+            }
+        }
+
+        if (bestNode < 0) {
+            continue;
+        }
+
+        cell->x = nodes[bestNode].x;
+        cell->y = bestTop - cell->height;
+        packed++;
+
+        /* --- Raise the skyline over the cell --- */
+
+        memmove(&nodes[bestNode + 1], &nodes[bestNode], (nodeCount - bestNode) * sizeof(r3d_atlas_node_t));
+        nodes[bestNode] = (r3d_atlas_node_t) { cell->x, bestTop, cell->width };
+        nodeCount++;
+
+        // Shrink or remove the segments now covered by the cell
+        int right = cell->x + cell->width;
+        for (int j = bestNode + 1; j < nodeCount && nodes[j].x < right; ) {
+            int overlap = right - nodes[j].x;
+            if (overlap < nodes[j].width) {
+                nodes[j].x += overlap;
+                nodes[j].width -= overlap;
+                break;
+            }
+            memmove(&nodes[j], &nodes[j + 1], (nodeCount - j - 1) * sizeof(r3d_atlas_node_t));
+            nodeCount--;
+        }
+
+        // Merge the neighboring segments at the same height
+        for (int j = 0; j + 1 < nodeCount; ) {
+            if (nodes[j].y == nodes[j + 1].y) {
+                nodes[j].width += nodes[j + 1].width;
+                memmove(&nodes[j + 1], &nodes[j + 2], (nodeCount - j - 2) * sizeof(r3d_atlas_node_t));
+                nodeCount--;
+            }
+            else {
+                j++;
+            }
+        }
+    }
+
+    return packed;
+}
+
+// Copies an image in the atlas and repeats its border pixels over 'padding' pixels around it
+static void r3d_atlas_blit(unsigned char* atlas, int atlasWidth, int atlasHeight, const Image* image, int x, int y, int padding)
+{
+    const unsigned char* src = image->data;
+
+    int x0 = (x - padding > 0) ? x - padding : 0;
+    int y0 = (y - padding > 0) ? y - padding : 0;
+    int x1 = (x + image->width + padding < atlasWidth) ? x + image->width + padding : atlasWidth;
+    int y1 = (y + image->height + padding < atlasHeight) ? y + image->height + padding : atlasHeight;
+
+    for (int dy = y0; dy < y1; dy++) {
+        int sy = dy - y;
+        sy = (sy < 0) ? 0 : (sy >= image->height) ? image->height - 1 : sy;
+        for (int dx = x0; dx < x1; dx++) {
+            int sx = dx - x;
+            sx = (sx < 0) ? 0 : (sx >= image->width) ? image->width - 1 : sx;
+            memcpy(&atlas[4 * ((size_t)dy * atlasWidth + dx)], &src[4 * ((size_t)sy * image->width + sx)], 4);
+        }
+    }
+}
+
+/* === Public functions === */
+
+R3D_TextureAtlas R3D_LoadTextureAtlas(const Image* images, int count, int maxSize, int padding)
+{
+    R3D_TextureAtlas atlas = { 0 };
+
+    if (images == NULL || count <= 0 || maxSize <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot load a texture atlas without images");
+        return atlas;
+    }
+
+    if (padding < 0) {
+        padding = 0;
+    }
+
+    /* --- Filtering a mipmap level reads two texels past a region, cells are aligned to the coarsest level kept --- */
+
+    int mipLevels = 0;
+    while ((4 << mipLevels) <= padding) {
+        mipLevels++;
+    }
+
+    int alignment = 1 << mipLevels;
+
+    /* --- Build the cells of the images, padding included --- */
+
+    r3d_atlas_cell_t* cells = RL_MALLOC(count * sizeof(r3d_atlas_cell_t));
+    r3d_atlas_node_t* nodes = RL_MALLOC((count + 1) * sizeof(r3d_atlas_node_t));
+    atlas.regions = RL_CALLOC(count, sizeof(Rectangle));
+
+    if (cells == NULL || nodes == NULL || atlas.regions == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for texture atlas");
+        RL_FREE(atlas.regions);
+        RL_FREE(nodes);
+        RL_FREE(cells);
+        return (R3D_TextureAtlas) { 0 };
+    }
+
+    atlas.regionCount = count;
+
+    int cellCount = 0;
+    long long area = 0;
+
+    for (int i = 0; i < count; i++) {
+        const Image* image = &images[i];
+        if (image->data == NULL || image->width <= 0 || image->height <= 0 || image->format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) {
+            TraceLog(LOG_WARNING, "R3D: Image %d cannot be packed in the texture atlas (empty or compressed)", i);
+            continue;
+        }
+        r3d_atlas_cell_t* cell = &cells[cellCount++];
+        cell->image = i;
+        cell->width = (image->width + 2 * padding + alignment - 1) & ~(alignment - 1);
+        cell->height = (image->height + 2 * padding + alignment - 1) & ~(alignment - 1);
+        area += (long long)cell->width * cell->height;
+    }
+
+    qsort(cells, cellCount, sizeof(r3d_atlas_cell_t), r3d_atlas_cell_compare);
+
+    /* --- Pack in the smallest power-of-two atlas, growing one side at a time --- */
+
+    int width = (maxSize < R3D_ATLAS_MIN_SIZE) ? maxSize : R3D_ATLAS_MIN_SIZE;
+    while ((long long)width * width < area && width < maxSize) {
+        width = (2 * width < maxSize) ? 2 * width : maxSize;
+    }
+
+    int height = width;
+    int packed = 0;
+
+    for (;;) {
+        packed = r3d_atlas_skyline_pack(cells, cellCount, nodes, width, height);
+        if (packed == cellCount || (width == maxSize && height == maxSize)) {
+            break;
+        }
+        if (width <= height && width < maxSize) {
+            width = (2 * width < maxSize) ? 2 * width : maxSize;
+        }
+        else {
+            height = (2 * height < maxSize) ? 2 * height : maxSize;
+        }
+    }
+
+    RL_FREE(nodes);
+
+    if (packed < cellCount) {
+        TraceLog(LOG_WARNING, "R3D: %d images do not fit in a %dx%d texture atlas", cellCount - packed, maxSize, maxSize);
+    }
+
+    /* --- Copy the images in their cells --- */
+
+    unsigned char* pixels = RL_CALLOC((size_t)width * height, 4);
+    if (pixels == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for texture atlas");
+        RL_FREE(atlas.regions);
+        RL_FREE(cells);
+        return (R3D_TextureAtlas) { 0 };
+    }
+
+    for (int i = 0; i < cellCount; i++) {
+        const r3d_atlas_cell_t* cell = &cells[i];
+        if (cell->x < 0) continue;
+
+        Image image = ImageCopy(images[cell->image]);
+        if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        }
+
+        if (image.data != NULL && image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+            int x = cell->x + padding;
+            int y = cell->y + padding;
+            r3d_atlas_blit(pixels, width, height, &image, x, y, padding);
+            atlas.regions[cell->image] = (Rectangle) { (float)x, (float)y, (float)image.width, (float)image.height };
+        }
+
+        UnloadImage(image);
+    }
+
+    RL_FREE(cells);
+
+    /* --- Upload the atlas, its mipmaps stop before the gutters vanish --- */
+
+    Image image = {
+        .data = pixels,
+        .width = width,
+        .height = height,
+        .mipmaps = 1,
+        .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+    };
+
+    atlas.texture = LoadTextureFromImage(image);
+    RL_FREE(pixels);
+
+    if (atlas.texture.id == 0) {
+        TraceLog(LOG_ERROR, "R3D: Unable to upload texture atlas");
+        RL_FREE(atlas.regions);
+        return (R3D_TextureAtlas) { 0 };
+    }
+
+    if (R3D.state.loading.textureFilter > TEXTURE_FILTER_BILINEAR && mipLevels > 0) {
+        GenTextureMipmaps(&atlas.texture);
+        glBindTexture(GL_TEXTURE_2D, atlas.texture.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipLevels);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    SetTextureFilter(atlas.texture, R3D.state.loading.textureFilter);
+    SetTextureWrap(atlas.texture, TEXTURE_WRAP_CLAMP);
+
+    TraceLog(LOG_INFO, "R3D: Texture atlas of %dx%d loaded with %d images", width, height, packed);
+
+    return atlas;
+}
+
+R3D_TextureAtlas R3D_LoadMaterialAtlas(R3D_Material* materials, int count, int maxSize, int padding)
+{
+    if (materials == NULL || count <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot load a material atlas without materials");
+        return (R3D_TextureAtlas) { 0 };
+    }
+
+    /* --- Read back each distinct albedo texture once --- */
+
+    int* materialImages = RL_MALLOC(count * sizeof(int));
+    unsigned int* textureIds = RL_MALLOC(count * sizeof(unsigned int));
+    Image* images = RL_CALLOC(count, sizeof(Image));
+
+    if (materialImages == NULL || textureIds == NULL || images == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for material atlas");
+        RL_FREE(images);
+        RL_FREE(textureIds);
+        RL_FREE(materialImages);
+        return (R3D_TextureAtlas) { 0 };
+    }
+
+    int imageCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        const R3D_Material* material = &materials[i];
+        Texture2D texture = material->albedo.texture;
+        materialImages[i] = -1;
+
+        // The other maps share the texture coordinates of the albedo, they would be read out of place
+        if (r3d_atlas_is_default_map(texture) || !r3d_atlas_is_default_map(material->emission.texture)
+            || !r3d_atlas_is_default_map(material->normal.texture) || !r3d_atlas_is_default_map(material->orm.texture)) {
+            continue;
+        }
+
+        if (r3d_atlas_is_tiled(material)) {
+            continue;
+        }
+
+        int image = 0;
+        while (image < imageCount && textureIds[image] != texture.id) {
+            image++;
+        }
+
+        if (image == imageCount) {
+            images[imageCount] = LoadImageFromTexture(texture);
+            textureIds[imageCount++] = texture.id;
+        }
+
+        materialImages[i] = image;
+    }
+
+    /* --- Pack the images and point the materials to their region --- */
+
+    R3D_TextureAtlas atlas = { 0 };
+
+    if (imageCount > 0) {
+        atlas = R3D_LoadTextureAtlas(images, imageCount, maxSize, padding);
+    }
+    else {
+        TraceLog(LOG_WARNING, "R3D: No albedo texture to pack in the material atlas");
+    }
+
+    for (int i = 0; i < imageCount; i++) {
+        UnloadImage(images[i]);
+    }
+
+    if (atlas.texture.id != 0) {
+        for (int i = 0; i < count; i++) {
+            if (materialImages[i] >= 0) {
+                R3D_SetMaterialAtlasRegion(&materials[i], &atlas, materialImages[i]);
+            }
+        }
+    }
+
+    RL_FREE(images);
+    RL_FREE(textureIds);
+    RL_FREE(materialImages);
+
+    return atlas;
+}
+
+void R3D_UnloadTextureAtlas(const R3D_TextureAtlas* atlas)
+{
+    UnloadTexture(atlas->texture);
+    RL_FREE(atlas->regions);
+}
+
+bool R3D_SetMaterialAtlasRegion(R3D_Material* material, const R3D_TextureAtlas* atlas, int region)
+{
+    if (material == NULL || atlas == NULL || region < 0 || region >= atlas->regionCount) {
+        return false;
+    }
+
+    if (r3d_atlas_is_tiled(material)) {
+        TraceLog(LOG_WARNING, "R3D: Cannot point a tiled material to an atlas region");
+        return false;
+    }
+
+    Rectangle rect = atlas->regions[region];
+    if (rect.width <= 0.0f || rect.height <= 0.0f) {
+        return false;
+    }
+
+    Vector2 offset = { rect.x / atlas->texture.width, rect.y / atlas->texture.height };
+    Vector2 scale = { rect.width / atlas->texture.width, rect.height / atlas->texture.height };
+
+    // The UV transform of the material now applies within the region
+    material->albedo.texture = atlas->texture;
+    material->uvOffset.x = offset.x + material->uvOffset.x * scale.x;
+    material->uvOffset.y = offset.y + material->uvOffset.y * scale.y;
+    material->uvScale.x *= scale.x;
+    material->uvScale.y *= scale.y;
+
+    return true;
+}
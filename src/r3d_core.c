@@ -34,6 +34,13 @@
 #include "./details/r3d_drawcall.h"
 #include "./details/r3d_billboard.h"
 #include "./details/r3d_primitives.h"
+#include "./details/r3d_anim.h"
+#include "./details/r3d_sort.h"
+#include "./details/r3d_cull_gpu.h"
+#include "./details/r3d_sprite_batch.h"
+#include "./details/r3d_instance.h"
+#include "./details/r3d_particle_gpu.h"
+#include "./details/misc/r3d_half.h"
 #include "./details/containers/r3d_array.h"
 #include "./details/containers/r3d_registry.h"
 #include "./details/profiling/r3d_prof_min.h"
@@ -43,6 +50,18 @@
 static bool r3d_has_deferred_calls(void);
 static bool r3d_has_forward_calls(void);
 
+static float r3d_get_screen_size(Vector3 center, float radius);
+static int r3d_select_mesh_lod(const R3D_Mesh* mesh, const Matrix* transform, float* fade);
+static void r3d_push_mesh_drawcall(r3d_drawcall_t* drawCall, r3d_array_t* arr);
+static void r3d_push_model_drawcalls(const R3D_Model* model, Matrix transform, float ditherFade);
+static void r3d_select_animation_lod(const R3D_Model* model, const Matrix* transform, int* interval, int* level);
+static const R3D_ModelAnimation* r3d_push_bone_palette(const R3D_Model* model, const Matrix* transform, int* boneOffset);
+static BoundingBox r3d_get_instances_aabb(const BoundingBox* aabb, const Matrix* instanceTransforms, int instanceCount);
+static r3d_instance_anim_t* r3d_push_instance_anims(int instanceCount, size_t* animOffset);
+static void r3d_set_instance_anim(r3d_instance_anim_t* anim, float frame, int firstFrame, int frameCount, int frameSize);
+static void r3d_push_animated_instanced_drawcalls(const R3D_Model* model, const Matrix* instanceTransforms, const Color* instanceColors, int instanceCount,
+                                                  const R3D_AnimationTexture* animTexture, const R3D_VertexAnimation* vertexAnim, size_t animOffset);
+
 static void r3d_sprite_get_uv_scale_offset(Vector2* uvScale, Vector2* uvOffset, const R3D_Sprite* sprite, float sgnX, float sgnY);
 
 static void r3d_stencil_enable_geometry_write(void);
@@ -55,7 +74,9 @@ static void r3d_stencil_disable(void);
 static void r3d_prepare_process_lights_and_batch(void);
 static void r3d_prepare_cull_drawcalls(void);
 static void r3d_prepare_sort_drawcalls(void);
-static void r3d_prepare_anim_drawcalls(void);
+static void r3d_prepare_upload_bone_palette(void);
+static void r3d_prepare_preskin_drawcalls(void);
+static void r3d_prepare_upload_culled_instances(void);
 
 static void r3d_clear_gbuffer(bool bindFramebuffer, bool clearColor, bool clearDepth, bool clearStencil);
 
@@ -98,11 +119,24 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
     R3D.container.aDrawDeferred = r3d_array_create(128, sizeof(r3d_drawcall_t));
     R3D.container.aDrawForwardInst = r3d_array_create(8, sizeof(r3d_drawcall_t));
     R3D.container.aDrawDeferredInst = r3d_array_create(8, sizeof(r3d_drawcall_t));
+    R3D.container.aDrawImpostor = r3d_array_create(32, sizeof(r3d_drawcall_t));
+    R3D.container.aDrawImpostorInst = r3d_array_create(8, sizeof(r3d_drawcall_t));
 
     // Load lights registry
     R3D.container.rLights = r3d_registry_create(8, sizeof(r3d_light_t));
     R3D.container.aLightBatch = r3d_array_create(8, sizeof(r3d_light_batched_t));
 
+    // Load skinning palette
+    R3D.container.aBonePalette = r3d_array_create(256, sizeof(Matrix));
+    R3D.container.aInstanceAnim = r3d_array_create(256, sizeof(r3d_instance_anim_t));
+
+    // Load sprite batches
+    R3D.container.aSpriteBatch = r3d_array_create(8, sizeof(r3d_sprite_batch_t));
+
+    glGenBuffers(1, &R3D.skinning.paletteBuffer);
+    glGenTextures(1, &R3D.skinning.paletteTexture);
+    glGenBuffers(1, &R3D.skinning.vertexBuffer);
+
     // Environment data
     R3D.env.backgroundColor = (Vector3) { 0.2f, 0.2f, 0.2f };
     R3D.env.ambientColor = (Vector3) { 0.2f, 0.2f, 0.2f };
@@ -161,6 +195,21 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
     // Init default loading parameters
     R3D.state.loading.aiProps = aiCreatePropertyStore();
     R3D.state.loading.textureFilter = TEXTURE_FILTER_TRILINEAR;
+    R3D.state.loading.mergeMeshes = false;
+    R3D.state.loading.buildMeshlets = false;
+    R3D.state.loading.lodCount = 0;
+    R3D.state.loading.animTolerance = 0.0005f;
+
+    // Init default level of detail parameters
+    R3D.state.lod.threshold = 1.0f;
+    R3D.state.lod.fadeRange = 0.0f;
+    R3D.state.lod.shadowBias = 1;
+
+    R3D.state.animLod.fullRatePixels = 0.0f;
+    R3D.state.animLod.maxInterval = 4;
+    R3D.state.animLod.reducedPixels = 0.0f;
+    R3D.state.animLod.reducedLevels = 0;
+    R3D.state.animLod.tick = 0;
 
     // Load primitive shapes
     glGenVertexArrays(1, &R3D.primitive.dummyVAO);
@@ -201,11 +250,24 @@ void R3D_Close(void)
     r3d_array_destroy(&R3D.container.aDrawDeferred);
     r3d_array_destroy(&R3D.container.aDrawForwardInst);
     r3d_array_destroy(&R3D.container.aDrawDeferredInst);
+    r3d_array_destroy(&R3D.container.aDrawImpostor);
+    r3d_array_destroy(&R3D.container.aDrawImpostorInst);
 
     r3d_registry_destroy(&R3D.container.rLights);
     r3d_array_destroy(&R3D.container.aLightBatch);
 
+    r3d_array_destroy(&R3D.container.aBonePalette);
+    r3d_array_destroy(&R3D.container.aInstanceAnim);
+    r3d_sprite_batch_unload();
+    glDeleteTextures(1, &R3D.skinning.paletteTexture);
+    glDeleteBuffers(1, &R3D.skinning.paletteBuffer);
+    glDeleteBuffers(1, &R3D.skinning.vertexBuffer);
+
+    r3d_sort_unload();
+    r3d_cull_gpu_unload();
+
     glDeleteVertexArrays(1, &R3D.primitive.dummyVAO);
+
     r3d_primitive_unload(&R3D.primitive.quad);
     r3d_primitive_unload(&R3D.primitive.cube);
 }
@@ -298,6 +360,33 @@ void R3D_SetTextureFilter(TextureFilter filter)
     R3D.state.loading.textureFilter = filter;
 }
 
+void R3D_SetLODThreshold(float pixels)
+{
+    R3D.state.lod.threshold = fmaxf(pixels, 0.0f);
+}
+
+void R3D_SetShadowLODBias(int levels)
+{
+    R3D.state.lod.shadowBias = (levels > 0) ? levels : 0;
+}
+
+void R3D_SetLODFadeRange(float range)
+{
+    R3D.state.lod.fadeRange = fmaxf(range, 0.0f);
+}
+
+void R3D_SetAnimationLOD(float fullRatePixels, int maxInterval)
+{
+    R3D.state.animLod.fullRatePixels = fmaxf(fullRatePixels, 0.0f);
+    R3D.state.animLod.maxInterval = (maxInterval > 1) ? maxInterval : 1;
+}
+
+void R3D_SetAnimationSkeletonLOD(float pixels, int levels)
+{
+    R3D.state.animLod.reducedPixels = fmaxf(pixels, 0.0f);
+    R3D.state.animLod.reducedLevels = (levels > 0) ? levels : 0;
+}
+
 void R3D_Begin(Camera3D camera)
 {
     // Render the batch before proceeding
@@ -308,6 +397,14 @@ void R3D_Begin(Camera3D camera)
     r3d_array_clear(&R3D.container.aDrawDeferred);
     r3d_array_clear(&R3D.container.aDrawForwardInst);
     r3d_array_clear(&R3D.container.aDrawDeferredInst);
+    r3d_array_clear(&R3D.container.aDrawImpostor);
+    r3d_array_clear(&R3D.container.aDrawImpostorInst);
+    r3d_array_clear(&R3D.container.aBonePalette);
+    r3d_array_clear(&R3D.container.aInstanceAnim);
+    r3d_sprite_batch_reset();
+
+    // Advance the tick used to stagger animation updates
+    R3D.state.animLod.tick++;
 
     // Store camera position
     R3D.state.transform.viewPos = camera.position;
@@ -358,9 +455,25 @@ void R3D_Begin(Camera3D camera)
 
 void R3D_End(void)
 {
+    /* --- Turn the sprite batches into instanced draw calls --- */
+
+    r3d_sprite_batch_flush();
+
+    /* --- Upload the skinning matrices shared by all passes --- */
+
+    r3d_prepare_upload_bone_palette();
+
     /* --- Rendering in shadow maps --- */
 
     r3d_prepare_process_lights_and_batch();
+
+    // Meshes seen by the camera or by a shadow map are skinned once for every pass,
+    // before culling and sorting separate the draws of a mesh
+    r3d_prepare_preskin_drawcalls();
+
+    // Instances culled on the GPU are uploaded once, each pass only runs the culling
+    r3d_prepare_upload_culled_instances();
+
     r3d_pass_shadow_maps();
 
     /* --- Prcoess all draw calls before rendering --- */
@@ -370,7 +483,6 @@ void R3D_End(void)
     }
 
     r3d_prepare_sort_drawcalls();
-    r3d_prepare_anim_drawcalls();
 
     /* --- Rasterizing Geometries in G-Buffer --- */
 
@@ -466,6 +578,7 @@ void R3D_DrawMesh(const R3D_Mesh* mesh, const R3D_Material* material, Matrix tra
     drawCall.transform = transform;
     drawCall.material = material ? *material : R3D_GetDefaultMaterial();
     drawCall.geometry.model.mesh = mesh;
+    drawCall.geometry.model.aabb = mesh->aabb;
     drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
     drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
 
@@ -475,7 +588,7 @@ void R3D_DrawMesh(const R3D_Mesh* mesh, const R3D_Material* material, Matrix tra
         arr = &R3D.container.aDrawForward;
     }
 
-    r3d_array_push_back(arr, &drawCall);
+    r3d_push_mesh_drawcall(&drawCall, arr);
 }
 
 void R3D_DrawMeshInstanced(const R3D_Mesh* mesh, const R3D_Material* material, const Matrix* instanceTransforms, int instanceCount)
@@ -527,6 +640,103 @@ void R3D_DrawMeshInstancedPro(const R3D_Mesh* mesh, const R3D_Material* material
     r3d_array_push_back(arr, &drawCall);
 }
 
+void R3D_DrawMeshInstancedPacked(const R3D_Mesh* mesh, const R3D_Material* material,
+                                 const BoundingBox* globalAabb, Matrix globalTransform,
+                                 const R3D_PackedInstance* instances, int instanceCount)
+{
+    r3d_drawcall_t drawCall = { 0 };
+
+    if (mesh == NULL || instanceCount == 0 || instances == NULL) {
+        return;
+    }
+
+    drawCall.transform = globalTransform;
+    drawCall.material = material ? *material : R3D_GetDefaultMaterial();
+    drawCall.geometry.model.mesh = mesh;
+    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
+    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    drawCall.instanced.allAabb = globalAabb ? *globalAabb
+        : (BoundingBox) {
+            { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+            { +FLT_MAX, +FLT_MAX, +FLT_MAX }
+        };
+
+    drawCall.instanced.packed = instances;
+    drawCall.instanced.count = instanceCount;
+
+    r3d_array_t* arr = &R3D.container.aDrawDeferredInst;
+    if (drawCall.material.blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+        drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+        arr = &R3D.container.aDrawForwardInst;
+    }
+
+    r3d_array_push_back(arr, &drawCall);
+}
+
+R3D_PackedInstance R3D_PackInstance(Vector3 position, Quaternion rotation, Vector3 scale, Color color)
+{
+    R3D_PackedInstance instance = { 0 };
+
+    float length = sqrtf(rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w);
+    rotation = (length > 1e-6f)
+        ? (Quaternion) { rotation.x / length, rotation.y / length, rotation.z / length, rotation.w / length }
+        : (Quaternion) { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    r3d_instance_pack(&instance, &position, &rotation, &scale, color);
+
+    return instance;
+}
+
+void R3D_DrawMeshInstancedParams(const R3D_Mesh* mesh, const R3D_Material* material,
+                                 const BoundingBox* globalAabb, Matrix globalTransform,
+                                 const Matrix* instanceTransforms, const Color* instanceColors,
+                                 const R3D_InstanceParams* instanceParams, int instanceCount)
+{
+    r3d_drawcall_t drawCall = { 0 };
+
+    if (mesh == NULL || instanceCount == 0 || instanceTransforms == NULL) {
+        return;
+    }
+
+    drawCall.transform = globalTransform;
+    drawCall.material = material ? *material : R3D_GetDefaultMaterial();
+    drawCall.geometry.model.mesh = mesh;
+    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
+    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    drawCall.instanced.allAabb = globalAabb ? *globalAabb
+        : (BoundingBox) {
+            { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+            { +FLT_MAX, +FLT_MAX, +FLT_MAX }
+        };
+
+    drawCall.instanced.transforms = instanceTransforms;
+    drawCall.instanced.colors = instanceColors;
+    drawCall.instanced.params = instanceParams;
+    drawCall.instanced.count = instanceCount;
+
+    r3d_array_t* arr = &R3D.container.aDrawDeferredInst;
+    if (drawCall.material.blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+        drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+        arr = &R3D.container.aDrawForwardInst;
+    }
+
+    r3d_array_push_back(arr, &drawCall);
+}
+
+R3D_InstanceParams R3D_GetDefaultInstanceParams(void)
+{
+    return (R3D_InstanceParams) {
+        .uvOffset = { 0.0f, 0.0f },
+        .uvScale = { 1.0f, 1.0f },
+        .frame = 0.0f,
+        .emission = 1.0f,
+        .roughness = 1.0f,
+        .metalness = 1.0f
+    };
+}
+
 void R3D_DrawModel(const R3D_Model* model, Vector3 position, float scale)
 {
     Vector3 vScale = { scale, scale, scale };
@@ -554,44 +764,7 @@ void R3D_DrawModelPro(const R3D_Model* model, Matrix transform)
 {
     if (model == NULL) return;
 
-    for (int i = 0; i < model->meshCount; i++)
-    {
-        const R3D_Material* material = &model->materials[model->meshMaterials[i]];
-        const R3D_Mesh* mesh = &model->meshes[i];
-
-        r3d_drawcall_t drawCall = { 0 };
-
-        if (mesh == NULL) return;
-
-        switch (material->billboardMode) {
-        case R3D_BILLBOARD_FRONT:
-            r3d_transform_to_billboard_front(&transform, &R3D.state.transform.invView);
-            break;
-        case R3D_BILLBOARD_Y_AXIS:
-            r3d_transform_to_billboard_y(&transform, &R3D.state.transform.invView);
-            break;
-        default:
-            break;
-        }
-
-        drawCall.transform = transform;
-        drawCall.material = material ? *material : R3D_GetDefaultMaterial();
-        drawCall.geometry.model.mesh = mesh;
-        drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
-        drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
-
-        drawCall.geometry.model.anim = model->anim;
-        drawCall.geometry.model.frame = model->animFrame;
-        drawCall.geometry.model.boneOffsets = model->boneOffsets;
-
-        r3d_array_t* arr = &R3D.container.aDrawDeferred;
-        if (material->blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
-            drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
-            arr = &R3D.container.aDrawForward;
-        }
-
-        r3d_array_push_back(arr, &drawCall);
-    }
+    r3d_push_model_drawcalls(model, transform, 0.0f);
 }
 
 void R3D_DrawModelInstanced(const R3D_Model* model, const Matrix* instanceTransforms, int instanceCount)
@@ -630,6 +803,9 @@ void R3D_DrawModelInstancedPro(const R3D_Model* model,
     r3d_array_reserve(deferredArr, deferredArr->count + model->meshCount);
     r3d_array_reserve(forwardArr, forwardArr->count + model->meshCount);
 
+    int boneOffset = 0;
+    const R3D_ModelAnimation* skeleton = r3d_push_bone_palette(model, NULL, &boneOffset);
+
     for (int i = 0; i < model->meshCount; i++)
     {
         const R3D_Mesh* mesh = &model->meshes[i];
@@ -649,8 +825,8 @@ void R3D_DrawModelInstancedPro(const R3D_Model* model,
         drawCall.instanced.colors = instanceColors;
         drawCall.instanced.count = instanceCount;
 
-        drawCall.geometry.model.anim = model->anim;
-        drawCall.geometry.model.frame = model->animFrame;
+        drawCall.geometry.model.anim = skeleton;
+        drawCall.geometry.model.boneOffset = boneOffset;
         drawCall.geometry.model.boneOffsets = model->boneOffsets;
 
         if (material->blendMode != R3D_BLEND_OPAQUE || forceForward) {
@@ -663,6 +839,76 @@ void R3D_DrawModelInstancedPro(const R3D_Model* model,
     }
 }
 
+void R3D_DrawModelInstancedAnimated(const R3D_Model* model, const R3D_AnimationTexture* animTexture,
+                                    const Matrix* instanceTransforms, const Color* instanceColors,
+                                    const R3D_InstanceAnimation* instanceAnims, int instanceCount)
+{
+    if (model == NULL || animTexture == NULL || animTexture->texture == 0 || instanceAnims == NULL) {
+        return;
+    }
+
+    if (instanceCount <= 0 || instanceTransforms == NULL || model->meshCount == 0) {
+        return;
+    }
+
+    /* --- Convert the states of the instances into pairs of baked frames --- */
+
+    size_t animOffset = 0;
+    r3d_instance_anim_t* anims = r3d_push_instance_anims(instanceCount, &animOffset);
+    if (anims == NULL) return;
+
+    for (int i = 0; i < instanceCount; i++)
+    {
+        int clip = instanceAnims[i].clip;
+        if (clip < 0 || clip >= animTexture->clipCount) clip = 0;
+
+        r3d_set_instance_anim(
+            &anims[i], instanceAnims[i].frame,
+            animTexture->clipFirstFrames[clip],
+            animTexture->clipFrameCounts[clip],
+            animTexture->boneCount
+        );
+    }
+
+    /* --- Push one instanced draw call per mesh --- */
+
+    r3d_push_animated_instanced_drawcalls(
+        model, instanceTransforms, instanceColors, instanceCount,
+        animTexture, NULL, animOffset
+    );
+}
+
+void R3D_DrawModelInstancedVertexAnimated(const R3D_Model* model, const R3D_VertexAnimation* vertexAnim, float frame,
+                                          const Matrix* instanceTransforms, const Color* instanceColors,
+                                          const float* instanceFrameOffsets, int instanceCount)
+{
+    if (model == NULL || vertexAnim == NULL || vertexAnim->texture == 0) {
+        return;
+    }
+
+    if (instanceCount <= 0 || instanceTransforms == NULL || model->meshCount == 0) {
+        return;
+    }
+
+    /* --- Convert the time of the instances into pairs of baked frames --- */
+
+    size_t animOffset = 0;
+    r3d_instance_anim_t* anims = r3d_push_instance_anims(instanceCount, &animOffset);
+    if (anims == NULL) return;
+
+    for (int i = 0; i < instanceCount; i++) {
+        float instanceFrame = frame + (instanceFrameOffsets ? instanceFrameOffsets[i] : 0.0f);
+        r3d_set_instance_anim(&anims[i], instanceFrame, 0, vertexAnim->frameCount, vertexAnim->vertexCount);
+    }
+
+    /* --- Push one instanced draw call per mesh --- */
+
+    r3d_push_animated_instanced_drawcalls(
+        model, instanceTransforms, instanceColors, instanceCount,
+        NULL, vertexAnim, animOffset
+    );
+}
+
 void R3D_DrawSprite(const R3D_Sprite* sprite, Vector3 position)
 {
     R3D_DrawSpritePro(sprite, position, (Vector2) { 1.0f, 1.0f }, (Vector3) { 0, 1, 0 }, 0.0f);
@@ -677,6 +923,18 @@ void R3D_DrawSpritePro(const R3D_Sprite* sprite, Vector3 position, Vector2 size,
 {
     if (sprite == NULL) return;
 
+    // Batched sprites are gathered by material then drawn with a single instanced draw call per batch,
+    // the texture coordinates of their frame being sent as parameters of their instance
+    if (R3D.state.flags & R3D_FLAG_SPRITE_BATCHING) {
+        R3D_InstanceParams params = R3D_GetDefaultInstanceParams();
+        r3d_sprite_get_uv_scale_offset(
+            &params.uvScale, &params.uvOffset, sprite,
+            (size.x > 0) ? 1.0f : -1.0f, (size.y > 0) ? 1.0f : -1.0f
+        );
+        r3d_sprite_batch_push(sprite, position, size, rotationAxis, rotationAngle, &params);
+        return;
+    }
+
     r3d_drawcall_t drawCall = { 0 };
 
     /* --- Calculation of the transformation matrix --- */
@@ -797,6 +1055,50 @@ void R3D_DrawSpriteInstancedPro(const R3D_Sprite* sprite, const BoundingBox* glo
     r3d_array_push_back(arr, &drawCall);
 }
 
+void R3D_DrawSpriteInstancedParams(const R3D_Sprite* sprite, const BoundingBox* globalAabb, Matrix globalTransform,
+                                   const Matrix* instanceTransforms, const Color* instanceColors,
+                                   const R3D_InstanceParams* instanceParams, int instanceCount)
+{
+    if (instanceParams == NULL) {
+        R3D_DrawSpriteInstancedPro(sprite, globalAabb, globalTransform, instanceTransforms, 0, instanceColors, 0, instanceCount);
+        return;
+    }
+
+    r3d_drawcall_t drawCall = { 0 };
+
+    if (sprite == NULL || instanceCount == 0 || instanceTransforms == NULL) {
+        return;
+    }
+
+    // The frame of each instance is mapped by the shader, within the UV transform of the material
+    drawCall.transform = globalTransform;
+    drawCall.material = sprite->material;
+    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_SPRITE;
+    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    drawCall.instanced.allAabb = globalAabb ? *globalAabb
+        : (BoundingBox) {
+            { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+            { +FLT_MAX, +FLT_MAX, +FLT_MAX }
+        };
+
+    drawCall.instanced.transforms = instanceTransforms;
+    drawCall.instanced.colors = instanceColors;
+    drawCall.instanced.params = instanceParams;
+    drawCall.instanced.xFrameCount = sprite->xFrameCount;
+    drawCall.instanced.yFrameCount = sprite->yFrameCount;
+    drawCall.instanced.count = instanceCount;
+
+    r3d_array_t* arr = &R3D.container.aDrawDeferredInst;
+
+    if (sprite->material.blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+        drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+        arr = &R3D.container.aDrawForwardInst;
+    }
+
+    r3d_array_push_back(arr, &drawCall);
+}
+
 void R3D_DrawParticleSystem(const R3D_ParticleSystem* system, const R3D_Mesh* mesh, const R3D_Material* material)
 {
     R3D_DrawParticleSystemEx(system, mesh, material, MatrixIdentity());
@@ -808,54 +1110,548 @@ void R3D_DrawParticleSystemEx(const R3D_ParticleSystem* system, const R3D_Mesh*
         return;
     }
 
-    R3D_DrawMeshInstancedPro(
-        mesh, material, &system->aabb, transform,
-        &system->particles->transform, sizeof(R3D_Particle),
-        &system->particles->color, sizeof(R3D_Particle),
-        system->count
-    );
-}
+    // The bounds hold the particle positions, extend them by the mesh in any orientation at the largest scale
+    BoundingBox aabb = system->aabb;
+    if (system->maxScale > 0.0f && aabb.min.x != -FLT_MAX) {
+        Vector3 extent = Vector3Max(Vector3Negate(mesh->aabb.min), mesh->aabb.max);
+        float radius = Vector3Length(extent) * system->maxScale;
+        aabb.min = Vector3AddValue(aabb.min, -radius);
+        aabb.max = Vector3AddValue(aabb.max, radius);
+    }
 
+    // GPU particles are drawn straight from their simulation buffer
+    if (system->gpu) {
+        if (system->count == 0) return;
 
-/* === Internal functions === */
+        r3d_drawcall_t drawCall = { 0 };
 
-static bool r3d_has_deferred_calls(void)
-{
-    return (R3D.container.aDrawDeferred.count > 0 || R3D.container.aDrawDeferredInst.count > 0);
-}
+        drawCall.transform = transform;
+        drawCall.material = material ? *material : R3D_GetDefaultMaterial();
+        drawCall.geometry.model.mesh = mesh;
+        drawCall.geometry.model.aabb = mesh->aabb;
+        drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
 
-static bool r3d_has_forward_calls(void)
-{
-    return (R3D.container.aDrawForward.count > 0 || R3D.container.aDrawForwardInst.count > 0);
-}
+        drawCall.instanced.allAabb = aabb;
+        drawCall.instanced.buffer = r3d_particle_gpu_get_buffer(system->gpu);
+        drawCall.instanced.transStride = R3D_PARTICLE_GPU_STRIDE;
+        drawCall.instanced.bufferColorOffset = R3D_PARTICLE_GPU_COLOR_OFFSET;
+        drawCall.instanced.count = system->count;
 
-void r3d_sprite_get_uv_scale_offset(Vector2* uvScale, Vector2* uvOffset, const R3D_Sprite* sprite, float sgnX, float sgnY)
-{
-    uvScale->x = sgnX / sprite->xFrameCount;
-    uvScale->y = sgnY / sprite->yFrameCount;
+        r3d_array_t* arr = &R3D.container.aDrawDeferredInst;
+        if (drawCall.material.blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+            drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+            arr = &R3D.container.aDrawForwardInst;
+        }
+        else {
+            drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+        }
 
-    int frameIndex = (int)sprite->currentFrame % (sprite->xFrameCount * sprite->yFrameCount);
-    int frameX = frameIndex % sprite->xFrameCount;
-    int frameY = frameIndex / sprite->xFrameCount;
+        r3d_array_push_back(arr, &drawCall);
+        return;
+    }
 
-    uvOffset->x = frameX * uvScale->x;
-    uvOffset->y = frameY * uvScale->y;
+    R3D_DrawMeshInstancedPacked(
+        mesh, material, &aabb, transform,
+        system->particles.instances, system->count
+    );
 }
 
-void r3d_stencil_enable_geometry_write(void)
+void R3D_DrawImpostor(const R3D_Impostor* impostor, Matrix transform)
 {
-    // Enable stencil test and write the geometry bit
-    glEnable(GL_STENCIL_TEST);
-    glStencilMask(R3D_STENCIL_GEOMETRY_MASK); // Only write geometry bit
-    glStencilFunc(GL_ALWAYS, R3D_STENCIL_GEOMETRY_BIT, R3D_STENCIL_GEOMETRY_MASK);
-    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE); // Replace geometry bit on pass
+    if (impostor == NULL || impostor->albedo.id == 0) {
+        return;
+    }
+
+    r3d_drawcall_t drawCall = { 0 };
+
+    drawCall.transform = transform;
+    drawCall.material = R3D_GetDefaultMaterial();
+    drawCall.geometry.impostor.impostor = impostor;
+    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_IMPOSTOR;
+    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    r3d_array_push_back(&R3D.container.aDrawImpostor, &drawCall);
 }
 
-void r3d_stencil_enable_geometry_test(GLenum condition)
+void R3D_DrawImpostorInstanced(const R3D_Impostor* impostor, const Matrix* instanceTransforms, int instanceCount)
 {
-    // Enable stencil test to check geometry bit against a condition
-    glEnable(GL_STENCIL_TEST);
-    glStencilMask(0x00); // Disable writing
+    if (impostor == NULL || impostor->albedo.id == 0 || instanceTransforms == NULL || instanceCount == 0) {
+        return;
+    }
+
+    r3d_drawcall_t drawCall = { 0 };
+
+    drawCall.transform = MatrixIdentity();
+    drawCall.material = R3D_GetDefaultMaterial();
+    drawCall.geometry.impostor.impostor = impostor;
+    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_IMPOSTOR;
+    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    // Union of the bounding spheres of the instances, the quads facing any direction
+    drawCall.instanced.allAabb = (BoundingBox) {
+        { +FLT_MAX, +FLT_MAX, +FLT_MAX },
+        { -FLT_MAX, -FLT_MAX, -FLT_MAX }
+    };
+
+    for (int i = 0; i < instanceCount; i++) {
+        Vector3 center = Vector3Transform(impostor->center, instanceTransforms[i]);
+        float radius = impostor->radius * r3d_matrix_max_scale(&instanceTransforms[i]);
+        Vector3 extent = { radius, radius, radius };
+        drawCall.instanced.allAabb.min = Vector3Min(drawCall.instanced.allAabb.min, Vector3Subtract(center, extent));
+        drawCall.instanced.allAabb.max = Vector3Max(drawCall.instanced.allAabb.max, Vector3Add(center, extent));
+    }
+
+    drawCall.instanced.transforms = instanceTransforms;
+    drawCall.instanced.transStride = 0;
+    drawCall.instanced.colStride = 0;
+    drawCall.instanced.colors = NULL;
+    drawCall.instanced.count = instanceCount;
+
+    r3d_array_push_back(&R3D.container.aDrawImpostorInst, &drawCall);
+}
+
+void R3D_DrawModelImpostor(const R3D_Model* model, const R3D_Impostor* impostor, Matrix transform, float switchSize, float fadeRange)
+{
+    if (model == NULL) return;
+
+    if (impostor == NULL || impostor->albedo.id == 0) {
+        r3d_push_model_drawcalls(model, transform, 0.0f);
+        return;
+    }
+
+    // Projected size of the impostor bounding sphere in world space
+    Vector3 center = Vector3Transform(impostor->center, transform);
+    float radius = impostor->radius * r3d_matrix_max_scale(&transform);
+    float size = r3d_get_screen_size(center, radius);
+
+    float halfRange = 0.5f * fmaxf(fadeRange, 0.0f);
+    float lo = switchSize - halfRange;
+    float hi = switchSize + halfRange;
+
+    if (size >= hi) {
+        r3d_push_model_drawcalls(model, transform, 0.0f);
+        return;
+    }
+
+    if (size < lo) {
+        R3D_DrawImpostor(impostor, transform);
+        return;
+    }
+
+    // Both representations are drawn with complementary dither patterns
+    float fade = 1.0f - (size - lo) / (hi - lo);
+
+    r3d_push_model_drawcalls(model, transform, -fade);
+
+    r3d_drawcall_t drawCall = { 0 };
+
+    drawCall.transform = transform;
+    drawCall.material = R3D_GetDefaultMaterial();
+    drawCall.geometry.impostor.impostor = impostor;
+    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_IMPOSTOR;
+    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+    drawCall.ditherFade = fade;
+
+    r3d_array_push_back(&R3D.container.aDrawImpostor, &drawCall);
+}
+
+
+/* === Internal functions === */
+
+static bool r3d_has_deferred_calls(void)
+{
+    return (R3D.container.aDrawDeferred.count > 0 || R3D.container.aDrawDeferredInst.count > 0 ||
+            R3D.container.aDrawImpostor.count > 0 || R3D.container.aDrawImpostorInst.count > 0);
+}
+
+static bool r3d_has_forward_calls(void)
+{
+    return (R3D.container.aDrawForward.count > 0 || R3D.container.aDrawForwardInst.count > 0);
+}
+
+static float r3d_get_screen_size(Vector3 center, float radius)
+{
+    const Matrix* proj = &R3D.state.transform.proj;
+
+    // Orthographic projection, the size does not depend on distance
+    if (proj->m15 == 1.0f) {
+        return radius * proj->m5;
+    }
+
+    float distance = Vector3Distance(center, R3D.state.transform.viewPos);
+    if (distance <= radius) return FLT_MAX;
+
+    return radius * proj->m5 / distance;
+}
+
+static int r3d_select_mesh_lod(const R3D_Mesh* mesh, const Matrix* transform, float* fade)
+{
+    *fade = 0.0f;
+
+    float threshold = R3D.state.lod.threshold;
+    if (mesh->lodCount == 0 || threshold <= 0.0f) return 0;
+
+    // Bounding sphere of the mesh in world space
+    float scale = r3d_matrix_max_scale(transform);
+    Vector3 center = Vector3Scale(Vector3Add(mesh->aabb.min, mesh->aabb.max), 0.5f);
+    float radius = 0.5f * Vector3Distance(mesh->aabb.min, mesh->aabb.max) * scale;
+    center = Vector3Transform(center, *transform);
+
+    // Number of pixels covered by one local unit at the nearest point of the sphere
+    const Matrix* proj = &R3D.state.transform.proj;
+    float pixelsPerUnit = 0.5f * R3D.state.resolution.height * proj->m5 * scale;
+
+    if (proj->m15 != 1.0f) {
+        float distance = Vector3Distance(center, R3D.state.transform.viewPos) - radius;
+        if (distance <= 0.0f) return 0;
+        pixelsPerUnit /= distance;
+    }
+
+    // Coarsest level whose projected error is acceptable, errors grow with the level
+    int lod = 0;
+    while (lod < mesh->lodCount && mesh->lods[lod].error * pixelsPerUnit <= threshold) {
+        lod++;
+    }
+
+    // Cross-fade towards the next level when it is about to be selected
+    float fadeRange = R3D.state.lod.fadeRange;
+    if (fadeRange > 0.0f && lod < mesh->lodCount) {
+        float nextError = mesh->lods[lod].error * pixelsPerUnit;
+        float t = 1.0f - (nextError - threshold) / (threshold * fadeRange);
+        if (t > 0.0f) *fade = fminf(t, 1.0f);
+    }
+
+    return lod;
+}
+
+static void r3d_push_mesh_drawcall(r3d_drawcall_t* drawCall, r3d_array_t* arr)
+{
+    float fade = 0.0f;
+
+    drawCall->geometry.model.lod = r3d_select_mesh_lod(
+        drawCall->geometry.model.mesh, &drawCall->transform, &fade
+    );
+
+    // Only deferred calls can be dithered, and not while already fading with an impostor
+    if (fade <= 0.0f || drawCall->renderMode != R3D_DRAWCALL_RENDER_DEFERRED || drawCall->ditherFade != 0.0f) {
+        r3d_array_push_back(arr, drawCall);
+        return;
+    }
+
+    drawCall->ditherFade = -fade;
+    r3d_array_push_back(arr, drawCall);
+
+    // The incoming level doesn't cast shadows to avoid rendering them twice
+    drawCall->geometry.model.lod++;
+    drawCall->ditherFade = fade;
+    drawCall->material.shadowCastMode = R3D_SHADOW_CAST_DISABLED;
+    r3d_array_push_back(arr, drawCall);
+}
+
+static void r3d_push_model_drawcalls(const R3D_Model* model, Matrix transform, float ditherFade)
+{
+    int boneOffset = 0;
+    const R3D_ModelAnimation* skeleton = r3d_push_bone_palette(model, &transform, &boneOffset);
+
+    const Matrix* skinMatrices = NULL;
+    int skinMatrixCount = 0;
+
+    if (skeleton != NULL) {
+        skinMatrices = (const Matrix*)R3D.container.aBonePalette.data + boneOffset;
+        skinMatrixCount = (skeleton->boneCount < model->boneCount) ? skeleton->boneCount : model->boneCount;
+    }
+
+    for (int i = 0; i < model->meshCount; i++)
+    {
+        const R3D_Material* material = &model->materials[model->meshMaterials[i]];
+        const R3D_Mesh* mesh = &model->meshes[i];
+
+        r3d_drawcall_t drawCall = { 0 };
+
+        if (mesh == NULL) return;
+
+        switch (material->billboardMode) {
+        case R3D_BILLBOARD_FRONT:
+            r3d_transform_to_billboard_front(&transform, &R3D.state.transform.invView);
+            break;
+        case R3D_BILLBOARD_Y_AXIS:
+            r3d_transform_to_billboard_y(&transform, &R3D.state.transform.invView);
+            break;
+        default:
+            break;
+        }
+
+        drawCall.transform = transform;
+        drawCall.material = material ? *material : R3D_GetDefaultMaterial();
+        drawCall.geometry.model.mesh = mesh;
+        drawCall.geometry.model.aabb = (skinMatrices != NULL)
+            ? r3d_anim_skinned_mesh_aabb(mesh, skinMatrices, skinMatrixCount)
+            : mesh->aabb;
+        drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
+        drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+        drawCall.ditherFade = ditherFade;
+
+        drawCall.geometry.model.anim = skeleton;
+        drawCall.geometry.model.boneOffset = boneOffset;
+        drawCall.geometry.model.boneOffsets = model->boneOffsets;
+
+        r3d_array_t* arr = &R3D.container.aDrawDeferred;
+        if (material->blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+            drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+            arr = &R3D.container.aDrawForward;
+        }
+
+        r3d_push_mesh_drawcall(&drawCall, arr);
+    }
+}
+
+static void r3d_select_animation_lod(const R3D_Model* model, const Matrix* transform, int* interval, int* level)
+{
+    *interval = 1;
+    *level = 0;
+
+    float fullRate = R3D.state.animLod.fullRatePixels;
+    float reduced = R3D.state.animLod.reducedPixels;
+
+    if (fullRate <= 0.0f && (reduced <= 0.0f || R3D.state.animLod.reducedLevels == 0)) {
+        return;
+    }
+
+    // Projected height of the bounding sphere of the model, in pixels
+    float scale = r3d_matrix_max_scale(transform);
+    Vector3 center = Vector3Scale(Vector3Add(model->aabb.min, model->aabb.max), 0.5f);
+    float radius = 0.5f * Vector3Distance(model->aabb.min, model->aabb.max) * scale;
+    center = Vector3Transform(center, *transform);
+
+    float pixels = r3d_get_screen_size(center, radius) * R3D.state.resolution.height;
+
+    // The update interval grows as the model shrinks on screen
+    if (fullRate > 0.0f && pixels < fullRate) {
+        int maxInterval = R3D.state.animLod.maxInterval;
+        *interval = (pixels > 0.0f) ? (int)(fullRate / pixels) : maxInterval;
+        if (*interval > maxInterval) *interval = maxInterval;
+        if (*interval < 1) *interval = 1;
+    }
+
+    if (reduced > 0.0f && pixels < reduced) {
+        *level = R3D.state.animLod.reducedLevels;
+    }
+}
+
+static const R3D_ModelAnimation* r3d_push_bone_palette(const R3D_Model* model, const Matrix* transform, int* boneOffset)
+{
+    const R3D_ModelAnimation* skeleton = model->anim;
+
+    bool layered = (model->animLayerCount > 0 && model->animLayers != NULL && model->animLayers[0].anim != NULL);
+    if (layered) skeleton = model->animLayers[0].anim;
+
+    if (skeleton == NULL || model->boneOffsets == NULL || skeleton->frameCount <= 0) {
+        return NULL;
+    }
+
+    /* --- Reserve the matrices of the model in the palette --- */
+
+    r3d_array_t* palette = &R3D.container.aBonePalette;
+
+    size_t offset = palette->count;
+    size_t required = offset + skeleton->boneCount;
+
+    if (required > palette->capacity) {
+        size_t capacity = (palette->capacity > 0) ? palette->capacity : 256;
+        while (capacity < required) capacity *= 2;
+        if (r3d_array_reserve(palette, capacity) < 0) {
+            return NULL;
+        }
+    }
+
+    /* --- Compute the pose once, shared by every mesh and pass --- */
+
+    Matrix* matrices = (Matrix*)palette->data + offset;
+
+    // Every draw of the model acquires its entry, even at full rate, so the
+    // entries keep following the same instances when their rate changes
+    r3d_anim_cache_entry_t* entry = NULL;
+    int interval = 1, level = 0;
+    if (transform != NULL && model->animCache != NULL && !layered) {
+        entry = r3d_anim_cache_acquire(model->animCache, R3D.state.animLod.tick);
+        r3d_select_animation_lod(model, transform, &interval, &level);
+    }
+
+    bool cached = false;
+    if (entry != NULL && (interval > 1 || level > 0)) {
+        cached = r3d_anim_cache_evaluate(
+            entry, skeleton, model->animFrame + model->animTime,
+            interval, level, R3D.state.animLod.tick, matrices
+        );
+    }
+
+    if (layered) {
+        r3d_anim_blend_poses(model->animLayers, model->animLayerCount, matrices);
+    }
+    else if (!cached) {
+        r3d_anim_sample_poses(skeleton, r3d_anim_wrap_frame(skeleton, model->animFrame + model->animTime), true, matrices);
+    }
+
+    int boneCount = (skeleton->boneCount < model->boneCount) ? skeleton->boneCount : model->boneCount;
+    for (int i = 0; i < boneCount; i++) {
+        matrices[i] = r3d_matrix_multiply(&model->boneOffsets[i], &matrices[i]);
+    }
+
+    palette->count = required;
+    *boneOffset = (int)offset;
+
+    return skeleton;
+}
+
+static BoundingBox r3d_get_instances_aabb(const BoundingBox* aabb, const Matrix* instanceTransforms, int instanceCount)
+{
+    BoundingBox allAabb = {
+        .min = { +FLT_MAX, +FLT_MAX, +FLT_MAX },
+        .max = { -FLT_MAX, -FLT_MAX, -FLT_MAX }
+    };
+
+    for (int i = 0; i < instanceCount; i++) {
+        BoundingBox moved = r3d_matrix_transform_aabb(&instanceTransforms[i], aabb);
+        allAabb.min = Vector3Min(allAabb.min, moved.min);
+        allAabb.max = Vector3Max(allAabb.max, moved.max);
+    }
+
+    return allAabb;
+}
+
+static r3d_instance_anim_t* r3d_push_instance_anims(int instanceCount, size_t* animOffset)
+{
+    r3d_array_t* animArr = &R3D.container.aInstanceAnim;
+
+    size_t offset = animArr->count;
+    if (r3d_array_reserve(animArr, offset + instanceCount) < 0) {
+        return NULL;
+    }
+
+    animArr->count = offset + instanceCount;
+    *animOffset = offset;
+
+    return (r3d_instance_anim_t*)animArr->data + offset;
+}
+
+static void r3d_set_instance_anim(r3d_instance_anim_t* anim, float frame, int firstFrame, int frameCount, int frameSize)
+{
+    frame = fmodf(frame, (float)frameCount);
+    if (frame < 0.0f) frame += frameCount;
+
+    int frame0 = (int)frame;
+    if (frame0 >= frameCount) frame0 = frameCount - 1;
+    int frame1 = (frame0 + 1 < frameCount) ? frame0 + 1 : 0;
+
+    anim->frameOffsets[0] = (uint32_t)(firstFrame + frame0) * (uint32_t)frameSize;
+    anim->frameOffsets[1] = (uint32_t)(firstFrame + frame1) * (uint32_t)frameSize;
+    anim->blend = frame - frame0;
+}
+
+static void r3d_push_animated_instanced_drawcalls(const R3D_Model* model, const Matrix* instanceTransforms, const Color* instanceColors, int instanceCount,
+                                                  const R3D_AnimationTexture* animTexture, const R3D_VertexAnimation* vertexAnim, size_t animOffset)
+{
+    bool forceForward = R3D.state.flags & R3D_FLAG_FORCE_FORWARD;
+    r3d_array_t* deferredArr = &R3D.container.aDrawDeferredInst;
+    r3d_array_t* forwardArr = &R3D.container.aDrawForwardInst;
+
+    r3d_array_reserve(deferredArr, deferredArr->count + model->meshCount);
+    r3d_array_reserve(forwardArr, forwardArr->count + model->meshCount);
+
+    /* --- Bounds of all the instances, shared by the meshes --- */
+
+    BoundingBox allAabb = {
+        { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+        { +FLT_MAX, +FLT_MAX, +FLT_MAX }
+    };
+
+    // The baked frames give the reach of the animated model
+    if (animTexture != NULL) {
+        allAabb = r3d_get_instances_aabb(&animTexture->aabb, instanceTransforms, instanceCount);
+    }
+    else if (vertexAnim != NULL) {
+        allAabb = r3d_get_instances_aabb(&vertexAnim->aabb, instanceTransforms, instanceCount);
+    }
+
+    /* --- Push one draw call per mesh --- */
+
+    int vertexAnimBase = 0;
+
+    for (int i = 0; i < model->meshCount; i++)
+    {
+        const R3D_Mesh* mesh = &model->meshes[i];
+        const R3D_Material* material = &model->materials[model->meshMaterials[i]];
+
+        r3d_drawcall_t drawCall = { 0 };
+
+        drawCall.transform = R3D_MATRIX_IDENTITY;
+        drawCall.material = *material;
+        drawCall.geometry.model.mesh = mesh;
+        drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
+
+        drawCall.instanced.allAabb = allAabb;
+        drawCall.instanced.transforms = instanceTransforms;
+        drawCall.instanced.colors = instanceColors;
+        drawCall.instanced.count = instanceCount;
+        drawCall.instanced.animTexture = animTexture;
+        drawCall.instanced.vertexAnim = vertexAnim;
+        drawCall.instanced.vertexAnimBase = vertexAnimBase;
+        drawCall.instanced.animOffset = animOffset;
+
+        vertexAnimBase += mesh->vertexCount;
+
+        // Meshes past the baked vertices are drawn in their rest pose
+        if (vertexAnim != NULL && vertexAnimBase > vertexAnim->vertexCount) {
+            drawCall.instanced.allAabb = r3d_get_instances_aabb(&mesh->aabb, instanceTransforms, instanceCount);
+            drawCall.instanced.vertexAnim = NULL;
+            drawCall.instanced.animOffset = 0;
+        }
+
+        if (material->blendMode != R3D_BLEND_OPAQUE || forceForward) {
+            drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+            r3d_array_push_back(forwardArr, &drawCall);
+        } else {
+            drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+            r3d_array_push_back(deferredArr, &drawCall);
+        }
+    }
+}
+
+void r3d_sprite_get_uv_scale_offset(Vector2* uvScale, Vector2* uvOffset, const R3D_Sprite* sprite, float sgnX, float sgnY)
+{
+    int frameIndex = (int)sprite->currentFrame % (sprite->xFrameCount * sprite->yFrameCount);
+    int frameX = frameIndex % sprite->xFrameCount;
+    int frameY = frameIndex / sprite->xFrameCount;
+
+    // A flipped frame is read from its opposite edge, so it stays within its own cell
+    Vector2 frameScale = { sgnX / sprite->xFrameCount, sgnY / sprite->yFrameCount };
+    Vector2 frameOffset = {
+        (frameX + (sgnX < 0.0f)) / (float)sprite->xFrameCount,
+        (frameY + (sgnY < 0.0f)) / (float)sprite->yFrameCount
+    };
+
+    // The frame is mapped within the UV transform of the material (e.g. a region of an atlas)
+    const R3D_Material* material = &sprite->material;
+    uvOffset->x = material->uvOffset.x + frameOffset.x * material->uvScale.x;
+    uvOffset->y = material->uvOffset.y + frameOffset.y * material->uvScale.y;
+    uvScale->x = frameScale.x * material->uvScale.x;
+    uvScale->y = frameScale.y * material->uvScale.y;
+}
+
+void r3d_stencil_enable_geometry_write(void)
+{
+    // Enable stencil test and write the geometry bit
+    glEnable(GL_STENCIL_TEST);
+    glStencilMask(R3D_STENCIL_GEOMETRY_MASK); // Only write geometry bit
+    glStencilFunc(GL_ALWAYS, R3D_STENCIL_GEOMETRY_BIT, R3D_STENCIL_GEOMETRY_MASK);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE); // Replace geometry bit on pass
+}
+
+void r3d_stencil_enable_geometry_test(GLenum condition)
+{
+    // Enable stencil test to check geometry bit against a condition
+    glEnable(GL_STENCIL_TEST);
+    glStencilMask(0x00); // Disable writing
     glStencilFunc(condition, R3D_STENCIL_GEOMETRY_BIT, R3D_STENCIL_GEOMETRY_MASK);
     glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP); // No changes on test
 }
@@ -993,6 +1789,32 @@ void r3d_prepare_cull_drawcalls(void)
     }
 
     R3D.container.aDrawForwardInst.count = count;
+
+    /* --- Frustum culling of impostors --- */
+
+    calls = (r3d_drawcall_t*)R3D.container.aDrawImpostor.data;
+    count = (int)R3D.container.aDrawImpostor.count;
+
+    for (int i = count - 1; i >= 0; i--) {
+        if (!r3d_drawcall_geometry_is_visible(&calls[i])) {
+            calls[i] = calls[--count];
+        }
+    }
+
+    R3D.container.aDrawImpostor.count = count;
+
+    /* --- Frustum culling of instanced impostors --- */
+
+    calls = (r3d_drawcall_t*)R3D.container.aDrawImpostorInst.data;
+    count = (int)R3D.container.aDrawImpostorInst.count;
+
+    for (int i = count - 1; i >= 0; i--) {
+        if (!r3d_drawcall_instanced_geometry_is_visible(&calls[i])) {
+            calls[i] = calls[--count];
+        }
+    }
+
+    R3D.container.aDrawImpostorInst.count = count;
 }
 
 void r3d_prepare_sort_drawcalls(void)
@@ -1025,38 +1847,248 @@ void r3d_prepare_sort_drawcalls(void)
     }
 }
 
-void r3d_prepare_anim_drawcalls(void)
+void r3d_prepare_upload_bone_palette(void)
 {
-    // TODO: Measures should be implemented to avoid updating the matrices multiple times for the same mesh,
-    //       because currently the same mesh could appear multiple times in the same array,
-    //       or in different arrays. As a result, the set would be updated multiple times.
+    const r3d_array_t* palette = &R3D.container.aBonePalette;
 
-    const r3d_array_t* arrays[4] = {
-        &R3D.container.aDrawDeferredInst,
-        &R3D.container.aDrawForwardInst,
+    if (palette->count == 0) {
+        return;
+    }
+
+    // Bones are uploaded as 3x4 affine matrices, optionally in half precision
+    bool half = (R3D.state.flags & R3D_FLAG_HALF_PRECISION_BONES);
+    size_t boneSize = R3D_ANIM_BONE_TEXELS * 4 * (half ? sizeof(r3d_half_t) : sizeof(float));
+
+    glBindBuffer(GL_TEXTURE_BUFFER, R3D.skinning.paletteBuffer);
+
+    if (palette->capacity > R3D.skinning.paletteCapacity || half != R3D.skinning.paletteHalf) {
+        if (palette->capacity > R3D.skinning.paletteCapacity) {
+            R3D.skinning.paletteCapacity = palette->capacity;
+        }
+        R3D.skinning.paletteHalf = half;
+        glBufferData(GL_TEXTURE_BUFFER, R3D.skinning.paletteCapacity * boneSize, NULL, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, R3D.skinning.paletteTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, half ? GL_RGBA16F : GL_RGBA32F, R3D.skinning.paletteBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+
+    // Invalidating the buffer orphans the storage, so we don't wait for the previous frame to be done with it
+    void* data = glMapBufferRange(
+        GL_TEXTURE_BUFFER, 0, palette->count * boneSize,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+    );
+
+    if (data != NULL) {
+        r3d_anim_pack_bones(palette->data, palette->count, half, data);
+        glUnmapBuffer(GL_TEXTURE_BUFFER);
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+// True if the draw call is within the view, or within the area of a light updating its shadow map
+static bool r3d_prepare_drawcall_is_needed(const r3d_drawcall_t* call, bool instanced)
+{
+    if (R3D.state.flags & R3D_FLAG_NO_FRUSTUM_CULLING) {
+        return true;
+    }
+
+    if (instanced ? r3d_drawcall_instanced_geometry_is_visible(call) : r3d_drawcall_geometry_is_visible(call)) {
+        return true;
+    }
+
+    if (call->material.shadowCastMode == R3D_SHADOW_CAST_DISABLED) {
+        return false;
+    }
+
+    BoundingBox aabb = instanced ? call->instanced.allAabb : call->geometry.model.aabb;
+    if (aabb.min.x == -FLT_MAX) {
+        return true;
+    }
+
+    if (!r3d_matrix_is_identity(&call->transform)) {
+        aabb = r3d_matrix_transform_aabb(&call->transform, &aabb);
+    }
+
+    for (int i = 0; i < R3D.container.aLightBatch.count; i++) {
+        const r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
+        if (!light->data->shadow.enabled || !light->data->shadow.updateConf.shoudlUpdate) continue;
+        if (CheckCollisionBoxes(aabb, light->aabb)) return true;
+    }
+
+    return false;
+}
+
+void r3d_prepare_preskin_drawcalls(void)
+{
+    if (!(R3D.state.flags & R3D_FLAG_PRESKINNING) || R3D.shader.raster.skinning.id == 0) {
+        return;
+    }
+
+    r3d_array_t* arrays[] = {
         &R3D.container.aDrawDeferred,
         &R3D.container.aDrawForward,
+        &R3D.container.aDrawDeferredInst,
+        &R3D.container.aDrawForwardInst
     };
 
-    for (int i = 0; i < sizeof(arrays) / sizeof(uintptr_t); i++)
+    const int arrayCount = sizeof(arrays) / sizeof(*arrays);
+    const size_t stride = 10 * sizeof(float);
+
+    /* --- Assign a range of the skinned vertex buffer to every skinned mesh --- */
+
+    // The draw calls of a mesh are consecutive until sorted (e.g. LOD cross-fades),
+    // so they can share the vertices skinned for the first one
+    size_t vertexCount = 0;
+
+    for (int a = 0; a < arrayCount; a++)
     {
-        const r3d_drawcall_t* calls = arrays[i]->data;
-        int count = (int)arrays[i]->count;
+        const R3D_Mesh* lastMesh = NULL;
+        int lastBoneOffset = -1;
 
-        for (int j = 0; j < count; j++)
+        for (size_t i = 0; i < arrays[a]->count; i++)
         {
-            const r3d_drawcall_t* call = &calls[j];
+            r3d_drawcall_t* call = (r3d_drawcall_t*)arrays[a]->data + i;
+            if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL) continue;
+            if (call->geometry.model.anim == NULL || call->geometry.model.boneOffsets == NULL) continue;
 
-            if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL || call->geometry.model.anim == NULL) {
+            const R3D_Mesh* mesh = call->geometry.model.mesh;
+            if (mesh->vao == 0 || mesh->vertexCount == 0) continue;
+
+            // The draws left out keep skinning in the shaders of the passes, if any draws them
+            if (!r3d_prepare_drawcall_is_needed(call, arrays[a] == &R3D.container.aDrawDeferredInst || arrays[a] == &R3D.container.aDrawForwardInst)) {
                 continue;
             }
 
-            if (call->geometry.model.mesh->boneMatrices == NULL) {
-                // Only meshes belonging to a model with bones have a boneMatrices cache
-                TraceLog(LOG_WARNING, "Attempting to play animation on mesh without bone matrix cache");
+            if (mesh != lastMesh || call->geometry.model.boneOffset != lastBoneOffset) {
+                lastMesh = mesh;
+                lastBoneOffset = call->geometry.model.boneOffset;
+                vertexCount += mesh->vertexCount;
+            }
+
+            call->geometry.model.skinnedVertex = (int)(vertexCount - mesh->vertexCount);
+            call->geometry.model.preSkinned = true;
+        }
+    }
+
+    if (vertexCount == 0) {
+        return;
+    }
+
+    /* --- Grow the skinned vertex buffer if needed --- */
+
+    glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, R3D.skinning.vertexBuffer);
+
+    if (vertexCount > R3D.skinning.vertexCapacity) {
+        size_t capacity = (R3D.skinning.vertexCapacity > 0) ? R3D.skinning.vertexCapacity : 4096;
+        while (capacity < vertexCount) capacity *= 2;
+        R3D.skinning.vertexCapacity = capacity;
+    }
+
+    // Orphan the storage so we don't wait for the previous frame to be done with it
+    glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, R3D.skinning.vertexCapacity * stride, NULL, GL_DYNAMIC_COPY);
+
+    /* --- Skin every mesh once, nothing is rasterized --- */
+
+    r3d_shader_enable(raster.skinning);
+    r3d_shader_bind_samplerBuffer(raster.skinning, uTexBoneMatrices, R3D.skinning.paletteTexture);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    int skinnedCount = 0;
+
+    for (int a = 0; a < arrayCount; a++)
+    {
+        for (size_t i = 0; i < arrays[a]->count; i++)
+        {
+            const r3d_drawcall_t* call = (const r3d_drawcall_t*)arrays[a]->data + i;
+            if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL || !call->geometry.model.preSkinned) continue;
+
+            // Ranges are assigned in order, only the first draw call of each range is skinned
+            if (call->geometry.model.skinnedVertex != skinnedCount) continue;
+
+            const R3D_Mesh* mesh = call->geometry.model.mesh;
+            skinnedCount += mesh->vertexCount;
+
+            r3d_shader_set_int(raster.skinning, uBoneOffset, call->geometry.model.boneOffset);
+
+            glBindBufferRange(
+                GL_TRANSFORM_FEEDBACK_BUFFER, 0, R3D.skinning.vertexBuffer,
+                call->geometry.model.skinnedVertex * stride, mesh->vertexCount * stride
+            );
+
+            glBindVertexArray(mesh->vao);
+            glBeginTransformFeedback(GL_POINTS);
+            glDrawArrays(GL_POINTS, 0, mesh->vertexCount);
+            glEndTransformFeedback();
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
+
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    r3d_shader_disable();
+}
+
+void r3d_prepare_upload_culled_instances(void)
+{
+    r3d_array_t* arrays[] = {
+        &R3D.container.aDrawDeferredInst,
+        &R3D.container.aDrawForwardInst
+    };
+
+    const int arrayCount = sizeof(arrays) / sizeof(*arrays);
+
+    /* --- Assign a range of the input buffer to every draw call culled on the GPU --- */
+
+    r3d_cull_gpu_input_t input;
+    size_t size = 0;
+
+    for (int a = 0; a < arrayCount; a++)
+    {
+        for (size_t i = 0; i < arrays[a]->count; i++)
+        {
+            r3d_drawcall_t* call = (r3d_drawcall_t*)arrays[a]->data + i;
+            if (!r3d_drawcall_instanced_gpu_cull_input(call, &input)) continue;
+            if (!r3d_prepare_drawcall_is_needed(call, true)) continue;
+
+            call->instanced.cullOffset = size;
+            call->instanced.cullUploaded = true;
+            size += r3d_cull_gpu_input_size(&input);
+        }
+    }
+
+    if (size == 0) {
+        return;
+    }
+
+    /* --- Upload the instances of every range at once --- */
+
+    bool uploaded = r3d_cull_gpu_begin_upload(size);
+
+    if (uploaded) {
+        for (int a = 0; a < arrayCount; a++) {
+            for (size_t i = 0; i < arrays[a]->count; i++) {
+                const r3d_drawcall_t* call = (const r3d_drawcall_t*)arrays[a]->data + i;
+                if (call->instanced.cullUploaded && r3d_drawcall_instanced_gpu_cull_input(call, &input)) {
+                    r3d_cull_gpu_upload(&input, call->instanced.cullOffset);
+                }
             }
+        }
+        uploaded = r3d_cull_gpu_end_upload();
+    }
+
+    if (uploaded) {
+        return;
+    }
 
-            r3d_drawcall_update_model_animation(call);
+    // Lost instances are drawn without culling
+    for (int a = 0; a < arrayCount; a++) {
+        for (size_t i = 0; i < arrays[a]->count; i++) {
+            ((r3d_drawcall_t*)arrays[a]->data + i)->instanced.cullUploaded = false;
         }
     }
 }
@@ -1215,6 +2247,32 @@ void r3d_pass_shadow_maps(void)
                         }
                     }
                 }
+
+                // Impostors are drawn facing the light, only the depth of their baked views is written
+                // A directional light is seen from far along its direction, so all impostors face it the same way
+                Vector3 impostorViewPos = light->data->position;
+                if (light->data->type == R3D_LIGHT_DIR) {
+                    impostorViewPos = Vector3Add(impostorViewPos, Vector3Scale(Vector3Normalize(light->data->direction), -1e5f));
+                }
+
+                r3d_shader_enable(raster.impostorInst);
+                {
+                    for (size_t j = 0; j < R3D.container.aDrawImpostorInst.count; j++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawImpostorInst.data + j;
+                        if (call->material.shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
+                            r3d_drawcall_raster_impostor_inst(call, impostorViewPos);
+                        }
+                    }
+                }
+                r3d_shader_enable(raster.impostor);
+                {
+                    for (size_t j = 0; j < R3D.container.aDrawImpostor.count; j++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawImpostor.data + j;
+                        if (call->material.shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
+                            r3d_drawcall_raster_impostor(call, impostorViewPos);
+                        }
+                    }
+                }
             }
             r3d_shader_disable();
         }
@@ -1298,10 +2356,31 @@ void r3d_pass_gbuffer(void)
                 r3d_drawcall_raster_geometry_inst((r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data + i);
             }
         }
-        r3d_shader_enable(raster.geometry);
+        r3d_shader_enable(raster.geometry[R3D_SHADER_GEOMETRY_BASE]);
+        {
+            for (size_t i = 0; i < R3D.container.aDrawDeferred.count; i++) {
+                const r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferred.data + i;
+                if (call->ditherFade == 0.0f) r3d_drawcall_raster_geometry(call, R3D_SHADER_GEOMETRY_BASE);
+            }
+        }
+        // Fading draws use the variant discarding the dithered pixels
+        r3d_shader_enable(raster.geometry[R3D_SHADER_GEOMETRY_DITHER]);
         {
             for (size_t i = 0; i < R3D.container.aDrawDeferred.count; i++) {
-                r3d_drawcall_raster_geometry((r3d_drawcall_t*)R3D.container.aDrawDeferred.data + i);
+                const r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferred.data + i;
+                if (call->ditherFade != 0.0f) r3d_drawcall_raster_geometry(call, R3D_SHADER_GEOMETRY_DITHER);
+            }
+        }
+        r3d_shader_enable(raster.impostorInst);
+        {
+            for (size_t i = 0; i < R3D.container.aDrawImpostorInst.count; i++) {
+                r3d_drawcall_raster_impostor_inst((r3d_drawcall_t*)R3D.container.aDrawImpostorInst.data + i, R3D.state.transform.viewPos);
+            }
+        }
+        r3d_shader_enable(raster.impostor);
+        {
+            for (size_t i = 0; i < R3D.container.aDrawImpostor.count; i++) {
+                r3d_drawcall_raster_impostor((r3d_drawcall_t*)R3D.container.aDrawImpostor.data + i, R3D.state.transform.viewPos);
             }
         }
         r3d_shader_disable();
@@ -1744,7 +2823,7 @@ static void r3d_pass_scene_forward_filter_and_send_lights(const r3d_drawcall_t*
         // It's not the most accurate possible but sufficient (?)
         if (light->data->type != R3D_LIGHT_DIR) {
             if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
-                if (!CheckCollisionBoxes(light->aabb, call->geometry.model.mesh->aabb)) {
+                if (!CheckCollisionBoxes(light->aabb, call->geometry.model.aabb)) {
                     continue;
                 }
             }
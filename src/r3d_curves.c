@@ -1,6 +1,7 @@
 #include "r3d.h"
 
 #include "./details/containers/r3d_array.h"
+#include "./details/r3d_curve.h"
 
 #include <raymath.h>
 #include <stdlib.h>
@@ -12,6 +13,7 @@ R3D_InterpolationCurve R3D_LoadInterpolationCurve(int capacity)
     curve.keyframes = RL_MALLOC(capacity * sizeof(R3D_Keyframe));
     curve.capacity = capacity;
     curve.count = 0;
+    curve.lut = NULL;
 
     return curve;
 }
@@ -19,6 +21,7 @@ R3D_InterpolationCurve R3D_LoadInterpolationCurve(int capacity)
 void R3D_UnloadInterpolationCurve(R3D_InterpolationCurve curve)
 {
     RL_FREE(curve.keyframes);
+    RL_FREE(curve.lut);
     curve.capacity = 0;
     curve.count = 0;
 }
@@ -43,25 +46,69 @@ bool R3D_AddKeyframe(R3D_InterpolationCurve* curve, float time, float value)
     curve->capacity = (unsigned int)array.capacity;
     curve->count = (unsigned int)array.count;
 
-    return result == R3D_ARRAY_SUCCESS;
+    if (result != R3D_ARRAY_SUCCESS) {
+        return false;
+    }
+
+    R3D_BakeCurve(curve);
+
+    return true;
+}
+
+bool R3D_BakeCurve(R3D_InterpolationCurve* curve)
+{
+    bool inRange = (curve->count == 0) || (
+        curve->keyframes[0].time >= 0.0f &&
+        curve->keyframes[curve->count - 1].time <= 1.0f
+    );
+
+    if (!inRange) {
+        RL_FREE(curve->lut);
+        curve->lut = NULL;
+        return false;
+    }
+
+    if (curve->lut == NULL) {
+        curve->lut = RL_MALLOC(R3D_CURVE_LUT_ALLOC);
+        if (curve->lut == NULL) return false;
+    }
+
+    // Evaluate from the keyframes, the table must not be used while it is being filled
+    float* lut = curve->lut;
+    curve->lut = NULL;
+
+    for (int i = 0; i <= R3D_CURVE_LUT_RESOLUTION; i++) {
+        lut[i] = R3D_EvaluateCurve(*curve, (float)i / R3D_CURVE_LUT_RESOLUTION);
+    }
+
+    curve->lut = lut;
+    r3d_curve_stamp_lut(curve);
+
+    return true;
 }
 
 float R3D_EvaluateCurve(R3D_InterpolationCurve curve, float time)
 {
+    const float* lut = r3d_curve_get_lut(&curve);
+    if (lut != NULL) {
+        return r3d_curve_sample_lut(lut, time);
+    }
+
     if (curve.count == 0) return 0.0f;
     if (time <= curve.keyframes[0].time) return curve.keyframes[0].value;
     if (time >= curve.keyframes[curve.count - 1].time) return curve.keyframes[curve.count - 1].value;
 
-    // Find the two keyframes surrounding the given time
-    for (int i = 0; i < (int)curve.count - 1; i++) {
-        const R3D_Keyframe* kf1 = &curve.keyframes[i];
-        const R3D_Keyframe* kf2 = &curve.keyframes[i + 1];
-
-        if (time >= kf1->time && time <= kf2->time) {
-            float t = (time - kf1->time) / (kf2->time - kf1->time); // Normalized time between kf1 and kf2
-            return Lerp(kf1->value, kf2->value, t);
-        }
+    // Find the two keyframes surrounding the given time, kf1.time <= time < kf2.time
+    int lo = 0, hi = (int)curve.count - 1;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (curve.keyframes[mid].time <= time) lo = mid;
+        else hi = mid;
     }
 
-    return 0.0f; // Fallback (should not be reached)
+    const R3D_Keyframe* kf1 = &curve.keyframes[lo];
+    const R3D_Keyframe* kf2 = &curve.keyframes[hi];
+
+    float t = (time - kf1->time) / (kf2->time - kf1->time); // Normalized time between kf1 and kf2
+    return Lerp(kf1->value, kf2->value, t);
 }
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "r3d.h"
+
+#include "./r3d_state.h"
+#include "./details/r3d_drawcall.h"
+
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <glad.h>
+
+#include <math.h>
+
+/* === Internal functions === */
+
+// Must match 'DecodeOctahedral(...).xzy' in 'impostor.vert'
+static Vector3 r3d_impostor_frame_direction(int x, int y, int frames)
+{
+    float u = 2.0f * ((x + 0.5f) / frames) - 1.0f;
+    float v = 2.0f * ((y + 0.5f) / frames) - 1.0f;
+
+    Vector3 n = { u, v, 1.0f - fabsf(u) - fabsf(v) };
+
+    if (n.z < 0.0f) {
+        float nx = n.x, ny = n.y;
+        n.x = (1.0f - fabsf(ny)) * (nx >= 0.0f ? 1.0f : -1.0f);
+        n.y = (1.0f - fabsf(nx)) * (ny >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    return Vector3Normalize((Vector3) { n.x, n.z, n.y });
+}
+
+static GLuint r3d_impostor_create_texture(GLenum internalFormat, GLenum format, GLenum type, int size)
+{
+    GLuint id = 0;
+
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D, id);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size, size, 0, format, type, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return id;
+}
+
+static Texture2D r3d_impostor_texture(GLuint id, int size, GLenum internalFormat)
+{
+    int format = PIXELFORMAT_UNCOMPRESSED_R8G8B8;
+
+    switch (internalFormat) {
+    case GL_R32F: format = PIXELFORMAT_UNCOMPRESSED_R32; break;
+    case GL_RG8: format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA; break;
+    case GL_RGB8: format = PIXELFORMAT_UNCOMPRESSED_R8G8B8; break;
+    case GL_RGB32F: format = PIXELFORMAT_UNCOMPRESSED_R32G32B32; break;
+    case GL_RGBA16F: format = PIXELFORMAT_UNCOMPRESSED_R16G16B16A16; break;
+    default: format = PIXELFORMAT_UNCOMPRESSED_R16G16B16; break;   // RGB16F, or the packed float fallbacks raylib has no format for
+    }
+
+    return (Texture2D) {
+        .id = id,
+        .width = size,
+        .height = size,
+        .mipmaps = 1,
+        .format = format
+    };
+}
+
+/* === Public functions === */
+
+R3D_Impostor R3D_LoadImpostor(const R3D_Model* model, int frames, int frameSize)
+{
+    R3D_Impostor impostor = { 0 };
+
+    if (model == NULL || model->meshCount == 0 || frames < 2 || frameSize <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Invalid parameters given to 'R3D_LoadImpostor'");
+        return impostor;
+    }
+
+    int size = frames * frameSize;
+
+    /* --- Bounding sphere of the model --- */
+
+    impostor.center = Vector3Scale(Vector3Add(model->aabb.min, model->aabb.max), 0.5f);
+    impostor.radius = 0.5f * Vector3Distance(model->aabb.min, model->aabb.max);
+    impostor.frames = frames;
+
+    if (impostor.radius <= 0.0f) {
+        TraceLog(LOG_WARNING, "R3D: Cannot bake an impostor from a model with an empty bounding box");
+        return impostor;
+    }
+
+    /* --- Create the atlases, same channels as the G-buffer --- */
+
+    // Formats having a raylib equivalent, so that the size and format of the textures can be queried,
+    // the G-buffer ones (R11G11B10F emission, RG16F normals) having none
+    GLenum floatFormat = r3d_support_get_internal_format(GL_RGB16F, true);
+    GLenum normalFormat = R3D.support.RG16F.attachment ? floatFormat : GL_RG8;
+
+    GLuint albedo = r3d_impostor_create_texture(GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, size);
+    GLuint emission = r3d_impostor_create_texture(floatFormat, GL_RGB, GL_FLOAT, size);
+    GLuint normal = (normalFormat == GL_RG8)
+        ? r3d_impostor_create_texture(GL_RG8, GL_RG, GL_UNSIGNED_BYTE, size)
+        : r3d_impostor_create_texture(normalFormat, GL_RGB, GL_FLOAT, size);
+    GLuint orm = r3d_impostor_create_texture(GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, size);
+
+    // Depth formats have no raylib equivalent either, the depth is copied to a float texture once baked
+    GLuint depthBuffer = 0;
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32F, size, size);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    /* --- Save the state changed by the baking --- */
+
+    GLint prevFramebuffer = 0;
+    GLint prevViewport[4] = { 0 };
+    GLint prevCullFace = GL_BACK;
+    GLfloat prevClearColor[4] = { 0 };
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    glGetIntegerv(GL_CULL_FACE_MODE, &prevCullFace);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, prevClearColor);
+
+    GLboolean prevCullEnabled = glIsEnabled(GL_CULL_FACE);
+    GLboolean prevDepthEnabled = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean prevBlendEnabled = glIsEnabled(GL_BLEND);
+
+    /* --- Create the working framebuffer --- */
+
+    GLuint fbo = 0;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedo, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, emission, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, normal, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, GL_TEXTURE_2D, orm, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+    GLenum drawBuffers[4] = {
+        GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1,
+        GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3
+    };
+
+    glDrawBuffers(4, drawBuffers);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        TraceLog(LOG_WARNING, "R3D: The impostor framebuffer is incomplete");
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)prevFramebuffer);
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteTextures(1, &albedo);
+        glDeleteTextures(1, &emission);
+        glDeleteTextures(1, &normal);
+        glDeleteTextures(1, &orm);
+        glDeleteRenderbuffers(1, &depthBuffer);
+        return (R3D_Impostor) { 0 };
+    }
+
+    glViewport(0, 0, size, size);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClearDepth(1.0f);
+    glDepthMask(GL_TRUE);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    /* --- Render the model from each octahedral direction --- */
+
+    float r = impostor.radius;
+    Matrix matProj = MatrixOrtho(-r, r, -r, r, 0.0f, 2.0f * r);
+
+    rlDrawRenderBatchActive();
+
+    rlMatrixMode(RL_PROJECTION);
+    rlPushMatrix();
+    rlSetMatrixProjection(matProj);
+
+    rlMatrixMode(RL_MODELVIEW);
+    rlPushMatrix();
+
+    r3d_shader_enable(raster.geometry[R3D_SHADER_GEOMETRY_BASE]);
+
+    for (int y = 0; y < frames; y++) {
+        for (int x = 0; x < frames; x++) {
+            Vector3 dir = r3d_impostor_frame_direction(x, y, frames);
+            Vector3 ref = (fabsf(dir.y) > 0.999f) ? (Vector3) { 0, 0, 1 } : (Vector3) { 0, 1, 0 };
+            Vector3 eye = Vector3Add(impostor.center, Vector3Scale(dir, r));
+
+            rlLoadIdentity();
+            rlMultMatrixf(MatrixToFloat(MatrixLookAt(eye, impostor.center, ref)));
+
+            glViewport(x * frameSize, y * frameSize, frameSize, frameSize);
+
+            for (int i = 0; i < model->meshCount; i++) {
+                const R3D_Material* material = &model->materials[model->meshMaterials[i]];
+                if (material->blendMode != R3D_BLEND_OPAQUE) continue;
+
+                r3d_drawcall_t call = { 0 };
+                call.transform = MatrixIdentity();
+                call.material = *material;
+                call.material.billboardMode = R3D_BILLBOARD_DISABLED;
+                call.geometry.model.mesh = &model->meshes[i];
+                call.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
+                call.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+                r3d_drawcall_raster_geometry(&call, R3D_SHADER_GEOMETRY_BASE);
+            }
+        }
+    }
+
+    r3d_shader_disable();
+
+    /* --- Restore state --- */
+
+    rlMatrixMode(RL_PROJECTION);
+    rlPopMatrix();
+
+    rlMatrixMode(RL_MODELVIEW);
+    rlPopMatrix();
+
+    /* --- Copy the depth to a float texture, without leaving the GPU --- */
+
+    GLuint pixelBuffer = 0;
+    glGenBuffers(1, &pixelBuffer);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)size * size * sizeof(float), NULL, GL_STREAM_COPY);
+    glReadPixels(0, 0, size, size, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+    GLuint depth = r3d_impostor_create_texture(GL_R32F, GL_RED, GL_FLOAT, size);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    glDeleteBuffers(1, &pixelBuffer);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)prevFramebuffer);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &depthBuffer);
+
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    glClearColor(prevClearColor[0], prevClearColor[1], prevClearColor[2], prevClearColor[3]);
+    glCullFace((GLenum)prevCullFace);
+
+    if (prevCullEnabled) glEnable(GL_CULL_FACE);
+    else glDisable(GL_CULL_FACE);
+
+    if (prevDepthEnabled) glEnable(GL_DEPTH_TEST);
+    else glDisable(GL_DEPTH_TEST);
+
+    if (prevBlendEnabled) glEnable(GL_BLEND);
+    else glDisable(GL_BLEND);
+
+    /* --- Fill the impostor textures --- */
+
+    impostor.albedo = r3d_impostor_texture(albedo, size, GL_RGB8);
+    impostor.emission = r3d_impostor_texture(emission, size, floatFormat);
+    impostor.normal = r3d_impostor_texture(normal, size, normalFormat);
+    impostor.orm = r3d_impostor_texture(orm, size, GL_RGB8);
+    impostor.depth = r3d_impostor_texture(depth, size, GL_R32F);
+
+    return impostor;
+}
+
+void R3D_UnloadImpostor(const R3D_Impostor* impostor)
+{
+    if (impostor == NULL) return;
+
+    if (impostor->albedo.id != 0) rlUnloadTexture(impostor->albedo.id);
+    if (impostor->emission.id != 0) rlUnloadTexture(impostor->emission.id);
+    if (impostor->normal.id != 0) rlUnloadTexture(impostor->normal.id);
+    if (impostor->orm.id != 0) rlUnloadTexture(impostor->orm.id);
+    if (impostor->depth.id != 0) rlUnloadTexture(impostor->depth.id);
+}
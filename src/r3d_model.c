@@ -2,6 +2,8 @@
 #include "r3d.h"
 
 #include "./details/r3d_primitives.h"
+#include "./details/r3d_simplify.h"
+#include "./details/r3d_anim.h"
 #include "./details/r3d_math.h"
 #include "./r3d_state.h"
 
@@ -1726,6 +1728,19 @@ R3D_Mesh R3D_GenMeshCubicmap(Image cubicmap, Vector3 cubeSize, bool upload)
     return mesh;
 }
 
+static void r3d_upload_mesh_lods(R3D_Mesh* mesh)
+{
+    for (int i = 0; i < mesh->lodCount; i++) {
+        R3D_MeshLOD* lod = &mesh->lods[i];
+        if (lod->ebo != 0 || lod->indices == NULL) continue;
+        glGenBuffers(1, &lod->ebo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod->ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, lod->indexCount * sizeof(unsigned int), lod->indices, GL_STATIC_DRAW);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
 void R3D_UnloadMesh(const R3D_Mesh* mesh)
 {
     if ((mesh)->ebo != 0) {
@@ -1742,7 +1757,18 @@ void R3D_UnloadMesh(const R3D_Mesh* mesh)
 
     RL_FREE(mesh->indices);
     RL_FREE(mesh->vertices);
-    RL_FREE(mesh->boneMatrices);
+    for (int i = 0; i < mesh->lodCount; i++) {
+        if (mesh->lods[i].ebo != 0) {
+            glDeleteBuffers(1, &mesh->lods[i].ebo);
+        }
+        RL_FREE(mesh->lods[i].indices);
+        RL_FREE(mesh->lods[i].meshlets);
+    }
+
+    RL_FREE(mesh->ranges);
+    RL_FREE(mesh->meshlets);
+    RL_FREE(mesh->lods);
+    RL_FREE(mesh->boneBounds);
 }
 
 bool R3D_UploadMesh(R3D_Mesh* mesh, bool dynamic)
@@ -1813,6 +1839,9 @@ bool R3D_UploadMesh(R3D_Mesh* mesh, bool dynamic)
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
+    // Index buffers of the levels of detail, bound at draw time
+    r3d_upload_mesh_lods(mesh);
+
     return true;
 }
 
@@ -2179,6 +2208,9 @@ static bool r3d_process_assimp_mesh(R3D_Model* model, Matrix modelMatrix, int me
                 boneVertex->boneIds[0] = 0;
             }
         }
+
+        // Bounds of each bone, so culling can follow the animations
+        R3D_GenMeshBoneBounds(mesh);
     } else {
         // No bones found for this mesh
         for (size_t i = 0; i < mesh->vertexCount; i++) {
@@ -2239,7 +2271,7 @@ static bool r3d_process_assimp_mesh(R3D_Model* model, Matrix modelMatrix, int me
 #undef CLEANUP
 }
 
-static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *model, struct aiNode *node, Matrix parentFinalTransform)
+static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *model, struct aiNode *node, Matrix parentFinalTransform, bool upload)
 {
     Matrix relativeTransform = r3d_matrix_from_ai_matrix(&node->mTransformation);
     Matrix finalTransform = r3d_matrix_multiply(&relativeTransform, &parentFinalTransform);
@@ -2255,14 +2287,516 @@ static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *mo
             meshTransform = R3D_MATRIX_IDENTITY;
         }
 
-        if (!r3d_process_assimp_mesh(model, meshTransform, node->mMeshes[i], scene->mMeshes[node->mMeshes[i]], scene, true)) {
+        if (!r3d_process_assimp_mesh(model, meshTransform, node->mMeshes[i], scene->mMeshes[node->mMeshes[i]], scene, upload)) {
             TraceLog(LOG_ERROR, "R3D: Unable to load mesh [%d]; The model will be invalid", node->mMeshes[i]);
             return false;
         }
     }
 
     for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        if(!r3d_process_assimp_meshes(scene, model, node->mChildren[i], finalTransform)) {
+        if(!r3d_process_assimp_meshes(scene, model, node->mChildren[i], finalTransform, upload)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* === Mesh Merging === */
+
+static bool r3d_merge_meshes_by_material(R3D_Model* model)
+{
+    /* --- Allocate the lookup tables --- */
+
+    int* groupIndex = RL_MALLOC(model->materialCount * sizeof(int));   //< Material -> merged mesh index
+    int* targetIndex = RL_MALLOC(model->meshCount * sizeof(int));      //< Source mesh -> new mesh index
+
+    if (groupIndex == NULL || targetIndex == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for mesh merging");
+        RL_FREE(targetIndex);
+        RL_FREE(groupIndex);
+        return false;
+    }
+
+    for (int i = 0; i < model->materialCount; i++) {
+        groupIndex[i] = -1;
+    }
+
+    /* --- Assign each source mesh to its new mesh --- */
+
+    // Skinned meshes, or meshes with an invalid material, are kept as is
+    #define IS_MERGEABLE(i) (model->meshes[i].boneCount == 0 && \
+        model->meshMaterials[i] >= 0 && model->meshMaterials[i] < model->materialCount)
+
+    int newMeshCount = 0;
+    for (int i = 0; i < model->meshCount; i++) {
+        if (!IS_MERGEABLE(i)) {
+            targetIndex[i] = newMeshCount++;
+            continue;
+        }
+        int material = model->meshMaterials[i];
+        if (groupIndex[material] < 0) {
+            groupIndex[material] = newMeshCount++;
+        }
+        targetIndex[i] = groupIndex[material];
+    }
+
+    if (newMeshCount == model->meshCount) {
+        RL_FREE(targetIndex);
+        RL_FREE(groupIndex);
+        return true;
+    }
+
+    /* --- Allocate the new mesh arrays --- */
+
+    R3D_Mesh* newMeshes = RL_CALLOC(newMeshCount, sizeof(R3D_Mesh));
+    int* newMeshMaterials = RL_CALLOC(newMeshCount, sizeof(int));
+
+    if (newMeshes == NULL || newMeshMaterials == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for mesh merging");
+        RL_FREE(newMeshMaterials);
+        RL_FREE(newMeshes);
+        RL_FREE(targetIndex);
+        RL_FREE(groupIndex);
+        return false;
+    }
+
+    /* --- Count vertices, indices and ranges of each merged mesh --- */
+
+    for (int i = 0; i < model->meshCount; i++) {
+        if (!IS_MERGEABLE(i)) continue;
+        const R3D_Mesh* src = &model->meshes[i];
+        R3D_Mesh* dst = &newMeshes[targetIndex[i]];
+        dst->vertexCount += src->vertexCount;
+        dst->indexCount += (src->indexCount > 0) ? src->indexCount : src->vertexCount;
+        dst->rangeCount++;
+    }
+
+    /* --- Allocate the buffers of each merged mesh --- */
+
+    bool allocFailed = false;
+    for (int i = 0; i < model->materialCount && !allocFailed; i++) {
+        if (groupIndex[i] < 0) continue;
+        R3D_Mesh* dst = &newMeshes[groupIndex[i]];
+        dst->vertices = RL_MALLOC(dst->vertexCount * sizeof(R3D_Vertex));
+        dst->indices = RL_MALLOC(dst->indexCount * sizeof(unsigned int));
+        dst->ranges = RL_MALLOC(dst->rangeCount * sizeof(R3D_MeshRange));
+        allocFailed = !dst->vertices || !dst->indices || !dst->ranges;
+    }
+
+    if (allocFailed) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for merged meshes");
+        for (int i = 0; i < newMeshCount; i++) {
+            RL_FREE(newMeshes[i].vertices);
+            RL_FREE(newMeshes[i].indices);
+            RL_FREE(newMeshes[i].ranges);
+        }
+        RL_FREE(newMeshMaterials);
+        RL_FREE(newMeshes);
+        RL_FREE(targetIndex);
+        RL_FREE(groupIndex);
+        return false;
+    }
+
+    for (int i = 0; i < model->materialCount; i++) {
+        if (groupIndex[i] < 0) continue;
+        R3D_Mesh* dst = &newMeshes[groupIndex[i]];
+        dst->aabb.min = (Vector3) { +FLT_MAX, +FLT_MAX, +FLT_MAX };
+        dst->aabb.max = (Vector3) { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        dst->vertexCount = 0;
+        dst->indexCount = 0;
+        dst->rangeCount = 0;
+        newMeshMaterials[groupIndex[i]] = i;
+    }
+
+    /* --- Append each source mesh to its merged mesh, or move it as is --- */
+
+    for (int i = 0; i < model->meshCount; i++) {
+        R3D_Mesh* src = &model->meshes[i];
+        R3D_Mesh* dst = &newMeshes[targetIndex[i]];
+
+        if (!IS_MERGEABLE(i)) {
+            newMeshMaterials[targetIndex[i]] = model->meshMaterials[i];
+            *dst = *src;
+            continue;
+        }
+
+        unsigned int baseVertex = (unsigned int)dst->vertexCount;
+        memcpy(dst->vertices + dst->vertexCount, src->vertices, src->vertexCount * sizeof(R3D_Vertex));
+
+        R3D_MeshRange* range = &dst->ranges[dst->rangeCount++];
+        range->indexOffset = dst->indexCount;
+        range->aabb = src->aabb;
+
+        if (src->indexCount > 0 && src->indices) {
+            for (int j = 0; j < src->indexCount; j++) {
+                dst->indices[dst->indexCount++] = baseVertex + src->indices[j];
+            }
+            range->indexCount = src->indexCount;
+        }
+        else {
+            for (int j = 0; j < src->vertexCount; j++) {
+                dst->indices[dst->indexCount++] = baseVertex + (unsigned int)j;
+            }
+            range->indexCount = src->vertexCount;
+        }
+
+        dst->vertexCount += src->vertexCount;
+        dst->aabb.min = Vector3Min(dst->aabb.min, src->aabb.min);
+        dst->aabb.max = Vector3Max(dst->aabb.max, src->aabb.max);
+
+        R3D_UnloadMesh(src);
+    }
+
+    #undef IS_MERGEABLE
+
+    /* --- Replace the model meshes --- */
+
+    TraceLog(LOG_INFO, "R3D: Merged %d meshes into %d meshes by material", model->meshCount, newMeshCount);
+
+    RL_FREE(model->meshMaterials);
+    RL_FREE(model->meshes);
+
+    model->meshes = newMeshes;
+    model->meshMaterials = newMeshMaterials;
+    model->meshCount = newMeshCount;
+
+    RL_FREE(targetIndex);
+    RL_FREE(groupIndex);
+
+    return true;
+}
+
+/* === Static Batching === */
+
+typedef struct {
+    int placement;          //< Index of the placement (model + transform)
+    int mesh;               //< Index of the mesh in the placed model
+    int material;           //< Index of the material in the batch
+    uint32_t cell;          //< Morton code of the cell containing the mesh
+    BoundingBox aabb;       //< World space bounding box of the placed mesh
+} r3d_batch_item_t;
+
+static bool r3d_batch_material_equal(const R3D_Material* a, const R3D_Material* b)
+{
+    // Compared field by field, the padding of the structure is not reliable
+    return a->albedo.texture.id == b->albedo.texture.id
+        && ColorIsEqual(a->albedo.color, b->albedo.color)
+        && a->emission.texture.id == b->emission.texture.id
+        && ColorIsEqual(a->emission.color, b->emission.color)
+        && a->emission.energy == b->emission.energy
+        && a->normal.texture.id == b->normal.texture.id
+        && a->normal.scale == b->normal.scale
+        && a->orm.texture.id == b->orm.texture.id
+        && a->orm.occlusion == b->orm.occlusion
+        && a->orm.roughness == b->orm.roughness
+        && a->orm.metalness == b->orm.metalness
+        && a->blendMode == b->blendMode
+        && a->cullMode == b->cullMode
+        && a->shadowCastMode == b->shadowCastMode
+        && a->billboardMode == b->billboardMode
+        && a->uvOffset.x == b->uvOffset.x && a->uvOffset.y == b->uvOffset.y
+        && a->uvScale.x == b->uvScale.x && a->uvScale.y == b->uvScale.y
+        && a->alphaCutoff == b->alphaCutoff;
+}
+
+static BoundingBox r3d_batch_transform_aabb(BoundingBox aabb, const Matrix* transform)
+{
+    BoundingBox result = {
+        .min = { +FLT_MAX, +FLT_MAX, +FLT_MAX },
+        .max = { -FLT_MAX, -FLT_MAX, -FLT_MAX }
+    };
+
+    for (int i = 0; i < 8; i++) {
+        Vector3 corner = {
+            (i & 1) ? aabb.max.x : aabb.min.x,
+            (i & 2) ? aabb.max.y : aabb.min.y,
+            (i & 4) ? aabb.max.z : aabb.min.z
+        };
+        corner = Vector3Transform(corner, *transform);
+        result.min = Vector3Min(result.min, corner);
+        result.max = Vector3Max(result.max, corner);
+    }
+
+    return result;
+}
+
+static uint32_t r3d_batch_morton_expand(uint32_t v)
+{
+    // Spreads the 10 lower bits of 'v' so that two zeros separate each of them
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v <<  8)) & 0x0300F00F;
+    v = (v | (v <<  4)) & 0x030C30C3;
+    v = (v | (v <<  2)) & 0x09249249;
+    return v;
+}
+
+static uint32_t r3d_batch_cell_code(Vector3 point, Vector3 origin, float cellSize)
+{
+    uint32_t c[3];
+    const float p[3] = { point.x - origin.x, point.y - origin.y, point.z - origin.z };
+
+    for (int i = 0; i < 3; i++) {
+        float v = floorf(p[i] / cellSize);
+        c[i] = (uint32_t)Clamp(v, 0.0f, 1023.0f);
+    }
+
+    return r3d_batch_morton_expand(c[0])
+        | (r3d_batch_morton_expand(c[1]) << 1)
+        | (r3d_batch_morton_expand(c[2]) << 2);
+}
+
+static int r3d_batch_item_compare(const void* a, const void* b)
+{
+    const r3d_batch_item_t* ia = a;
+    const r3d_batch_item_t* ib = b;
+
+    if (ia->material != ib->material) return (ia->material < ib->material) ? -1 : 1;
+    if (ia->cell != ib->cell) return (ia->cell < ib->cell) ? -1 : 1;
+    if (ia->placement != ib->placement) return (ia->placement < ib->placement) ? -1 : 1;
+
+    return (ia->mesh > ib->mesh) - (ia->mesh < ib->mesh);
+}
+
+static void r3d_batch_append_mesh(R3D_Mesh* dst, const R3D_Mesh* src, const Matrix* transform)
+{
+    Matrix matNormal = r3d_matrix_normal(transform);
+    unsigned int baseVertex = (unsigned int)dst->vertexCount;
+
+    // A mirroring transform flips the triangle winding and the bitangent
+    float det = MatrixDeterminant(*transform);
+    bool flip = (det < 0.0f);
+
+    for (int i = 0; i < src->vertexCount; i++) {
+        R3D_Vertex v = src->vertices[i];
+        Vector3 tangent = { v.tangent.x, v.tangent.y, v.tangent.z };
+        v.position = Vector3Transform(v.position, *transform);
+        v.normal = Vector3Normalize(Vector3Transform(v.normal, matNormal));
+        tangent = Vector3Normalize(Vector3Subtract(
+            Vector3Transform(tangent, *transform), Vector3Transform(Vector3Zero(), *transform)
+        ));
+        v.tangent = (Vector4) { tangent.x, tangent.y, tangent.z, flip ? -v.tangent.w : v.tangent.w };
+        dst->vertices[dst->vertexCount++] = v;
+    }
+
+    int count = (src->indexCount > 0 && src->indices) ? src->indexCount : src->vertexCount;
+
+    for (int i = 0; i + 2 < count; i += 3) {
+        unsigned int tri[3];
+        for (int j = 0; j < 3; j++) {
+            tri[j] = (src->indexCount > 0 && src->indices) ? src->indices[i + j] : (unsigned int)(i + j);
+        }
+        dst->indices[dst->indexCount++] = baseVertex + tri[0];
+        dst->indices[dst->indexCount++] = baseVertex + tri[flip ? 2 : 1];
+        dst->indices[dst->indexCount++] = baseVertex + tri[flip ? 1 : 2];
+    }
+}
+
+/* === Meshlet Building === */
+
+#define R3D_MESHLET_MAX_TRIANGLES 128
+
+typedef struct {
+    uint64_t key;           //< Normal bucket in the high bits, Morton code of the centroid in the low bits
+    int triangle;           //< Index of the triangle in the source index buffer
+} r3d_meshlet_tri_t;
+
+static int r3d_meshlet_tri_compare(const void* a, const void* b)
+{
+    const r3d_meshlet_tri_t* ta = a;
+    const r3d_meshlet_tri_t* tb = b;
+
+    if (ta->key != tb->key) return (ta->key < tb->key) ? -1 : 1;
+    return ta->triangle - tb->triangle;
+}
+
+static Vector3 r3d_meshlet_tri_normal(const R3D_Vertex* vertices, const unsigned int* tri)
+{
+    Vector3 e0 = Vector3Subtract(vertices[tri[1]].position, vertices[tri[0]].position);
+    Vector3 e1 = Vector3Subtract(vertices[tri[2]].position, vertices[tri[0]].position);
+    return Vector3CrossProduct(e0, e1);
+}
+
+static int r3d_meshlet_normal_bucket(Vector3 n)
+{
+    // Index of the dominant axis and its sign, in [0, 5]
+    float ax = fabsf(n.x), ay = fabsf(n.y), az = fabsf(n.z);
+    if (ax >= ay && ax >= az) return (n.x >= 0.0f) ? 0 : 1;
+    if (ay >= az) return (n.y >= 0.0f) ? 2 : 3;
+    return (n.z >= 0.0f) ? 4 : 5;
+}
+
+static void r3d_meshlet_compute_bounds(R3D_Meshlet* meshlet, const R3D_Vertex* vertices, const unsigned int* indices)
+{
+    const unsigned int* first = indices + meshlet->indexOffset;
+
+    /* --- Bounding sphere centered on the bounding box --- */
+
+    Vector3 min = vertices[first[0]].position;
+    Vector3 max = min;
+
+    for (int i = 1; i < meshlet->indexCount; i++) {
+        min = Vector3Min(min, vertices[first[i]].position);
+        max = Vector3Max(max, vertices[first[i]].position);
+    }
+
+    Vector3 center = Vector3Scale(Vector3Add(min, max), 0.5f);
+    float radiusSqr = 0.0f;
+
+    for (int i = 0; i < meshlet->indexCount; i++) {
+        radiusSqr = fmaxf(radiusSqr, Vector3DistanceSqr(center, vertices[first[i]].position));
+    }
+
+    meshlet->center = center;
+    meshlet->radius = sqrtf(radiusSqr);
+
+    /* --- Normal cone of the triangles --- */
+
+    Vector3 axis = { 0 };
+
+    for (int i = 0; i + 2 < meshlet->indexCount; i += 3) {
+        Vector3 n = r3d_meshlet_tri_normal(vertices, first + i);
+        float len = Vector3Length(n);
+        if (len > 1e-12f) axis = Vector3Add(axis, Vector3Scale(n, 1.0f / len));
+    }
+
+    float axisLen = Vector3Length(axis);
+
+    meshlet->coneAxis = (Vector3) { 0.0f, 0.0f, 1.0f };
+    meshlet->coneCutoff = 1.0f;
+
+    if (axisLen < 1e-6f) {
+        return;
+    }
+
+    axis = Vector3Scale(axis, 1.0f / axisLen);
+    float minDot = 1.0f;
+
+    for (int i = 0; i + 2 < meshlet->indexCount; i += 3) {
+        Vector3 n = r3d_meshlet_tri_normal(vertices, first + i);
+        float len = Vector3Length(n);
+        if (len > 1e-12f) minDot = fminf(minDot, Vector3DotProduct(axis, n) / len);
+    }
+
+    // A spread of 90 degrees or more means some triangles always face the viewer
+    if (minDot <= 0.0f) {
+        return;
+    }
+
+    meshlet->coneAxis = axis;
+    meshlet->coneCutoff = sqrtf(1.0f - minDot * minDot);
+}
+
+// Reorders 'indices' into meshlets, shared by the meshes and their levels of detail ('ranges' can be NULL)
+static bool r3d_build_meshlets(
+    R3D_Meshlet** outMeshlets, int* outCount,
+    const R3D_Vertex* vertices, int vertexCount,
+    unsigned int* indices, int indexCount,
+    const R3D_MeshRange* ranges, int rangeCount)
+{
+    int triCount = indexCount / 3;
+
+    // Triangles are only reordered inside their index sub-range
+    int segmentCount = (rangeCount > 0) ? rangeCount : 1;
+
+    r3d_meshlet_tri_t* tris = RL_MALLOC(triCount * sizeof(r3d_meshlet_tri_t));
+    unsigned int* sorted = RL_MALLOC(triCount * 3 * sizeof(unsigned int));
+    R3D_Meshlet* meshlets = RL_MALLOC((triCount + segmentCount) * sizeof(R3D_Meshlet));
+
+    if (!tris || !sorted || !meshlets) {
+        RL_FREE(tris);
+        RL_FREE(sorted);
+        RL_FREE(meshlets);
+        return false;
+    }
+
+    // Local bounds used to quantize the triangle centroids
+    Vector3 origin = vertices[0].position;
+    Vector3 corner = origin;
+
+    for (int i = 1; i < vertexCount; i++) {
+        origin = Vector3Min(origin, vertices[i].position);
+        corner = Vector3Max(corner, vertices[i].position);
+    }
+
+    Vector3 extent = Vector3Subtract(corner, origin);
+    float cellSize = fmaxf(fmaxf(extent.x, extent.y), fmaxf(extent.z, 1e-6f)) / 1023.0f;
+
+    int meshletCount = 0;
+
+    for (int s = 0; s < segmentCount; s++)
+    {
+        int segOffset = (rangeCount > 0) ? ranges[s].indexOffset : 0;
+        int segCount = (rangeCount > 0) ? ranges[s].indexCount : indexCount;
+        int segTris = segCount / 3;
+
+        /* --- Sort the triangles by facing direction then by location --- */
+
+        for (int t = 0; t < segTris; t++) {
+            const unsigned int* tri = indices + segOffset + 3 * t;
+            Vector3 centroid = Vector3Scale(Vector3Add(Vector3Add(
+                vertices[tri[0]].position, vertices[tri[1]].position),
+                vertices[tri[2]].position), 1.0f / 3.0f);
+
+            uint64_t bucket = (uint64_t)r3d_meshlet_normal_bucket(r3d_meshlet_tri_normal(vertices, tri));
+            uint64_t morton = (uint64_t)r3d_batch_cell_code(centroid, origin, cellSize);
+
+            tris[t].key = (bucket << 32) | morton;
+            tris[t].triangle = t;
+        }
+
+        qsort(tris, segTris, sizeof(r3d_meshlet_tri_t), r3d_meshlet_tri_compare);
+
+        for (int t = 0; t < segTris; t++) {
+            memcpy(sorted + 3 * t, indices + segOffset + 3 * tris[t].triangle, 3 * sizeof(unsigned int));
+        }
+
+        memcpy(indices + segOffset, sorted, segTris * 3 * sizeof(unsigned int));
+
+        /* --- Cut the sorted triangles into meshlets --- */
+
+        int start = 0;
+
+        for (int t = 1; t <= segTris; t++) {
+            bool split = (t == segTris)
+                || (t - start == R3D_MESHLET_MAX_TRIANGLES)
+                || ((tris[t].key >> 32) != (tris[start].key >> 32));
+
+            if (!split) continue;
+
+            R3D_Meshlet* meshlet = &meshlets[meshletCount++];
+            meshlet->indexOffset = segOffset + 3 * start;
+            meshlet->indexCount = 3 * (t - start);
+            r3d_meshlet_compute_bounds(meshlet, vertices, indices);
+
+            start = t;
+        }
+    }
+
+    RL_FREE(tris);
+    RL_FREE(sorted);
+
+    R3D_Meshlet* shrunk = RL_REALLOC(meshlets, meshletCount * sizeof(R3D_Meshlet));
+    if (shrunk != NULL) meshlets = shrunk;
+
+    RL_FREE(*outMeshlets);
+    *outMeshlets = meshlets;
+    *outCount = meshletCount;
+
+    return true;
+}
+
+// Levels of detail are clustered whenever their mesh is culled per part, their simplified
+// triangles no longer following the sub-ranges, meshlets replace them
+static bool r3d_build_mesh_lod_meshlets(R3D_Mesh* mesh)
+{
+    if (mesh->meshletCount <= 1 && mesh->rangeCount <= 1) {
+        return true;
+    }
+
+    for (int i = 0; i < mesh->lodCount; i++) {
+        R3D_MeshLOD* lod = &mesh->lods[i];
+        if (!r3d_build_meshlets(&lod->meshlets, &lod->meshletCount, mesh->vertices, mesh->vertexCount, lod->indices, lod->indexCount, NULL, 0)) {
             return false;
         }
     }
@@ -2270,6 +2804,104 @@ static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *mo
     return true;
 }
 
+static bool r3d_build_mesh_meshlets(R3D_Mesh* mesh)
+{
+    if (mesh->vertices == NULL || mesh->indices == NULL || mesh->indexCount < 3) {
+        return false;
+    }
+
+    if (!r3d_build_meshlets(
+        &mesh->meshlets, &mesh->meshletCount,
+        mesh->vertices, mesh->vertexCount,
+        mesh->indices, mesh->indexCount,
+        mesh->ranges, mesh->rangeCount)) {
+        return false;
+    }
+
+    return r3d_build_mesh_lod_meshlets(mesh);
+}
+
+#undef R3D_MESHLET_MAX_TRIANGLES
+
+/* === Level of Detail Generation === */
+
+static bool r3d_build_mesh_lods(R3D_Mesh* mesh, int lodCount)
+{
+    if (mesh->vertices == NULL || mesh->indices == NULL || mesh->indexCount < 3 || lodCount <= 0) {
+        return false;
+    }
+
+    R3D_MeshLOD* lods = RL_CALLOC(lodCount, sizeof(R3D_MeshLOD));
+    if (lods == NULL) return false;
+
+    const unsigned int* srcIndices = mesh->indices;
+    int srcCount = mesh->indexCount;
+    float srcError = 0.0f;
+    int count = 0;
+
+    while (count < lodCount)
+    {
+        unsigned int* indices = RL_MALLOC(srcCount * sizeof(unsigned int));
+        if (indices == NULL) break;
+
+        // Each level targets half of the triangles of the previous one
+        int target = (srcCount / 6) * 3;
+        float error = 0.0f;
+
+        int indexCount = r3d_simplify(
+            indices, srcIndices, srcCount,
+            mesh->vertices, mesh->vertexCount,
+            target, &error
+        );
+
+        // Stop when the mesh cannot be simplified significantly
+        if (indexCount == 0 || indexCount > srcCount * 9 / 10) {
+            RL_FREE(indices);
+            break;
+        }
+
+        unsigned int* shrunk = RL_REALLOC(indices, indexCount * sizeof(unsigned int));
+        if (shrunk != NULL) indices = shrunk;
+
+        // Errors of successive simplifications are accumulated
+        R3D_MeshLOD* lod = &lods[count++];
+        lod->indices = indices;
+        lod->indexCount = indexCount;
+        lod->error = srcError + error;
+
+        srcIndices = lod->indices;
+        srcCount = lod->indexCount;
+        srcError = lod->error;
+    }
+
+    // Release the previous levels
+    for (int i = 0; i < mesh->lodCount; i++) {
+        if (mesh->lods[i].ebo != 0) {
+            glDeleteBuffers(1, &mesh->lods[i].ebo);
+        }
+        RL_FREE(mesh->lods[i].indices);
+        RL_FREE(mesh->lods[i].meshlets);
+    }
+    RL_FREE(mesh->lods);
+
+    if (count == 0) {
+        RL_FREE(lods);
+        mesh->lods = NULL;
+        mesh->lodCount = 0;
+        return false;
+    }
+
+    mesh->lods = lods;
+    mesh->lodCount = count;
+
+    // Levels without meshlets are still drawn, only without per cluster culling
+    if (!r3d_build_mesh_lod_meshlets(mesh)) {
+        TraceLog(LOG_WARNING, "R3D: Unable to generate meshlets for the levels of detail");
+    }
+
+    return true;
+}
+
 /* === Assimp Material Processing === */
 
 static Image r3d_load_assimp_image(
@@ -2789,17 +3421,12 @@ bool r3d_process_bones_and_offsets(R3D_Model* model, const struct aiScene* scene
         return false;
     }
 
-    /* --- Pre-allocates bone matrices cache for each mesh and computes the model's maximum possible bones --- */
+    /* --- Count the bones of each mesh and computes the model's maximum possible bones --- */
 
     int maxPossibleBones = 0;
     for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
         int meshNumBones = scene->mMeshes[i]->mNumBones;
         if (meshNumBones > 0) {
-            if (meshNumBones > R3D_SHADER_MAX_BONES) {
-                TraceLog(LOG_WARNING, "R3D: Bone count (%i / %i) exceeded for mesh (IDX %i), animations may be incorrect", meshNumBones, R3D_SHADER_MAX_BONES, i);
-                meshNumBones = R3D_SHADER_MAX_BONES; //< Clamp also for 'maxPossibleBones' is incorrect, yes, but at this point, it will be anyway...
-            }
-            model->meshes[i].boneMatrices = RL_MALLOC(meshNumBones * sizeof(Matrix));
             model->meshes[i].boneCount = meshNumBones;
             maxPossibleBones += meshNumBones;
         }
@@ -2861,6 +3488,10 @@ bool r3d_process_bones_and_offsets(R3D_Model* model, const struct aiScene* scene
 
     build_hierarchy_recursive(scene->mRootNode, model->bones, model->boneCount, -1);
 
+    /* --- Allocate the state of the animation level of detail --- */
+
+    model->animCache = r3d_anim_cache_create();
+
     return true;
 }
 
@@ -3044,6 +3675,30 @@ void r3d_calculate_animation_global_transforms(
     }
 }
 
+static void r3d_find_animation_bone_parents(const struct aiNode* node, int parentBone, BoneInfo* bones, int boneCount)
+{
+    /* --- Check if this node is a bone --- */
+
+    int boneIndex = -1;
+    for (int i = 0; i < boneCount; i++) {
+        if (strcmp(node->mName.data, bones[i].name) == 0) {
+            boneIndex = i;
+            break;
+        }
+    }
+
+    if (boneIndex >= 0) {
+        bones[boneIndex].parent = parentBone;
+        parentBone = boneIndex;
+    }
+
+    /* --- Children inherit the nearest bone ancestor --- */
+
+    for (unsigned int i = 0; i < node->mNumChildren; i++) {
+        r3d_find_animation_bone_parents(node->mChildren[i], parentBone, bones, boneCount);
+    }
+}
+
 bool r3d_process_animation(R3D_ModelAnimation* animation, const struct aiScene* scene, const struct aiAnimation* aiAnim, int targetFrameRate)
 {
     /* --- Validate input --- */
@@ -3104,15 +3759,12 @@ bool r3d_process_animation(R3D_ModelAnimation* animation, const struct aiScene*
 
     animation->boneCount = boneCounter;
 
-    /* --- Allocate memory for bones and frame poses --- */
+    /* --- Allocate memory for bones --- */
 
     animation->bones = RL_CALLOC(animation->boneCount, sizeof(BoneInfo));
-    animation->framePoses = RL_CALLOC(animation->frameCount, sizeof(Matrix*));
 
-    if (!animation->bones || !animation->framePoses) {
+    if (!animation->bones) {
         TraceLog(LOG_ERROR, "R3D: Failed to allocate memory for animation data");
-        RL_FREE(animation->framePoses);
-        RL_FREE(animation->bones);
         return false;
     }
 
@@ -3139,42 +3791,91 @@ bool r3d_process_animation(R3D_ModelAnimation* animation, const struct aiScene*
         }
     }
 
-    /* --- Allocate matrices for each animation frame --- */
+    /* --- Resolve the bone hierarchy from the node tree --- */
 
-    for (int frame = 0; frame < animation->frameCount; frame++) {
-        animation->framePoses[frame] = RL_CALLOC(animation->boneCount, sizeof(Matrix));
-        if (!animation->framePoses[frame]) {
-            TraceLog(LOG_ERROR, "R3D: Failed to allocate memory for frame %d", frame);
-            for (int i = 0; i < frame; i++) RL_FREE(animation->framePoses[i]);
-            RL_FREE(animation->framePoses);
-            RL_FREE(animation->bones);
-            return false;
-        }
+    r3d_find_animation_bone_parents(scene->mRootNode, -1, animation->bones, animation->boneCount);
+
+    /* --- Clamp the frame count to what the compressed tracks can index --- */
+
+    if (animation->frameCount < 1) {
+        animation->frameCount = 1;
     }
 
-    /* --- Compute global bone transforms for each frame --- */
+    if (animation->frameCount > 65535) {
+        TraceLog(LOG_WARNING, "R3D: Animation '%s' has too many frames (%d), clamping to 65535",
+                 animation->name, animation->frameCount);
+        animation->frameCount = 65535;
+    }
+
+    /* --- Allocate the temporary global and local poses --- */
+
+    size_t poseCount = (size_t)animation->frameCount * animation->boneCount;
+
+    Matrix* globalPoses = RL_MALLOC(poseCount * sizeof(Matrix));
+    Matrix* localPoses = RL_MALLOC(poseCount * sizeof(Matrix));
+
+    if (!globalPoses || !localPoses) {
+        TraceLog(LOG_ERROR, "R3D: Failed to allocate memory for the poses of animation '%s'", animation->name);
+        RL_FREE(globalPoses);
+        RL_FREE(localPoses);
+        RL_FREE(animation->bones);
+        return false;
+    }
+
+    /* --- Compute global bone transforms for each frame --- */
 
     for (int frame = 0; frame < animation->frameCount; frame++) {
         float timeInTicks = fminf(
             ((float)frame / targetFrameRate) * ticksPerSecond,
             (float)aiAnim->mDuration);
 
+        Matrix* framePoses = &globalPoses[(size_t)frame * animation->boneCount];
+
         // Initialize all bones to identity before calculating
         for (int i = 0; i < animation->boneCount; i++) {
-            animation->framePoses[frame][i] = R3D_MATRIX_IDENTITY;
+            framePoses[i] = R3D_MATRIX_IDENTITY;
         }
 
         r3d_calculate_animation_global_transforms(
             scene->mRootNode, aiAnim, timeInTicks,
-            R3D_MATRIX_IDENTITY, animation->framePoses[frame],
+            R3D_MATRIX_IDENTITY, framePoses,
             animation->bones, animation->boneCount
         );
     }
 
+    /* --- Express each pose relative to its parent bone --- */
+
+    for (size_t i = 0; i < poseCount; i++) {
+        size_t frameBase = i - (i % animation->boneCount);
+        int parent = animation->bones[i % animation->boneCount].parent;
+        if (parent < 0) {
+            localPoses[i] = globalPoses[i];
+            continue;
+        }
+        Matrix invParent = MatrixInvert(globalPoses[frameBase + parent]);
+        localPoses[i] = r3d_matrix_multiply(&globalPoses[i], &invParent);
+    }
+
+    RL_FREE(globalPoses);
+
+    /* --- Compress the animation tracks --- */
+
+    bool compressed = r3d_anim_compress(animation, localPoses, R3D.state.loading.animTolerance);
+
+    RL_FREE(localPoses);
+
+    if (!compressed) {
+        TraceLog(LOG_ERROR, "R3D: Failed to compress animation '%s'", animation->name);
+        RL_FREE(animation->bones);
+        return false;
+    }
+
     /* --- Final success log --- */
 
-    TraceLog(LOG_INFO, "R3D: Successfully processed animation '%s' with %d bones and %d frames", 
-             animation->name, animation->boneCount, animation->frameCount);
+    TraceLog(LOG_INFO, "R3D: Successfully processed animation '%s' with %d bones and %d frames (%.1f KB, %.1f KB baked)",
+             animation->name, animation->boneCount, animation->frameCount,
+             (animation->keyDataSize * sizeof(unsigned short) + animation->boneCount * sizeof(R3D_AnimationTrack)) / 1024.0f,
+             (poseCount * sizeof(Matrix)) / 1024.0f);
 
     return true;
 }
@@ -3246,13 +3947,19 @@ static bool r3d_process_model_from_scene(R3D_Model* model, const struct aiScene*
 
     /* --- Process all meshes --- */
 
-    if (!r3d_process_assimp_meshes(scene, model, scene->mRootNode, R3D_MATRIX_IDENTITY)) {
+    // When meshes are merged or clustered, the upload is deferred until after these steps
+    bool merge = R3D.state.loading.mergeMeshes;
+    bool meshlets = R3D.state.loading.buildMeshlets;
+    int lodCount = R3D.state.loading.lodCount;
+    bool upload = !merge && !meshlets && lodCount <= 0;
+
+    if (!r3d_process_assimp_meshes(scene, model, scene->mRootNode, R3D_MATRIX_IDENTITY, upload)) {
         return false;
     }
 
     for (int i = 0; i < model->meshCount; i++) {
         if (model->meshes[i].vertexCount == 0 && model->meshes[i].indexCount == 0) {
-            if (!r3d_process_assimp_mesh(model, R3D_MATRIX_IDENTITY, i, scene->mMeshes[i], scene, true)) {
+            if (!r3d_process_assimp_mesh(model, R3D_MATRIX_IDENTITY, i, scene->mMeshes[i], scene, upload)) {
                 TraceLog(LOG_ERROR, "R3D: Unable to load mesh [%d]; The model will be invalid", i);
                 return false;
             }
@@ -3265,6 +3972,43 @@ static bool r3d_process_model_from_scene(R3D_Model* model, const struct aiScene*
         TraceLog(LOG_WARNING, "R3D: Failed to process bones, model will not be animated");
     }
 
+    /* --- Merge meshes sharing the same material --- */
+
+    if (merge) {
+        if (!r3d_merge_meshes_by_material(model)) {
+            TraceLog(LOG_WARNING, "R3D: Failed to merge meshes, they will be kept separate");
+        }
+    }
+
+    /* --- Partition meshes into meshlets --- */
+
+    if (meshlets) {
+        for (int i = 0; i < model->meshCount; i++) {
+            if (!r3d_build_mesh_meshlets(&model->meshes[i])) {
+                TraceLog(LOG_WARNING, "R3D: Unable to generate meshlets for mesh [%d]", i);
+            }
+        }
+    }
+
+    /* --- Generate levels of detail --- */
+
+    if (lodCount > 0) {
+        for (int i = 0; i < model->meshCount; i++) {
+            r3d_build_mesh_lods(&model->meshes[i], lodCount);
+        }
+    }
+
+    /* --- Upload meshes if deferred --- */
+
+    if (!upload) {
+        for (int i = 0; i < model->meshCount; i++) {
+            if (!R3D_UploadMesh(&model->meshes[i], false)) {
+                TraceLog(LOG_ERROR, "R3D: Unable to upload mesh [%d]; The model will be invalid", i);
+                return false;
+            }
+        }
+    }
+
     /* --- Calculate model bounding box --- */
 
     R3D_UpdateModelBoundingBox(model, false);
@@ -3325,6 +4069,78 @@ static R3D_ModelAnimation* r3d_process_animations_from_scene(const struct aiScen
     return animations;
 }
 
+/* === Vertex Animation Baking === */
+
+// Uploads 'vertexCount * frameCount' pairs of position and normal texels
+static R3D_VertexAnimation r3d_upload_vertex_animation(const Vector4* texels, int vertexCount, int frameCount)
+{
+    R3D_VertexAnimation vertexAnim = { 0 };
+
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+
+    size_t texelCount = 2 * (size_t)vertexCount * frameCount;
+    if (texelCount > (size_t)maxTexels) {
+        TraceLog(LOG_WARNING, "R3D: Cannot load vertex animation; %zu texels exceed the buffer texture limit of %d texels", texelCount, maxTexels);
+        return vertexAnim;
+    }
+
+    glGenBuffers(1, &vertexAnim.buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, vertexAnim.buffer);
+    glBufferData(GL_TEXTURE_BUFFER, texelCount * sizeof(Vector4), texels, GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &vertexAnim.texture);
+    glBindTexture(GL_TEXTURE_BUFFER, vertexAnim.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, vertexAnim.buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    vertexAnim.vertexCount = vertexCount;
+    vertexAnim.frameCount = frameCount;
+
+    // Positions are the even texels
+    vertexAnim.aabb.min = vertexAnim.aabb.max = (texelCount > 0) ? (Vector3) { texels[0].x, texels[0].y, texels[0].z } : Vector3Zero();
+    for (size_t i = 2; i < texelCount; i += 2) {
+        Vector3 position = { texels[i].x, texels[i].y, texels[i].z };
+        vertexAnim.aabb.min = Vector3Min(vertexAnim.aabb.min, position);
+        vertexAnim.aabb.max = Vector3Max(vertexAnim.aabb.max, position);
+    }
+
+    return vertexAnim;
+}
+
+// Skins a vertex the same way as the vertex shaders, writing its position and normal texels
+static void r3d_skin_vertex(Vector4* out, const R3D_Vertex* vertex, const Matrix* skinMatrices, int boneCount)
+{
+    Matrix m = { 0 };
+    float totalWeight = 0.0f;
+
+    for (int i = 0; i < 4; i++) {
+        int bone = vertex->boneIds[i];
+        float w = vertex->weights[i];
+        if (w <= 0.0f || bone < 0 || bone >= boneCount) continue;
+        const float* src = (const float*)&skinMatrices[bone];
+        float* dst = (float*)&m;
+        for (int j = 0; j < 16; j++) dst[j] += w * src[j];
+        totalWeight += w;
+    }
+
+    Vector3 p = vertex->position;
+    Vector3 n = vertex->normal;
+
+    if (totalWeight > 0.0f) {
+        p = Vector3Transform(p, m);
+        n = Vector3Normalize((Vector3) {
+            m.m0 * n.x + m.m4 * n.y + m.m8 * n.z,
+            m.m1 * n.x + m.m5 * n.y + m.m9 * n.z,
+            m.m2 * n.x + m.m6 * n.y + m.m10 * n.z
+        });
+    }
+
+    out[0] = (Vector4) { p.x, p.y, p.z, 1.0f };
+    out[1] = (Vector4) { n.x, n.y, n.z, 0.0f };
+}
+
 /* === Public Model Functions === */
 
 R3D_Model R3D_LoadModel(const char* filePath)
@@ -3403,6 +4219,330 @@ R3D_Model R3D_LoadModelFromMesh(const R3D_Mesh* mesh)
     return model;
 }
 
+bool R3D_GenMeshMeshlets(R3D_Mesh* mesh)
+{
+    if (mesh == NULL || mesh->indices == NULL || mesh->indexCount < 3) {
+        TraceLog(LOG_WARNING, "R3D: Cannot generate meshlets for a mesh without indices");
+        return false;
+    }
+
+    if (!r3d_build_mesh_meshlets(mesh)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for meshlets");
+        return false;
+    }
+
+    // Update the index buffers with the reordered triangles
+    if (mesh->ebo != 0) {
+        glBindVertexArray(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, mesh->indexCount * sizeof(unsigned int), mesh->indices);
+        for (int i = 0; i < mesh->lodCount; i++) {
+            if (mesh->lods[i].ebo == 0) continue;
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->lods[i].ebo);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, mesh->lods[i].indexCount * sizeof(unsigned int), mesh->lods[i].indices);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    return true;
+}
+
+bool R3D_GenMeshLODs(R3D_Mesh* mesh, int lodCount)
+{
+    if (mesh == NULL || mesh->vertices == NULL || mesh->indices == NULL || mesh->indexCount < 3) {
+        TraceLog(LOG_WARNING, "R3D: Cannot generate levels of detail for a mesh without vertices and indices");
+        return false;
+    }
+
+    if (!r3d_build_mesh_lods(mesh, lodCount)) {
+        TraceLog(LOG_WARNING, "R3D: No level of detail could be generated for the mesh");
+        return false;
+    }
+
+    if (mesh->vao != 0) {
+        glBindVertexArray(0);
+        r3d_upload_mesh_lods(mesh);
+    }
+
+    return true;
+}
+
+bool R3D_GenMeshBoneBounds(R3D_Mesh* mesh)
+{
+    if (mesh == NULL || mesh->vertices == NULL || mesh->vertexCount <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot generate bone bounds for a mesh without vertices");
+        return false;
+    }
+
+    /* --- Find the highest bone index referenced by the weights --- */
+
+    int boneCount = 0;
+    for (int i = 0; i < mesh->vertexCount; i++) {
+        const R3D_Vertex* vertex = &mesh->vertices[i];
+        for (int j = 0; j < 4; j++) {
+            if (vertex->weights[j] > 0.0f && vertex->boneIds[j] >= boneCount) {
+                boneCount = vertex->boneIds[j] + 1;
+            }
+        }
+    }
+
+    if (boneCount == 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot generate bone bounds for a mesh without bone weights");
+        return false;
+    }
+
+    /* --- Grow the bounds of every bone with the vertices it influences --- */
+
+    BoundingBox* bounds = RL_MALLOC(boneCount * sizeof(BoundingBox));
+    if (bounds == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for bone bounds");
+        return false;
+    }
+
+    for (int i = 0; i < boneCount; i++) {
+        bounds[i].min = (Vector3) { +FLT_MAX, +FLT_MAX, +FLT_MAX };
+        bounds[i].max = (Vector3) { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    }
+
+    for (int i = 0; i < mesh->vertexCount; i++) {
+        const R3D_Vertex* vertex = &mesh->vertices[i];
+        for (int j = 0; j < 4; j++) {
+            int bone = vertex->boneIds[j];
+            if (vertex->weights[j] > 0.0f && bone >= 0) {
+                bounds[bone].min = Vector3Min(bounds[bone].min, vertex->position);
+                bounds[bone].max = Vector3Max(bounds[bone].max, vertex->position);
+            }
+        }
+    }
+
+    /* --- Keep only the bones that influence the mesh --- */
+
+    int count = 0;
+    for (int i = 0; i < boneCount; i++) {
+        if (bounds[i].min.x <= bounds[i].max.x) count++;
+    }
+
+    R3D_BoneBounds* boneBounds = RL_MALLOC(count * sizeof(R3D_BoneBounds));
+    if (boneBounds == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for bone bounds");
+        RL_FREE(bounds);
+        return false;
+    }
+
+    count = 0;
+    for (int i = 0; i < boneCount; i++) {
+        if (bounds[i].min.x <= bounds[i].max.x) {
+            boneBounds[count++] = (R3D_BoneBounds) { .bone = i, .aabb = bounds[i] };
+        }
+    }
+
+    RL_FREE(bounds);
+    RL_FREE(mesh->boneBounds);
+
+    mesh->boneBounds = boneBounds;
+    mesh->boneBoundsCount = count;
+
+    return true;
+}
+
+R3D_Model R3D_LoadStaticBatch(const R3D_Model* models, const Matrix* transforms, int count, float cellSize)
+{
+    R3D_Model batch = { 0 };
+
+    if (!models || !transforms || count <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot load a static batch without placements");
+        return batch;
+    }
+
+    /* --- Allocate the items and the material list (worst case) --- */
+
+    int maxItems = 0;
+    for (int i = 0; i < count; i++) {
+        maxItems += models[i].meshCount;
+    }
+
+    r3d_batch_item_t* items = RL_MALLOC(maxItems * sizeof(r3d_batch_item_t));
+    R3D_Material* materials = RL_MALLOC(maxItems * sizeof(R3D_Material));
+
+    if (items == NULL || materials == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for static batch");
+        RL_FREE(materials);
+        RL_FREE(items);
+        return batch;
+    }
+
+    /* --- Collect the placed meshes and their unique materials --- */
+
+    int itemCount = 0;
+    int materialCount = 0;
+    int skippedCount = 0;
+
+    batch.aabb.min = (Vector3) { +FLT_MAX, +FLT_MAX, +FLT_MAX };
+    batch.aabb.max = (Vector3) { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int i = 0; i < count; i++) {
+        const R3D_Model* model = &models[i];
+        for (int j = 0; j < model->meshCount; j++) {
+            const R3D_Mesh* mesh = &model->meshes[j];
+            int matIndex = model->meshMaterials ? model->meshMaterials[j] : -1;
+
+            // Skinned, billboarded or CPU-less meshes cannot be baked in world space
+            const R3D_Material* material = (matIndex >= 0 && matIndex < model->materialCount)
+                ? &model->materials[matIndex] : NULL;
+            if (mesh->boneCount > 0 || mesh->vertices == NULL || mesh->vertexCount == 0 ||
+                (material != NULL && material->billboardMode != R3D_BILLBOARD_DISABLED)) {
+                skippedCount++;
+                continue;
+            }
+
+            R3D_Material def = R3D_GetDefaultMaterial();
+            if (material == NULL) material = &def;
+
+            int batchMaterial = 0;
+            while (batchMaterial < materialCount && !r3d_batch_material_equal(&materials[batchMaterial], material)) {
+                batchMaterial++;
+            }
+            if (batchMaterial == materialCount) {
+                materials[materialCount++] = *material;
+            }
+
+            r3d_batch_item_t* item = &items[itemCount++];
+            item->placement = i;
+            item->mesh = j;
+            item->material = batchMaterial;
+            item->aabb = r3d_batch_transform_aabb(mesh->aabb, &transforms[i]);
+
+            batch.aabb.min = Vector3Min(batch.aabb.min, item->aabb.min);
+            batch.aabb.max = Vector3Max(batch.aabb.max, item->aabb.max);
+        }
+    }
+
+    if (skippedCount > 0) {
+        TraceLog(LOG_WARNING, "R3D: %d skinned, billboarded or CPU-less meshes were skipped by the static batch", skippedCount);
+    }
+
+    if (itemCount == 0) {
+        TraceLog(LOG_WARNING, "R3D: Static batch is empty");
+        RL_FREE(materials);
+        RL_FREE(items);
+        return (R3D_Model) { 0 };
+    }
+
+    /* --- Spatially sort the placed meshes of each material --- */
+
+    // Without an explicit cell size the bounds are divided in about 16 cells along the largest axis
+    Vector3 extent = Vector3Subtract(batch.aabb.max, batch.aabb.min);
+    if (cellSize <= 0.0f) {
+        cellSize = fmaxf(fmaxf(extent.x, extent.y), extent.z) / 16.0f;
+    }
+    if (cellSize <= 0.0f) {
+        cellSize = 1.0f;
+    }
+
+    for (int i = 0; i < itemCount; i++) {
+        Vector3 center = Vector3Scale(Vector3Add(items[i].aabb.min, items[i].aabb.max), 0.5f);
+        items[i].cell = r3d_batch_cell_code(center, batch.aabb.min, cellSize);
+    }
+
+    qsort(items, itemCount, sizeof(r3d_batch_item_t), r3d_batch_item_compare);
+
+    /* --- Allocate one mesh per material --- */
+
+    batch.meshes = RL_CALLOC(materialCount, sizeof(R3D_Mesh));
+    batch.meshMaterials = RL_MALLOC(materialCount * sizeof(int));
+    batch.materials = RL_REALLOC(materials, materialCount * sizeof(R3D_Material));
+    batch.meshCount = materialCount;
+    batch.materialCount = materialCount;
+
+    if (batch.materials == NULL) {
+        batch.materials = materials;
+    }
+
+    if (batch.meshes == NULL || batch.meshMaterials == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for static batch meshes");
+        RL_FREE(batch.meshMaterials);
+        RL_FREE(batch.materials);
+        RL_FREE(batch.meshes);
+        RL_FREE(items);
+        return (R3D_Model) { 0 };
+    }
+
+    for (int i = 0; i < itemCount; i++) {
+        const R3D_Mesh* src = &models[items[i].placement].meshes[items[i].mesh];
+        R3D_Mesh* dst = &batch.meshes[items[i].material];
+        int srcCount = (src->indexCount > 0 && src->indices) ? src->indexCount : src->vertexCount;
+        dst->vertexCount += src->vertexCount;
+        dst->indexCount += srcCount - srcCount % 3;
+        if (i == 0 || items[i].material != items[i - 1].material || items[i].cell != items[i - 1].cell) {
+            dst->rangeCount++;
+        }
+    }
+
+    bool allocFailed = false;
+    for (int i = 0; i < batch.meshCount && !allocFailed; i++) {
+        R3D_Mesh* dst = &batch.meshes[i];
+        dst->vertices = RL_MALLOC(dst->vertexCount * sizeof(R3D_Vertex));
+        dst->indices = RL_MALLOC(dst->indexCount * sizeof(unsigned int));
+        dst->ranges = RL_MALLOC(dst->rangeCount * sizeof(R3D_MeshRange));
+        allocFailed = !dst->vertices || !dst->indices || !dst->ranges;
+        dst->aabb.min = (Vector3) { +FLT_MAX, +FLT_MAX, +FLT_MAX };
+        dst->aabb.max = (Vector3) { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        dst->vertexCount = 0;
+        dst->indexCount = 0;
+        dst->rangeCount = 0;
+        batch.meshMaterials[i] = i;
+    }
+
+    if (allocFailed) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for static batch meshes");
+        R3D_UnloadModel(&batch, false);
+        RL_FREE(items);
+        return (R3D_Model) { 0 };
+    }
+
+    /* --- Bake the placed meshes in world space, one range per cell --- */
+
+    for (int i = 0; i < itemCount; i++) {
+        const r3d_batch_item_t* item = &items[i];
+        R3D_Mesh* dst = &batch.meshes[item->material];
+
+        if (i == 0 || item->material != items[i - 1].material || item->cell != items[i - 1].cell) {
+            R3D_MeshRange* range = &dst->ranges[dst->rangeCount++];
+            range->indexOffset = dst->indexCount;
+            range->indexCount = 0;
+            range->aabb = item->aabb;
+        }
+
+        R3D_MeshRange* range = &dst->ranges[dst->rangeCount - 1];
+        int indexStart = dst->indexCount;
+
+        r3d_batch_append_mesh(dst, &models[item->placement].meshes[item->mesh], &transforms[item->placement]);
+
+        range->indexCount += dst->indexCount - indexStart;
+        range->aabb.min = Vector3Min(range->aabb.min, item->aabb.min);
+        range->aabb.max = Vector3Max(range->aabb.max, item->aabb.max);
+
+        dst->aabb.min = Vector3Min(dst->aabb.min, item->aabb.min);
+        dst->aabb.max = Vector3Max(dst->aabb.max, item->aabb.max);
+    }
+
+    RL_FREE(items);
+
+    /* --- Upload the batched meshes --- */
+
+    for (int i = 0; i < batch.meshCount; i++) {
+        if (!R3D_UploadMesh(&batch.meshes[i], false)) {
+            TraceLog(LOG_ERROR, "R3D: Unable to upload static batch mesh %d", i);
+            R3D_UnloadModel(&batch, false);
+            return (R3D_Model) { 0 };
+        }
+    }
+
+    TraceLog(LOG_INFO, "R3D: Static batch built from %d placements (%d meshes in %d materials)", count, itemCount, materialCount);
+
+    return batch;
+}
+
 void R3D_UnloadModel(const R3D_Model* model, bool unloadMaterials)
 {
     for (int i = 0; i < model->meshCount; i++) {
@@ -3421,6 +4561,8 @@ void R3D_UnloadModel(const R3D_Model* model, bool unloadMaterials)
 
     RL_FREE(model->boneOffsets);
     RL_FREE(model->bones);
+
+    r3d_anim_cache_destroy(model->animCache);
 }
 
 void R3D_UpdateModelBoundingBox(R3D_Model* model, bool updateMeshBoundingBoxes)
@@ -3493,11 +4635,12 @@ void R3D_UnloadModelAnimations(R3D_ModelAnimation* animations, int animCount)
     for (int i = 0; i < animCount; i++) {
         R3D_ModelAnimation* anim = &animations[i];
         
-        // Free frame poses
-        if (anim->framePoses) {
-            for (int frame = 0; frame < anim->frameCount; frame++) {
-                RL_FREE(anim->framePoses[frame]);
-            }
+        // Free compressed tracks
+        r3d_anim_release(anim);
+
+        // Free materialized poses, see 'R3D_LoadModelAnimationFramePoses'
+        if (anim->framePoses != NULL) {
+            RL_FREE(anim->framePoses[0]);
             RL_FREE(anim->framePoses);
         }
         
@@ -3535,7 +4678,335 @@ void R3D_ListModelAnimations(R3D_ModelAnimation* animations, int animCount)
     }
 }
 
+void R3D_GetModelAnimationPose(const R3D_ModelAnimation* anim, int frame, Matrix* poses)
+{
+    R3D_SampleModelAnimationPose(anim, (float)frame, poses);
+}
+
+void R3D_SampleModelAnimationPose(const R3D_ModelAnimation* anim, float frame, Matrix* poses)
+{
+    if (!anim || !poses || anim->frameCount <= 0) return;
+
+    r3d_anim_sample_poses(anim, r3d_anim_wrap_frame(anim, frame), true, poses);
+}
+
+bool R3D_LoadModelAnimationFramePoses(R3D_ModelAnimation* anim)
+{
+    if (!anim || anim->frameCount <= 0 || anim->boneCount <= 0) return false;
+    if (anim->framePoses != NULL) return true;
+
+    // Frames point into a single block of 'frameCount * boneCount' matrices
+    Matrix** frames = RL_MALLOC(anim->frameCount * sizeof(Matrix*));
+    Matrix* poses = RL_MALLOC((size_t)anim->frameCount * anim->boneCount * sizeof(Matrix));
+
+    if (!frames || !poses) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for the frame poses of animation '%s'", anim->name);
+        RL_FREE(frames);
+        RL_FREE(poses);
+        return false;
+    }
+
+    for (int i = 0; i < anim->frameCount; i++) {
+        frames[i] = poses + (size_t)i * anim->boneCount;
+        r3d_anim_sample_poses(anim, (float)i, false, frames[i]);
+    }
+
+    anim->framePoses = frames;
+
+    return true;
+}
+
+void R3D_SampleModelAnimation(const R3D_ModelAnimation* anim, float frame, Transform* locals)
+{
+    if (!anim || !locals) return;
+
+    R3D_AnimationLayer layer = {
+        .anim = anim,
+        .frame = frame,
+        .weight = 1.0f
+    };
+
+    R3D_BlendModelAnimations(&layer, 1, locals);
+}
+
+void R3D_BlendModelAnimations(const R3D_AnimationLayer* layers, int layerCount, Transform* locals)
+{
+    if (!layers || layerCount <= 0 || !layers[0].anim || !locals) return;
+
+    int boneCount = layers[0].anim->boneCount;
+
+    r3d_anim_transform_t* blended = RL_MALLOC(boneCount * sizeof(r3d_anim_transform_t));
+    if (!blended) return;
+
+    if (r3d_anim_blend_local(layers, layerCount, blended)) {
+        for (int i = 0; i < boneCount; i++) {
+            const r3d_anim_transform_t* t = &blended[i];
+            locals[i].translation = (Vector3) { t->translation[0], t->translation[1], t->translation[2] };
+            locals[i].rotation = (Quaternion) { t->rotation[0], t->rotation[1], t->rotation[2], t->rotation[3] };
+            locals[i].scale = (Vector3) { t->scale[0], t->scale[1], t->scale[2] };
+        }
+    }
+
+    RL_FREE(blended);
+}
+
+void R3D_GetModelAnimationBlendPose(const R3D_AnimationLayer* layers, int layerCount, Matrix* poses)
+{
+    if (!layers || layerCount <= 0 || !layers[0].anim || !poses) return;
+
+    r3d_anim_blend_poses(layers, layerCount, poses);
+}
+
+// Grows 'aabb' to the skinned meshes of a model, the meshes without bone bounds keeping their bind pose bounds
+static void r3d_grow_skinned_model_aabb(BoundingBox* aabb, const R3D_Model* model, const Matrix* skinMatrices)
+{
+    for (int i = 0; i < model->meshCount; i++)
+    {
+        BoundingBox moved = r3d_anim_skinned_mesh_aabb(&model->meshes[i], skinMatrices, model->boneCount);
+        aabb->min = Vector3Min(aabb->min, moved.min);
+        aabb->max = Vector3Max(aabb->max, moved.max);
+    }
+}
+
+R3D_AnimationTexture R3D_LoadAnimationTexture(const R3D_Model* model, const R3D_ModelAnimation* animations, int animCount)
+{
+    R3D_AnimationTexture animTex = { 0 };
+
+    if (!model || !model->boneOffsets || model->boneCount <= 0 || !animations || animCount <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot bake animation texture; Invalid model or animations");
+        return animTex;
+    }
+
+    /* --- Lay out the clips one after the other --- */
+
+    int* clipFirstFrames = RL_MALLOC(animCount * sizeof(int));
+    int* clipFrameCounts = RL_MALLOC(animCount * sizeof(int));
+
+    size_t frameCount = 0;
+    for (int i = 0; i < animCount; i++) {
+        clipFirstFrames[i] = (int)frameCount;
+        clipFrameCounts[i] = (animations[i].frameCount > 0) ? animations[i].frameCount : 1;
+        frameCount += clipFrameCounts[i];
+    }
+
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+
+    size_t matrixCount = frameCount * model->boneCount;
+    if (matrixCount * R3D_ANIM_BONE_TEXELS > (size_t)maxTexels) {
+        TraceLog(LOG_WARNING, "R3D: Cannot bake animation texture; %zu matrices exceed the buffer texture limit of %d texels", matrixCount, maxTexels);
+        RL_FREE(clipFirstFrames);
+        RL_FREE(clipFrameCounts);
+        return animTex;
+    }
+
+    Matrix* matrices = RL_MALLOC(matrixCount * sizeof(Matrix));
+    if (!matrices) {
+        TraceLog(LOG_WARNING, "R3D: Cannot bake animation texture; Out of memory");
+        RL_FREE(clipFirstFrames);
+        RL_FREE(clipFrameCounts);
+        return animTex;
+    }
+
+    /* --- Sample every frame of every clip --- */
+
+    BoundingBox aabb = {
+        .min = { +FLT_MAX, +FLT_MAX, +FLT_MAX },
+        .max = { -FLT_MAX, -FLT_MAX, -FLT_MAX }
+    };
+
+    for (int i = 0; i < animCount; i++)
+    {
+        const R3D_ModelAnimation* anim = &animations[i];
+        Matrix* clip = matrices + (size_t)clipFirstFrames[i] * model->boneCount;
+
+        if (anim->boneCount != model->boneCount || anim->frameCount <= 0) {
+            TraceLog(LOG_WARNING, "R3D: Animation '%s' does not match the skeleton of the model; Baked in bind pose", anim->name);
+            for (int b = 0; b < clipFrameCounts[i] * model->boneCount; b++) {
+                clip[b] = R3D_MATRIX_IDENTITY;
+            }
+            r3d_grow_skinned_model_aabb(&aabb, model, clip);
+            continue;
+        }
+
+        for (int f = 0; f < anim->frameCount; f++) {
+            Matrix* poses = clip + (size_t)f * model->boneCount;
+            r3d_anim_sample_poses(anim, (float)f, false, poses);
+            for (int b = 0; b < model->boneCount; b++) {
+                poses[b] = r3d_matrix_multiply(&model->boneOffsets[b], &poses[b]);
+            }
+            r3d_grow_skinned_model_aabb(&aabb, model, poses);
+        }
+    }
+
+    /* --- Upload the matrices, packed in place as 3x4 rows --- */
+
+    size_t size = r3d_anim_pack_bones(matrices, matrixCount, false, matrices);
+
+    glGenBuffers(1, &animTex.buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, animTex.buffer);
+    glBufferData(GL_TEXTURE_BUFFER, size, matrices, GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &animTex.texture);
+    glBindTexture(GL_TEXTURE_BUFFER, animTex.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, animTex.buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    RL_FREE(matrices);
+
+    animTex.boneCount = model->boneCount;
+    animTex.frameCount = (int)frameCount;
+    animTex.clipCount = animCount;
+    animTex.clipFirstFrames = clipFirstFrames;
+    animTex.clipFrameCounts = clipFrameCounts;
+    animTex.aabb = (aabb.min.x <= aabb.max.x) ? aabb : model->aabb;
+
+    return animTex;
+}
+
+void R3D_UnloadAnimationTexture(R3D_AnimationTexture* animTexture)
+{
+    if (!animTexture) return;
+
+    if (animTexture->texture != 0) {
+        glDeleteTextures(1, &animTexture->texture);
+    }
+    if (animTexture->buffer != 0) {
+        glDeleteBuffers(1, &animTexture->buffer);
+    }
+
+    RL_FREE(animTexture->clipFirstFrames);
+    RL_FREE(animTexture->clipFrameCounts);
+
+    *animTexture = (R3D_AnimationTexture) { 0 };
+}
+
+R3D_VertexAnimation R3D_BakeVertexAnimation(const R3D_Model* model, const R3D_ModelAnimation* anim)
+{
+    R3D_VertexAnimation vertexAnim = { 0 };
+
+    if (!model || !model->boneOffsets || !anim || anim->frameCount <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot bake vertex animation; Invalid model or animation");
+        return vertexAnim;
+    }
+
+    if (anim->boneCount != model->boneCount) {
+        TraceLog(LOG_WARNING, "R3D: Cannot bake vertex animation; Animation '%s' does not match the skeleton of the model", anim->name);
+        return vertexAnim;
+    }
+
+    int vertexCount = 0;
+    for (int i = 0; i < model->meshCount; i++) {
+        if (!model->meshes[i].vertices) {
+            TraceLog(LOG_WARNING, "R3D: Cannot bake vertex animation; Mesh %d has no vertices on the CPU", i);
+            return vertexAnim;
+        }
+        vertexCount += model->meshes[i].vertexCount;
+    }
+
+    size_t texelCount = 2 * (size_t)vertexCount * anim->frameCount;
+    Vector4* texels = RL_MALLOC(texelCount * sizeof(Vector4));
+    Matrix* skinMatrices = RL_MALLOC(model->boneCount * sizeof(Matrix));
+
+    if (!texels || !skinMatrices) {
+        TraceLog(LOG_WARNING, "R3D: Cannot bake vertex animation; Out of memory");
+        RL_FREE(texels);
+        RL_FREE(skinMatrices);
+        return vertexAnim;
+    }
+
+    /* --- Skin every vertex of every frame --- */
+
+    Vector4* dst = texels;
+
+    for (int f = 0; f < anim->frameCount; f++)
+    {
+        r3d_anim_sample_poses(anim, (float)f, false, skinMatrices);
+        for (int b = 0; b < model->boneCount; b++) {
+            skinMatrices[b] = r3d_matrix_multiply(&model->boneOffsets[b], &skinMatrices[b]);
+        }
+
+        for (int i = 0; i < model->meshCount; i++) {
+            const R3D_Mesh* mesh = &model->meshes[i];
+            for (int v = 0; v < mesh->vertexCount; v++, dst += 2) {
+                r3d_skin_vertex(dst, &mesh->vertices[v], skinMatrices, model->boneCount);
+            }
+        }
+    }
+
+    vertexAnim = r3d_upload_vertex_animation(texels, vertexCount, anim->frameCount);
+
+    RL_FREE(skinMatrices);
+    RL_FREE(texels);
+
+    return vertexAnim;
+}
+
+R3D_VertexAnimation R3D_LoadVertexAnimation(const Vector3* positions, const Vector3* normals, int vertexCount, int frameCount)
+{
+    R3D_VertexAnimation vertexAnim = { 0 };
+
+    if (!positions || !normals || vertexCount <= 0 || frameCount <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Cannot load vertex animation; Invalid vertex data");
+        return vertexAnim;
+    }
+
+    size_t count = (size_t)vertexCount * frameCount;
+    Vector4* texels = RL_MALLOC(2 * count * sizeof(Vector4));
+
+    if (!texels) {
+        TraceLog(LOG_WARNING, "R3D: Cannot load vertex animation; Out of memory");
+        return vertexAnim;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        texels[2 * i + 0] = (Vector4) { positions[i].x, positions[i].y, positions[i].z, 1.0f };
+        texels[2 * i + 1] = (Vector4) { normals[i].x, normals[i].y, normals[i].z, 0.0f };
+    }
+
+    vertexAnim = r3d_upload_vertex_animation(texels, vertexCount, frameCount);
+
+    RL_FREE(texels);
+
+    return vertexAnim;
+}
+
+void R3D_UnloadVertexAnimation(R3D_VertexAnimation* vertexAnim)
+{
+    if (!vertexAnim) return;
+
+    if (vertexAnim->texture != 0) {
+        glDeleteTextures(1, &vertexAnim->texture);
+    }
+    if (vertexAnim->buffer != 0) {
+        glDeleteBuffers(1, &vertexAnim->buffer);
+    }
+
+    *vertexAnim = (R3D_VertexAnimation) { 0 };
+}
+
 void R3D_SetModelImportScale(float value)
 {
     aiSetImportPropertyFloat(R3D.state.loading.aiProps, AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, value);
 }
+
+void R3D_SetModelImportMergeMeshes(bool enabled)
+{
+    R3D.state.loading.mergeMeshes = enabled;
+}
+
+void R3D_SetModelImportMeshlets(bool enabled)
+{
+    R3D.state.loading.buildMeshlets = enabled;
+}
+
+void R3D_SetModelImportLODs(int lodCount)
+{
+    R3D.state.loading.lodCount = (lodCount > 0) ? lodCount : 0;
+}
+
+void R3D_SetModelImportAnimationTolerance(float tolerance)
+{
+    R3D.state.loading.animTolerance = (tolerance > 0.0f) ? tolerance : 0.0f;
+}
@@ -1,50 +1,227 @@
+#include "details/r3d_particle_gpu.h"
+#include "details/r3d_particle.h"
+#include "details/r3d_curve.h"
 #include "details/r3d_math.h"
 #include "r3d.h"
 
 #include <math.h>
 #include <float.h>
 #include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <raylib.h>
 #include <raymath.h>
 
+/* Internal constants */
+
+#define R3D_PARTICLE_CHUNK_SIZE 256
+
 /* Helper functions */
 
-static float r3d_randf(void)
+static unsigned int r3d_rand(R3D_ParticleSystem* system)
 {
-    static const float INV_65535 = 1.0f / 0xFFFF;
-    return (float)GetRandomValue(0, 0xFFFF) * INV_65535;
+    // Counter-based generator: each number only depends on the seed and its index,
+    // which keeps every system reproducible whatever the thread updating it
+    uint64_t x = ((uint64_t)system->seed << 32) | system->randomCounter++;
+
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x = x ^ (x >> 31);
+
+    return (unsigned int)(x >> 32);
 }
 
-static float r3d_randf_range(float min, float max)
+static float r3d_randf(R3D_ParticleSystem* system)
 {
-    return min + r3d_randf() * (max - min);
+    static const float INV_16777215 = 1.0f / 0xFFFFFF;
+    return (float)(r3d_rand(system) >> 8) * INV_16777215;
 }
 
-static float r3d_min3f(float a, float b, float c)
+static float r3d_randf_range(R3D_ParticleSystem* system, float min, float max)
 {
-    float min = a;
-    if (b < min) min = b;
-    if (c < min) min = c;
-    return min;
+    return min + r3d_randf(system) * (max - min);
 }
 
-static float r3d_max3f(float a, float b, float c)
+static int r3d_randi_range(R3D_ParticleSystem* system, int min, int max)
 {
-    float max = a;
-    if (b > max) max = b;
-    if (c > max) max = c;
-    return max;
+    return min + (int)(r3d_rand(system) % (unsigned int)(max - min + 1));
 }
 
-/* Public functions */
+// Largest absolute value reached by the factors of a curve, or 1 without a curve
+static float r3d_particle_curve_max_abs(const R3D_InterpolationCurve* curve)
+{
+    if (curve == NULL) return 1.0f;
 
-R3D_ParticleSystem R3D_LoadParticleSystem(int maxParticles)
+    float lo, hi;
+    r3d_curve_range(curve, &lo, &hi);
+
+    return fmaxf(fabsf(lo), fabsf(hi));
+}
+
+// Range of the displacement of a particle along one axis over its lifetime 'L', from the range
+// [vlo, vhi] of its emission velocity. With a speed curve the velocity is reset to the scaled
+// base velocity on each update, so gravity never accumulates. Otherwise the gravity term of the
+// step integration lies between zero and 'g * t^2 / 2', and every extremum is at t = 0 or t = L.
+static void r3d_particle_axis_range(float vlo, float vhi, float g, float L, float fmin, float fmax, bool speedCurve, float* outMin, float* outMax)
+{
+    if (speedCurve) {
+        float products[4] = { vlo * fmin, vlo * fmax, vhi * fmin, vhi * fmax };
+        float lo = products[0], hi = products[0];
+        for (int i = 1; i < 4; i++) {
+            lo = fminf(lo, products[i]);
+            hi = fmaxf(hi, products[i]);
+        }
+        *outMin = fminf(0.0f, lo * L);
+        *outMax = fmaxf(0.0f, hi * L);
+        return;
+    }
+
+    float gravity = 0.5f * g * L * L;
+
+    *outMin = fminf(0.0f, vlo * L + fminf(0.0f, gravity));
+    *outMax = fmaxf(0.0f, vhi * L + fmaxf(0.0f, gravity));
+}
+
+// Integrates the positions while gathering their bounds, and the largest scale
+static void r3d_particle_update_bounds(R3D_ParticleSystem* system, float deltaTime)
+{
+    R3D_Particles* particles = &system->particles;
+    int count = system->count;
+
+    if (count == 0) {
+        system->aabb = (BoundingBox) { system->position, system->position };
+        system->maxScale = 0.0f;
+        return;
+    }
+
+    Vector3 aabbMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    Vector3 aabbMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    r3d_particle_madd_range(particles->position.x, particles->velocity.x, deltaTime, 1.0f, count, &aabbMin.x, &aabbMax.x);
+    r3d_particle_madd_range(particles->position.y, particles->velocity.y, deltaTime, 1.0f, count, &aabbMin.y, &aabbMax.y);
+    r3d_particle_madd_range(particles->position.z, particles->velocity.z, deltaTime, 1.0f, count, &aabbMin.z, &aabbMax.z);
+
+    Vector3 scaleMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    Vector3 scaleMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    r3d_particle_range(particles->scale.x, count, &scaleMin.x, &scaleMax.x);
+    r3d_particle_range(particles->scale.y, count, &scaleMin.y, &scaleMax.y);
+    r3d_particle_range(particles->scale.z, count, &scaleMin.z, &scaleMax.z);
+
+    system->aabb = (BoundingBox) { aabbMin, aabbMax };
+    system->maxScale = fmaxf(
+        fmaxf(fmaxf(-scaleMin.x, scaleMax.x), fmaxf(-scaleMin.y, scaleMax.y)),
+        fmaxf(-scaleMin.z, scaleMax.z)
+    );
+}
+
+// Derives the bound of every particle the system can emit from anywhere between 'originMin' and 'originMax'
+static void r3d_particle_system_bounds(R3D_ParticleSystem* system, Vector3 originMin, Vector3 originMax)
+{
+    /* --- Range of the emission direction along each axis, within the spread cone --- */
+
+    float speed = Vector3Length(system->initialVelocity);
+    Vector3 direction = (speed > 0.0f) ? Vector3Scale(system->initialVelocity, 1.0f / speed) : (Vector3) { 0 };
+    float spread = Clamp(system->spreadAngle * DEG2RAD, 0.0f, PI);
+
+    // The angle to an axis of the directions within the cone lies within the angle of its
+    // center to this axis plus or minus the spread, and so does their component on this axis
+    float directionMin[3], directionMax[3];
+    const float center[3] = { direction.x, direction.y, direction.z };
+
+    for (int axis = 0; axis < 3; axis++) {
+        float angle = acosf(Clamp(center[axis], -1.0f, 1.0f));
+        directionMin[axis] = cosf(fminf(PI, angle + spread));
+        directionMax[axis] = cosf(fmaxf(0.0f, angle - spread));
+    }
+
+    /* --- Displacement over the longest lifetime --- */
+
+    float lifetime = fmaxf(0.0f, system->lifetime + fabsf(system->lifetimeVariance));
+
+    float speedMin = 1.0f, speedMax = 1.0f;
+    if (system->speedOverLifetime) {
+        r3d_curve_range(system->speedOverLifetime, &speedMin, &speedMax);
+    }
+
+    const float variance[3] = { system->velocityVariance.x, system->velocityVariance.y, system->velocityVariance.z };
+    const float gravity[3] = { system->gravity.x, system->gravity.y, system->gravity.z };
+    const float originLo[3] = { originMin.x, originMin.y, originMin.z };
+    const float originHi[3] = { originMax.x, originMax.y, originMax.z };
+
+    float aabbMin[3], aabbMax[3];
+
+    for (int axis = 0; axis < 3; axis++) {
+        float vlo = speed * directionMin[axis] - fabsf(variance[axis]);
+        float vhi = speed * directionMax[axis] + fabsf(variance[axis]);
+        r3d_particle_axis_range(vlo, vhi, gravity[axis], lifetime, speedMin, speedMax,
+                                system->speedOverLifetime != NULL, &aabbMin[axis], &aabbMax[axis]);
+        aabbMin[axis] += originLo[axis];
+        aabbMax[axis] += originHi[axis];
+    }
+
+    system->aabb = (BoundingBox) {
+        { aabbMin[0], aabbMin[1], aabbMin[2] },
+        { aabbMax[0], aabbMax[1], aabbMax[2] }
+    };
+
+    /* --- Largest scale, the scale variance being shared by the three axes --- */
+
+    float scale = fmaxf(fabsf(system->initialScale.x), fmaxf(fabsf(system->initialScale.y), fabsf(system->initialScale.z)));
+    system->maxScale = (scale + fabsf(system->scaleVariance)) * r3d_particle_curve_max_abs(system->scaleOverLifetime);
+}
+
+// Gathers the positions of the emitter over the current window and keeps those of the previous one,
+// a window lasting the longest lifetime so that the two always cover the origin of every alive particle
+static void r3d_particle_gpu_track_origin(R3D_ParticleSystem* system, float deltaTime)
+{
+    R3D_ParticleGPU* gpu = system->gpu;
+    float lifetime = fmaxf(0.0f, system->lifetime + fabsf(system->lifetimeVariance));
+
+    if (gpu->originTime < 0.0f) {
+        gpu->origins[0] = gpu->origins[1] = (BoundingBox) { system->position, system->position };
+        gpu->originTime = 0.0f;
+        return;
+    }
+
+    gpu->originTime += deltaTime;
+
+    if (gpu->originTime >= lifetime) {
+        gpu->origins[1] = gpu->origins[0];
+        gpu->origins[0] = (BoundingBox) { system->position, system->position };
+        gpu->originTime = 0.0f;
+        return;
+    }
+
+    gpu->origins[0].min = Vector3Min(gpu->origins[0].min, system->position);
+    gpu->origins[0].max = Vector3Max(gpu->origins[0].max, system->position);
+}
+
+static void r3d_particle_eval_curve(const R3D_InterpolationCurve* curve, const float* progress, float* factors, int count)
+{
+    const float* lut = r3d_curve_get_lut(curve);
+    if (lut != NULL) {
+        r3d_particle_sample_curve(factors, lut, progress, count);
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        factors[i] = R3D_EvaluateCurve(*curve, progress[i]);
+    }
+}
+
+static void r3d_particle_mul_vec3(R3D_Vector3Array* dst, const R3D_Vector3Array* base, const float* factors, int first, int count)
+{
+    r3d_particle_mul(dst->x + first, base->x + first, factors, count);
+    r3d_particle_mul(dst->y + first, base->y + first, factors, count);
+    r3d_particle_mul(dst->z + first, base->z + first, factors, count);
+}
+
+static R3D_ParticleSystem r3d_particle_system_defaults(int maxParticles)
 {
     R3D_ParticleSystem system = { 0 };
 
-    system.particles = RL_MALLOC(sizeof(R3D_Particle) * maxParticles);
     system.capacity = maxParticles;
     system.count = 0;
 
@@ -83,20 +260,68 @@ R3D_ParticleSystem R3D_LoadParticleSystem(int maxParticles)
         .max = (Vector3) { +FLT_MAX, +FLT_MAX, +FLT_MAX }
     };
 
+    system.maxScale = 0.0f;
+    system.autoBoundingBox = true;
+
     system.autoEmission = true;
 
+    system.seed = (unsigned int)GetRandomValue(0, INT_MAX);
+    system.randomCounter = 0;
+
+    return system;
+}
+
+/* Public functions */
+
+R3D_ParticleSystem R3D_LoadParticleSystem(int maxParticles)
+{
+    R3D_Particles particles = { 0 };
+
+    if (!r3d_particle_storage_create(&particles, maxParticles)) {
+        TraceLog(LOG_ERROR, "R3D: Failed to allocate the storage of %d particles", maxParticles);
+        maxParticles = 0;
+    }
+
+    R3D_ParticleSystem system = r3d_particle_system_defaults(maxParticles);
+    system.particles = particles;
+
+    return system;
+}
+
+R3D_ParticleSystem R3D_LoadParticleSystemGPU(int maxParticles)
+{
+    R3D_ParticleGPU* gpu = r3d_particle_gpu_create(maxParticles);
+
+    if (gpu == NULL) {
+        TraceLog(LOG_WARNING, "R3D: Failed to create the GPU simulation of %d particles; Falling back to the CPU", maxParticles);
+        return R3D_LoadParticleSystem(maxParticles);
+    }
+
+    R3D_ParticleSystem system = r3d_particle_system_defaults(maxParticles);
+    system.gpu = gpu;
+
     return system;
 }
 
 void R3D_UnloadParticleSystem(R3D_ParticleSystem* system)
 {
     if (system) {
-        RL_FREE(system->particles);
+        r3d_particle_gpu_destroy(system->gpu);
+        r3d_particle_storage_destroy(&system->particles);
+        system->gpu = NULL;
+        system->capacity = 0;
+        system->count = 0;
     }
 }
 
 bool R3D_EmitParticle(R3D_ParticleSystem* system)
 {
+    if (system->gpu) {
+        if (system->gpu->alive + system->gpu->pending >= system->capacity) return false;
+        system->gpu->pending++;
+        return true;
+    }
+
     if (system->count >= system->capacity) {
         return false;
     }
@@ -105,8 +330,8 @@ bool R3D_EmitParticle(R3D_ParticleSystem* system)
     Vector3 direction = Vector3Normalize(system->initialVelocity);
 
     // Generate random angles
-    float elevation = r3d_randf_range(0, system->spreadAngle * DEG2RAD);
-    float azimuth = r3d_randf_range(0, 2.0f * PI);
+    float elevation = r3d_randf_range(system, 0, system->spreadAngle * DEG2RAD);
+    float azimuth = r3d_randf_range(system, 0, 2.0f * PI);
 
     // Precompute trigonometric values for the cone
     float cosElevation = cosf(elevation);
@@ -139,50 +364,53 @@ bool R3D_EmitParticle(R3D_ParticleSystem* system)
     // Scale the final velocity
     velocity = Vector3Scale(velocity, Vector3Length(system->initialVelocity));
 
-    // Initialize particle
-    R3D_Particle particle = { 0 };
+    // Initialize the particle at the end of the arrays
+    R3D_Particles* particles = &system->particles;
+    int i = system->count++;
 
-    particle.lifetime = system->lifetime + r3d_randf_range(-system->lifetimeVariance, system->lifetimeVariance);
+    particles->lifetime[i] = system->lifetime + r3d_randf_range(system, -system->lifetimeVariance, system->lifetimeVariance);
 
-    particle.position = system->position;
+    particles->position.x[i] = system->position.x;
+    particles->position.y[i] = system->position.y;
+    particles->position.z[i] = system->position.z;
 
-    particle.rotation = (Vector3){
-        (system->initialRotation.x + r3d_randf_range(-system->rotationVariance.x, system->rotationVariance.x)) * DEG2RAD,
-        (system->initialRotation.y + r3d_randf_range(-system->rotationVariance.y, system->rotationVariance.y)) * DEG2RAD,
-        (system->initialRotation.z + r3d_randf_range(-system->rotationVariance.z, system->rotationVariance.z)) * DEG2RAD
-    };
+    particles->rotation.x[i] = (system->initialRotation.x + r3d_randf_range(system, -system->rotationVariance.x, system->rotationVariance.x)) * DEG2RAD;
+    particles->rotation.y[i] = (system->initialRotation.y + r3d_randf_range(system, -system->rotationVariance.y, system->rotationVariance.y)) * DEG2RAD;
+    particles->rotation.z[i] = (system->initialRotation.z + r3d_randf_range(system, -system->rotationVariance.z, system->rotationVariance.z)) * DEG2RAD;
 
-    particle.scale = particle.baseScale = Vector3AddValue(
-        system->initialScale, r3d_randf_range(-system->scaleVariance, system->scaleVariance)
+    Vector3 scale = Vector3AddValue(
+        system->initialScale, r3d_randf_range(system, -system->scaleVariance, system->scaleVariance)
     );
 
-    particle.transform = r3d_matrix_scale_rotxyz_translate(
-        &particle.scale, &particle.rotation, &particle.position
-    );
+    particles->scale.x[i] = particles->baseScale.x[i] = scale.x;
+    particles->scale.y[i] = particles->baseScale.y[i] = scale.y;
+    particles->scale.z[i] = particles->baseScale.z[i] = scale.z;
 
-    particle.velocity = particle.baseVelocity = (Vector3){
-        velocity.x + r3d_randf_range(-system->velocityVariance.x, system->velocityVariance.x),
-        velocity.y + r3d_randf_range(-system->velocityVariance.y, system->velocityVariance.y),
-        velocity.z + r3d_randf_range(-system->velocityVariance.z, system->velocityVariance.z)
-    };
+    particles->velocity.x[i] = particles->baseVelocity.x[i] = velocity.x + r3d_randf_range(system, -system->velocityVariance.x, system->velocityVariance.x);
+    particles->velocity.y[i] = particles->baseVelocity.y[i] = velocity.y + r3d_randf_range(system, -system->velocityVariance.y, system->velocityVariance.y);
+    particles->velocity.z[i] = particles->baseVelocity.z[i] = velocity.z + r3d_randf_range(system, -system->velocityVariance.z, system->velocityVariance.z);
 
-    particle.angularVelocity = particle.baseAngularVelocity = (Vector3){
-        system->initialAngularVelocity.x + r3d_randf_range(-system->angularVelocityVariance.x, system->angularVelocityVariance.x),
-        system->initialAngularVelocity.y + r3d_randf_range(-system->angularVelocityVariance.y, system->angularVelocityVariance.y),
-        system->initialAngularVelocity.z + r3d_randf_range(-system->angularVelocityVariance.z, system->angularVelocityVariance.z)
-    };
+    particles->angularVelocity.x[i] = particles->baseAngularVelocity.x[i] = system->initialAngularVelocity.x + r3d_randf_range(system, -system->angularVelocityVariance.x, system->angularVelocityVariance.x);
+    particles->angularVelocity.y[i] = particles->baseAngularVelocity.y[i] = system->initialAngularVelocity.y + r3d_randf_range(system, -system->angularVelocityVariance.y, system->angularVelocityVariance.y);
+    particles->angularVelocity.z[i] = particles->baseAngularVelocity.z[i] = system->initialAngularVelocity.z + r3d_randf_range(system, -system->angularVelocityVariance.z, system->angularVelocityVariance.z);
 
-    particle.color = (Color){
-        (unsigned char)(system->initialColor.r + GetRandomValue(-system->colorVariance.r, system->colorVariance.r)),
-        (unsigned char)(system->initialColor.g + GetRandomValue(-system->colorVariance.g, system->colorVariance.g)),
-        (unsigned char)(system->initialColor.g + GetRandomValue(-system->colorVariance.b, system->colorVariance.b)),
-        (unsigned char)(system->initialColor.a + GetRandomValue(-system->colorVariance.a, system->colorVariance.a))
-    };
+    // One statement per channel, the evaluation order of initializers is unspecified
+    particles->colors[i].r = (unsigned char)(system->initialColor.r + r3d_randi_range(system, -system->colorVariance.r, system->colorVariance.r));
+    particles->colors[i].g = (unsigned char)(system->initialColor.g + r3d_randi_range(system, -system->colorVariance.g, system->colorVariance.g));
+    particles->colors[i].b = (unsigned char)(system->initialColor.b + r3d_randi_range(system, -system->colorVariance.b, system->colorVariance.b));
+    particles->colors[i].a = (unsigned char)(system->initialColor.a + r3d_randi_range(system, -system->colorVariance.a, system->colorVariance.a));
 
-    particle.baseOpacity = particle.color.a;
+    particles->baseOpacity[i] = particles->colors[i].a;
 
-    // Adding the particle to the system
-    system->particles[system->count++] = particle;
+    r3d_particle_pack_instance(particles, i);
+
+    // Particles emitted between two updates must be covered until the next one
+    if (system->autoBoundingBox) {
+        Vector3 position = { particles->position.x[i], particles->position.y[i], particles->position.z[i] };
+        system->aabb.min = Vector3Min(system->aabb.min, position);
+        system->aabb.max = Vector3Max(system->aabb.max, position);
+        system->maxScale = fmaxf(system->maxScale, fmaxf(fabsf(scale.x), fmaxf(fabsf(scale.y), fabsf(scale.z))));
+    }
 
     return true;
 }
@@ -197,104 +425,113 @@ void R3D_UpdateParticleSystem(R3D_ParticleSystem* system, float deltaTime)
         }
     }
 
-    for (int i = system->count - 1; i >= 0; i--) {
-        R3D_Particle* particle = &system->particles[i];
-
-        particle->lifetime -= deltaTime;
-        if (particle->lifetime <= 0.0f) {
-            *particle = system->particles[--system->count];
-            continue;
+    if (system->gpu) {
+        r3d_particle_gpu_update(system->gpu, system, deltaTime);
+        system->count = system->gpu->alive;
+        // GPU particles can't be read back, their bound is derived from the parameters
+        // around every position the emitter had while the alive particles were emitted
+        r3d_particle_gpu_track_origin(system, deltaTime);
+        if (system->autoBoundingBox) {
+            BoundingBox* origins = system->gpu->origins;
+            r3d_particle_system_bounds(system,
+                Vector3Min(origins[0].min, origins[1].min),
+                Vector3Max(origins[0].max, origins[1].max)
+            );
         }
+        return;
+    }
 
-        float t = 1.0f - (particle->lifetime / system->lifetime);
+    R3D_Particles* particles = &system->particles;
 
-        if (system->scaleOverLifetime) {
-            float scale = R3D_EvaluateCurve(*system->scaleOverLifetime, t);
-            particle->scale.x = particle->baseScale.x * scale;
-            particle->scale.y = particle->baseScale.y * scale;
-            particle->scale.z = particle->baseScale.z * scale;
-        }
+    /* --- Age the particles and remove the dead ones --- */
 
-        if (system->opacityOverLifetime) {
-            float scale = R3D_EvaluateCurve(*system->opacityOverLifetime, t);
-            particle->color.a = (unsigned char)Clamp(particle->baseOpacity * scale, 0.0f, 255.0f);
-        }
+    r3d_particle_add(particles->lifetime, -deltaTime, system->count);
+    system->count = r3d_particle_compact(particles, system->count);
 
-        if (system->speedOverLifetime) {
-            float scale = R3D_EvaluateCurve(*system->speedOverLifetime, t);
-            particle->velocity.x = particle->baseVelocity.x * scale;
-            particle->velocity.y = particle->baseVelocity.y * scale;
-            particle->velocity.z = particle->baseVelocity.z * scale;
-        }
+    int count = system->count;
 
-        if (system->angularVelocityOverLifetime) {
-            float scale = R3D_EvaluateCurve(*system->angularVelocityOverLifetime, t);
-            particle->angularVelocity.x = particle->baseAngularVelocity.x * scale;
-            particle->angularVelocity.y = particle->baseAngularVelocity.y * scale;
-            particle->angularVelocity.z = particle->baseAngularVelocity.z * scale;
-        }
+    /* --- Apply the curves over the lifetime, chunk by chunk to keep the factors in cache --- */
+
+    if (system->scaleOverLifetime || system->opacityOverLifetime ||
+        system->speedOverLifetime || system->angularVelocityOverLifetime)
+    {
+        float progress[R3D_PARTICLE_CHUNK_SIZE];
+        float factors[R3D_PARTICLE_CHUNK_SIZE];
+
+        for (int first = 0; first < count; first += R3D_PARTICLE_CHUNK_SIZE)
+        {
+            int n = count - first;
+            if (n > R3D_PARTICLE_CHUNK_SIZE) n = R3D_PARTICLE_CHUNK_SIZE;
 
-        particle->rotation.x += particle->angularVelocity.x * deltaTime * DEG2RAD;
-        particle->rotation.y += particle->angularVelocity.y * deltaTime * DEG2RAD;
-        particle->rotation.z += particle->angularVelocity.z * deltaTime * DEG2RAD;
+            r3d_particle_progress(progress, particles->lifetime + first, system->lifetime, n);
 
-        particle->position.x += particle->velocity.x * deltaTime;
-        particle->position.y += particle->velocity.y * deltaTime;
-        particle->position.z += particle->velocity.z * deltaTime;
+            if (system->scaleOverLifetime) {
+                r3d_particle_eval_curve(system->scaleOverLifetime, progress, factors, n);
+                r3d_particle_mul_vec3(&particles->scale, &particles->baseScale, factors, first, n);
+            }
 
-        particle->transform = r3d_matrix_scale_rotxyz_translate(
-            &particle->scale, &particle->rotation, &particle->position
-        );
+            if (system->opacityOverLifetime) {
+                r3d_particle_eval_curve(system->opacityOverLifetime, progress, factors, n);
+                for (int i = 0; i < n; i++) {
+                    particles->colors[first + i].a = (unsigned char)Clamp(particles->baseOpacity[first + i] * factors[i], 0.0f, 255.0f);
+                }
+            }
 
-        particle->velocity.x += system->gravity.x * deltaTime;
-        particle->velocity.y += system->gravity.y * deltaTime;
-        particle->velocity.z += system->gravity.z * deltaTime;
+            if (system->speedOverLifetime) {
+                r3d_particle_eval_curve(system->speedOverLifetime, progress, factors, n);
+                r3d_particle_mul_vec3(&particles->velocity, &particles->baseVelocity, factors, first, n);
+            }
+
+            if (system->angularVelocityOverLifetime) {
+                r3d_particle_eval_curve(system->angularVelocityOverLifetime, progress, factors, n);
+                r3d_particle_mul_vec3(&particles->angularVelocity, &particles->baseAngularVelocity, factors, first, n);
+            }
+        }
     }
+
+    /* --- Integrate the motion and pack the instances --- */
+
+    r3d_particle_madd(particles->rotation.x, particles->angularVelocity.x, deltaTime, DEG2RAD, count);
+    r3d_particle_madd(particles->rotation.y, particles->angularVelocity.y, deltaTime, DEG2RAD, count);
+    r3d_particle_madd(particles->rotation.z, particles->angularVelocity.z, deltaTime, DEG2RAD, count);
+
+    if (system->autoBoundingBox) {
+        r3d_particle_update_bounds(system, deltaTime);
+    }
+    else {
+        r3d_particle_madd(particles->position.x, particles->velocity.x, deltaTime, 1.0f, count);
+        r3d_particle_madd(particles->position.y, particles->velocity.y, deltaTime, 1.0f, count);
+        r3d_particle_madd(particles->position.z, particles->velocity.z, deltaTime, 1.0f, count);
+    }
+
+    r3d_particle_build_instances(particles, count);
+
+    r3d_particle_add(particles->velocity.x, system->gravity.x * deltaTime, count);
+    r3d_particle_add(particles->velocity.y, system->gravity.y * deltaTime, count);
+    r3d_particle_add(particles->velocity.z, system->gravity.z * deltaTime, count);
 }
 
-void R3D_CalculateParticleSystemBoundingBox(R3D_ParticleSystem* system)
+void R3D_UpdateParticleSystems(R3D_ParticleSystem* systems, int count, float deltaTime)
 {
-    // Initialize the AABB with extreme values (max for max bounds, min for min bounds)
-    Vector3 aabbMin = { FLT_MAX, FLT_MAX, FLT_MAX };
-    Vector3 aabbMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
-
-    // Loop over all particles in the emitter (considering the particle capacity)
-    for (int i = 0; i < system->capacity; i++) {
-        // Emit a particle for the current iteration
-        R3D_EmitParticle(system);
-
-        // Get the current particle from the emitter
-        const R3D_Particle* particle = &system->particles[i];
-
-        // Calculate the position of the particle at half its lifetime (intermediate position)
-        float halfLifetime = particle->lifetime * 0.5f;
-        Vector3 midPosition = {
-            particle->transform.m12 + particle->velocity.x * halfLifetime + 0.5f * system->gravity.x * halfLifetime * halfLifetime,
-            particle->transform.m13 + particle->velocity.y * halfLifetime + 0.5f * system->gravity.y * halfLifetime * halfLifetime,
-            particle->transform.m14 + particle->velocity.z * halfLifetime + 0.5f * system->gravity.z * halfLifetime * halfLifetime
-        };
-
-        // Calculate the position of the particle at the end of its lifetime (final position)
-        Vector3 futurePosition = {
-            particle->transform.m12 + particle->velocity.x * particle->lifetime + 0.5f * system->gravity.x * particle->lifetime * particle->lifetime,
-            particle->transform.m13 + particle->velocity.y * particle->lifetime + 0.5f * system->gravity.y * particle->lifetime * particle->lifetime,
-            particle->transform.m14 + particle->velocity.z * particle->lifetime + 0.5f * system->gravity.z * particle->lifetime * particle->lifetime
-        };
-
-        // Expand the AABB by comparing the current min and max with the calculated positions
-        // We include both the intermediate (halfway) and final (end of lifetime) positions
-        aabbMin.x = r3d_min3f(aabbMin.x, midPosition.x, futurePosition.x);
-        aabbMin.y = r3d_min3f(aabbMin.y, midPosition.y, futurePosition.y);
-        aabbMin.z = r3d_min3f(aabbMin.z, midPosition.z, futurePosition.z);
-
-        aabbMax.x = r3d_max3f(aabbMax.x, midPosition.x, futurePosition.x);
-        aabbMax.y = r3d_max3f(aabbMax.y, midPosition.y, futurePosition.y);
-        aabbMax.z = r3d_max3f(aabbMax.z, midPosition.z, futurePosition.z);
+    // Systems only touch their own data on the CPU, they can be updated by any thread in any order
+#if defined(_OPENMP)
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int i = 0; i < count; i++) {
+        if (systems[i].gpu == NULL) {
+            R3D_UpdateParticleSystem(&systems[i], deltaTime);
+        }
     }
 
-    // Clear any previous state or data in the emitter
-    system->count = 0;
+    // GPU systems need the OpenGL context, which belongs to the calling thread
+    for (int i = 0; i < count; i++) {
+        if (systems[i].gpu != NULL) {
+            R3D_UpdateParticleSystem(&systems[i], deltaTime);
+        }
+    }
+}
 
-    // Update the particle system's AABB with the calculated bounds
-    system->aabb = (BoundingBox){ aabbMin, aabbMax };
+void R3D_CalculateParticleSystemBoundingBox(R3D_ParticleSystem* system)
+{
+    r3d_particle_system_bounds(system, system->position, system->position);
 }
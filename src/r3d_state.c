@@ -538,6 +538,8 @@ void r3d_shaders_load(void)
 
     r3d_shader_load_raster_geometry();
     r3d_shader_load_raster_geometry_inst();
+    r3d_shader_load_raster_impostor();
+    r3d_shader_load_raster_impostor_inst();
     r3d_shader_load_raster_forward();
     r3d_shader_load_raster_forward_inst();
     r3d_shader_load_raster_skybox();
@@ -546,6 +548,9 @@ void r3d_shaders_load(void)
     r3d_shader_load_raster_depth_inst();
     r3d_shader_load_raster_depth_cube();
     r3d_shader_load_raster_depth_cube_inst();
+    r3d_shader_load_raster_skinning();
+    r3d_shader_load_raster_particles();
+    r3d_shader_load_raster_cull();
 
     /* --- Screen shader passes --- */
 
@@ -597,8 +602,11 @@ void r3d_shaders_unload(void)
     rlUnloadShaderProgram(R3D.shader.generate.prefilter.id);
 
     // Unload raster shaders
-    rlUnloadShaderProgram(R3D.shader.raster.geometry.id);
+    rlUnloadShaderProgram(R3D.shader.raster.geometry[R3D_SHADER_GEOMETRY_BASE].id);
+    rlUnloadShaderProgram(R3D.shader.raster.geometry[R3D_SHADER_GEOMETRY_DITHER].id);
     rlUnloadShaderProgram(R3D.shader.raster.geometryInst.id);
+    rlUnloadShaderProgram(R3D.shader.raster.impostor.id);
+    rlUnloadShaderProgram(R3D.shader.raster.impostorInst.id);
     rlUnloadShaderProgram(R3D.shader.raster.forward.id);
     rlUnloadShaderProgram(R3D.shader.raster.forwardInst.id);
     rlUnloadShaderProgram(R3D.shader.raster.skybox.id);
@@ -607,6 +615,9 @@ void r3d_shaders_unload(void)
     rlUnloadShaderProgram(R3D.shader.raster.depthInst.id);
     rlUnloadShaderProgram(R3D.shader.raster.depthCube.id);
     rlUnloadShaderProgram(R3D.shader.raster.depthCubeInst.id);
+    rlUnloadShaderProgram(R3D.shader.raster.skinning.id);
+    rlUnloadShaderProgram(R3D.shader.raster.particles.id);
+    rlUnloadShaderProgram(R3D.shader.raster.cull.id);
 
     // Unload screen shaders
     rlUnloadShaderProgram(R3D.shader.screen.ambientIbl.id);
@@ -1111,37 +1122,50 @@ void r3d_shader_load_generate_prefilter(void)
     r3d_shader_disable();
 }
 
+static void r3d_shader_load_raster_geometry_variant(r3d_shader_geometry_variant_t variant, const char* fsCode)
+{
+    R3D.shader.raster.geometry[variant].id = rlLoadShaderCode(GEOMETRY_VERT, fsCode);
+
+    r3d_shader_get_location(raster.geometry[variant], uTexBoneMatrices);
+    r3d_shader_get_location(raster.geometry[variant], uBoneOffset);
+    r3d_shader_get_location(raster.geometry[variant], uUseSkinning);
+    r3d_shader_get_location(raster.geometry[variant], uMatNormal);
+    r3d_shader_get_location(raster.geometry[variant], uMatModel);
+    r3d_shader_get_location(raster.geometry[variant], uMatMVP);
+    r3d_shader_get_location(raster.geometry[variant], uTexCoordOffset);
+    r3d_shader_get_location(raster.geometry[variant], uTexCoordScale);
+    r3d_shader_get_location(raster.geometry[variant], uTexAlbedo);
+    r3d_shader_get_location(raster.geometry[variant], uTexNormal);
+    r3d_shader_get_location(raster.geometry[variant], uTexEmission);
+    r3d_shader_get_location(raster.geometry[variant], uTexORM);
+    r3d_shader_get_location(raster.geometry[variant], uEmissionEnergy);
+    r3d_shader_get_location(raster.geometry[variant], uNormalScale);
+    r3d_shader_get_location(raster.geometry[variant], uOcclusion);
+    r3d_shader_get_location(raster.geometry[variant], uRoughness);
+    r3d_shader_get_location(raster.geometry[variant], uMetalness);
+    r3d_shader_get_location(raster.geometry[variant], uAlbedoColor);
+    r3d_shader_get_location(raster.geometry[variant], uEmissionColor);
+    r3d_shader_get_location(raster.geometry[variant], uDitherFade);
+
+    r3d_shader_enable(raster.geometry[variant]);
+    r3d_shader_set_samplerBuffer_slot(raster.geometry[variant], uTexBoneMatrices, 8);
+    r3d_shader_set_sampler2D_slot(raster.geometry[variant], uTexAlbedo, 0);
+    r3d_shader_set_sampler2D_slot(raster.geometry[variant], uTexNormal, 1);
+    r3d_shader_set_sampler2D_slot(raster.geometry[variant], uTexEmission, 2);
+    r3d_shader_set_sampler2D_slot(raster.geometry[variant], uTexORM, 3);
+    r3d_shader_disable();
+}
+
 void r3d_shader_load_raster_geometry(void)
 {
-    R3D.shader.raster.geometry.id = rlLoadShaderCode(
-        GEOMETRY_VERT, GEOMETRY_FRAG
-    );
+    r3d_shader_load_raster_geometry_variant(R3D_SHADER_GEOMETRY_BASE, GEOMETRY_FRAG);
 
-    r3d_shader_get_location(raster.geometry, uBoneMatrices);
-    r3d_shader_get_location(raster.geometry, uUseSkinning);
-    r3d_shader_get_location(raster.geometry, uMatNormal);
-    r3d_shader_get_location(raster.geometry, uMatModel);
-    r3d_shader_get_location(raster.geometry, uMatMVP);
-    r3d_shader_get_location(raster.geometry, uTexCoordOffset);
-    r3d_shader_get_location(raster.geometry, uTexCoordScale);
-    r3d_shader_get_location(raster.geometry, uTexAlbedo);
-    r3d_shader_get_location(raster.geometry, uTexNormal);
-    r3d_shader_get_location(raster.geometry, uTexEmission);
-    r3d_shader_get_location(raster.geometry, uTexORM);
-    r3d_shader_get_location(raster.geometry, uEmissionEnergy);
-    r3d_shader_get_location(raster.geometry, uNormalScale);
-    r3d_shader_get_location(raster.geometry, uOcclusion);
-    r3d_shader_get_location(raster.geometry, uRoughness);
-    r3d_shader_get_location(raster.geometry, uMetalness);
-    r3d_shader_get_location(raster.geometry, uAlbedoColor);
-    r3d_shader_get_location(raster.geometry, uEmissionColor);
-
-    r3d_shader_enable(raster.geometry);
-    r3d_shader_set_sampler2D_slot(raster.geometry, uTexAlbedo, 0);
-    r3d_shader_set_sampler2D_slot(raster.geometry, uTexNormal, 1);
-    r3d_shader_set_sampler2D_slot(raster.geometry, uTexEmission, 2);
-    r3d_shader_set_sampler2D_slot(raster.geometry, uTexORM, 3);
-    r3d_shader_disable();
+    // Variant used by draws fading with an impostor or another level of detail,
+    // the base shader never discards so opaque geometry keeps early depth testing
+    const char* defines[] = { "#define DITHER" };
+    char* fsCode = r3d_shader_inject_defines(GEOMETRY_FRAG, defines, 1);
+    r3d_shader_load_raster_geometry_variant(R3D_SHADER_GEOMETRY_DITHER, fsCode);
+    RL_FREE(fsCode);
 }
 
 void r3d_shader_load_raster_geometry_inst(void)
@@ -1150,13 +1174,20 @@ void r3d_shader_load_raster_geometry_inst(void)
         GEOMETRY_INSTANCED_VERT, GEOMETRY_FRAG
     );
 
-    r3d_shader_get_location(raster.geometryInst, uBoneMatrices);
+    r3d_shader_get_location(raster.geometryInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.geometryInst, uBoneOffset);
     r3d_shader_get_location(raster.geometryInst, uUseSkinning);
+    r3d_shader_get_location(raster.geometryInst, uUseInstanceAnimation);
+    r3d_shader_get_location(raster.geometryInst, uPackedInstances);
+    r3d_shader_get_location(raster.geometryInst, uTexVertexAnim);
+    r3d_shader_get_location(raster.geometryInst, uVertexAnimBase);
+    r3d_shader_get_location(raster.geometryInst, uUseVertexAnimation);
     r3d_shader_get_location(raster.geometryInst, uMatInvView);
     r3d_shader_get_location(raster.geometryInst, uMatModel);
     r3d_shader_get_location(raster.geometryInst, uMatVP);
     r3d_shader_get_location(raster.geometryInst, uTexCoordOffset);
     r3d_shader_get_location(raster.geometryInst, uTexCoordScale);
+    r3d_shader_get_location(raster.geometryInst, uSpriteFrameCount);
     r3d_shader_get_location(raster.geometryInst, uBillboardMode);
     r3d_shader_get_location(raster.geometryInst, uTexAlbedo);
     r3d_shader_get_location(raster.geometryInst, uTexNormal);
@@ -1171,6 +1202,8 @@ void r3d_shader_load_raster_geometry_inst(void)
     r3d_shader_get_location(raster.geometryInst, uEmissionColor);
 
     r3d_shader_enable(raster.geometryInst);
+    r3d_shader_set_samplerBuffer_slot(raster.geometryInst, uTexBoneMatrices, 8);
+    r3d_shader_set_samplerBuffer_slot(raster.geometryInst, uTexVertexAnim, 9);
     r3d_shader_set_sampler2D_slot(raster.geometryInst, uTexAlbedo, 0);
     r3d_shader_set_sampler2D_slot(raster.geometryInst, uTexNormal, 1);
     r3d_shader_set_sampler2D_slot(raster.geometryInst, uTexEmission, 2);
@@ -1178,6 +1211,63 @@ void r3d_shader_load_raster_geometry_inst(void)
     r3d_shader_disable();
 }
 
+void r3d_shader_load_raster_impostor(void)
+{
+    R3D.shader.raster.impostor.id = rlLoadShaderCode(
+        IMPOSTOR_VERT, IMPOSTOR_FRAG
+    );
+
+    r3d_shader_get_location(raster.impostor, uMatNormal);
+    r3d_shader_get_location(raster.impostor, uMatModel);
+    r3d_shader_get_location(raster.impostor, uMatVP);
+    r3d_shader_get_location(raster.impostor, uViewPosition);
+    r3d_shader_get_location(raster.impostor, uCenter);
+    r3d_shader_get_location(raster.impostor, uRadius);
+    r3d_shader_get_location(raster.impostor, uFrames);
+    r3d_shader_get_location(raster.impostor, uTexAlbedo);
+    r3d_shader_get_location(raster.impostor, uTexEmission);
+    r3d_shader_get_location(raster.impostor, uTexNormal);
+    r3d_shader_get_location(raster.impostor, uTexORM);
+    r3d_shader_get_location(raster.impostor, uTexDepth);
+    r3d_shader_get_location(raster.impostor, uDitherFade);
+
+    r3d_shader_enable(raster.impostor);
+    r3d_shader_set_sampler2D_slot(raster.impostor, uTexAlbedo, 0);
+    r3d_shader_set_sampler2D_slot(raster.impostor, uTexEmission, 1);
+    r3d_shader_set_sampler2D_slot(raster.impostor, uTexNormal, 2);
+    r3d_shader_set_sampler2D_slot(raster.impostor, uTexORM, 3);
+    r3d_shader_set_sampler2D_slot(raster.impostor, uTexDepth, 4);
+    r3d_shader_disable();
+}
+
+void r3d_shader_load_raster_impostor_inst(void)
+{
+    R3D.shader.raster.impostorInst.id = rlLoadShaderCode(
+        IMPOSTOR_INSTANCED_VERT, IMPOSTOR_FRAG
+    );
+
+    r3d_shader_get_location(raster.impostorInst, uMatModel);
+    r3d_shader_get_location(raster.impostorInst, uMatVP);
+    r3d_shader_get_location(raster.impostorInst, uViewPosition);
+    r3d_shader_get_location(raster.impostorInst, uCenter);
+    r3d_shader_get_location(raster.impostorInst, uRadius);
+    r3d_shader_get_location(raster.impostorInst, uFrames);
+    r3d_shader_get_location(raster.impostorInst, uTexAlbedo);
+    r3d_shader_get_location(raster.impostorInst, uTexEmission);
+    r3d_shader_get_location(raster.impostorInst, uTexNormal);
+    r3d_shader_get_location(raster.impostorInst, uTexORM);
+    r3d_shader_get_location(raster.impostorInst, uTexDepth);
+    r3d_shader_get_location(raster.impostorInst, uDitherFade);
+
+    r3d_shader_enable(raster.impostorInst);
+    r3d_shader_set_sampler2D_slot(raster.impostorInst, uTexAlbedo, 0);
+    r3d_shader_set_sampler2D_slot(raster.impostorInst, uTexEmission, 1);
+    r3d_shader_set_sampler2D_slot(raster.impostorInst, uTexNormal, 2);
+    r3d_shader_set_sampler2D_slot(raster.impostorInst, uTexORM, 3);
+    r3d_shader_set_sampler2D_slot(raster.impostorInst, uTexDepth, 4);
+    r3d_shader_disable();
+}
+
 void r3d_shader_load_raster_forward(void)
 {
     R3D.shader.raster.forward.id = rlLoadShaderCode(
@@ -1186,7 +1276,8 @@ void r3d_shader_load_raster_forward(void)
 
     r3d_shader_raster_forward_t* shader = &R3D.shader.raster.forward;
 
-    r3d_shader_get_location(raster.forward, uBoneMatrices);
+    r3d_shader_get_location(raster.forward, uTexBoneMatrices);
+    r3d_shader_get_location(raster.forward, uBoneOffset);
     r3d_shader_get_location(raster.forward, uUseSkinning);
     r3d_shader_get_location(raster.forward, uMatNormal);
     r3d_shader_get_location(raster.forward, uMatModel);
@@ -1217,6 +1308,7 @@ void r3d_shader_load_raster_forward(void)
     r3d_shader_get_location(raster.forward, uViewPosition);
 
     r3d_shader_enable(raster.forward);
+    r3d_shader_set_samplerBuffer_slot(raster.forward, uTexBoneMatrices, 8);
 
     r3d_shader_set_sampler2D_slot(raster.forward, uTexAlbedo, 0);
     r3d_shader_set_sampler2D_slot(raster.forward, uTexEmission, 1);
@@ -1265,13 +1357,20 @@ void r3d_shader_load_raster_forward_inst(void)
 
     r3d_shader_raster_forward_inst_t* shader = &R3D.shader.raster.forwardInst;
 
-    r3d_shader_get_location(raster.forwardInst, uBoneMatrices);
+    r3d_shader_get_location(raster.forwardInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.forwardInst, uBoneOffset);
     r3d_shader_get_location(raster.forwardInst, uUseSkinning);
+    r3d_shader_get_location(raster.forwardInst, uUseInstanceAnimation);
+    r3d_shader_get_location(raster.forwardInst, uPackedInstances);
+    r3d_shader_get_location(raster.forwardInst, uTexVertexAnim);
+    r3d_shader_get_location(raster.forwardInst, uVertexAnimBase);
+    r3d_shader_get_location(raster.forwardInst, uUseVertexAnimation);
     r3d_shader_get_location(raster.forwardInst, uMatInvView);
     r3d_shader_get_location(raster.forwardInst, uMatModel);
     r3d_shader_get_location(raster.forwardInst, uMatVP);
     r3d_shader_get_location(raster.forwardInst, uTexCoordOffset);
     r3d_shader_get_location(raster.forwardInst, uTexCoordScale);
+    r3d_shader_get_location(raster.forwardInst, uSpriteFrameCount);
     r3d_shader_get_location(raster.forwardInst, uBillboardMode);
     r3d_shader_get_location(raster.forwardInst, uTexAlbedo);
     r3d_shader_get_location(raster.forwardInst, uTexEmission);
@@ -1297,6 +1396,8 @@ void r3d_shader_load_raster_forward_inst(void)
     r3d_shader_get_location(raster.forwardInst, uViewPosition);
 
     r3d_shader_enable(raster.forwardInst);
+    r3d_shader_set_samplerBuffer_slot(raster.forwardInst, uTexBoneMatrices, 8);
+    r3d_shader_set_samplerBuffer_slot(raster.forwardInst, uTexVertexAnim, 9);
 
     r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexAlbedo, 0);
     r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexEmission, 1);
@@ -1369,12 +1470,17 @@ void r3d_shader_load_raster_depth(void)
         DEPTH_VERT, DEPTH_FRAG
     );
 
-    r3d_shader_get_location(raster.depth, uBoneMatrices);
+    r3d_shader_get_location(raster.depth, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depth, uBoneOffset);
     r3d_shader_get_location(raster.depth, uUseSkinning);
     r3d_shader_get_location(raster.depth, uMatMVP);
     r3d_shader_get_location(raster.depth, uAlpha);
     r3d_shader_get_location(raster.depth, uTexAlbedo);
     r3d_shader_get_location(raster.depth, uAlphaCutoff);
+
+    r3d_shader_enable(raster.depth);
+    r3d_shader_set_samplerBuffer_slot(raster.depth, uTexBoneMatrices, 8);
+    r3d_shader_disable();
 }
 
 void r3d_shader_load_raster_depth_inst(void)
@@ -1383,15 +1489,29 @@ void r3d_shader_load_raster_depth_inst(void)
         DEPTH_INSTANCED_VERT, DEPTH_FRAG
     );
 
-    r3d_shader_get_location(raster.depthInst, uBoneMatrices);
+    r3d_shader_get_location(raster.depthInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depthInst, uBoneOffset);
     r3d_shader_get_location(raster.depthInst, uUseSkinning);
+    r3d_shader_get_location(raster.depthInst, uUseInstanceAnimation);
+    r3d_shader_get_location(raster.depthInst, uPackedInstances);
+    r3d_shader_get_location(raster.depthInst, uTexVertexAnim);
+    r3d_shader_get_location(raster.depthInst, uVertexAnimBase);
+    r3d_shader_get_location(raster.depthInst, uUseVertexAnimation);
     r3d_shader_get_location(raster.depthInst, uMatInvView);
     r3d_shader_get_location(raster.depthInst, uMatModel);
     r3d_shader_get_location(raster.depthInst, uMatVP);
     r3d_shader_get_location(raster.depthInst, uBillboardMode);
+    r3d_shader_get_location(raster.depthInst, uTexCoordOffset);
+    r3d_shader_get_location(raster.depthInst, uTexCoordScale);
+    r3d_shader_get_location(raster.depthInst, uSpriteFrameCount);
     r3d_shader_get_location(raster.depthInst, uAlpha);
     r3d_shader_get_location(raster.depthInst, uTexAlbedo);
     r3d_shader_get_location(raster.depthInst, uAlphaCutoff);
+
+    r3d_shader_enable(raster.depthInst);
+    r3d_shader_set_samplerBuffer_slot(raster.depthInst, uTexBoneMatrices, 8);
+    r3d_shader_set_samplerBuffer_slot(raster.depthInst, uTexVertexAnim, 9);
+    r3d_shader_disable();
 }
 
 void r3d_shader_load_raster_depth_cube(void)
@@ -1400,7 +1520,8 @@ void r3d_shader_load_raster_depth_cube(void)
         DEPTH_CUBE_VERT, DEPTH_CUBE_FRAG
     );
 
-    r3d_shader_get_location(raster.depthCube, uBoneMatrices);
+    r3d_shader_get_location(raster.depthCube, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depthCube, uBoneOffset);
     r3d_shader_get_location(raster.depthCube, uUseSkinning);
     r3d_shader_get_location(raster.depthCube, uViewPosition);
     r3d_shader_get_location(raster.depthCube, uMatModel);
@@ -1409,6 +1530,10 @@ void r3d_shader_load_raster_depth_cube(void)
     r3d_shader_get_location(raster.depthCube, uAlpha);
     r3d_shader_get_location(raster.depthCube, uTexAlbedo);
     r3d_shader_get_location(raster.depthCube, uAlphaCutoff);
+
+    r3d_shader_enable(raster.depthCube);
+    r3d_shader_set_samplerBuffer_slot(raster.depthCube, uTexBoneMatrices, 8);
+    r3d_shader_disable();
 }
 
 void r3d_shader_load_raster_depth_cube_inst(void)
@@ -1417,17 +1542,159 @@ void r3d_shader_load_raster_depth_cube_inst(void)
         DEPTH_CUBE_INSTANCED_VERT, DEPTH_CUBE_FRAG
     );
 
-    r3d_shader_get_location(raster.depthCubeInst, uBoneMatrices);
+    r3d_shader_get_location(raster.depthCubeInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depthCubeInst, uBoneOffset);
     r3d_shader_get_location(raster.depthCubeInst, uUseSkinning);
+    r3d_shader_get_location(raster.depthCubeInst, uUseInstanceAnimation);
+    r3d_shader_get_location(raster.depthCubeInst, uPackedInstances);
+    r3d_shader_get_location(raster.depthCubeInst, uTexVertexAnim);
+    r3d_shader_get_location(raster.depthCubeInst, uVertexAnimBase);
+    r3d_shader_get_location(raster.depthCubeInst, uUseVertexAnimation);
     r3d_shader_get_location(raster.depthCubeInst, uViewPosition);
     r3d_shader_get_location(raster.depthCubeInst, uMatInvView);
     r3d_shader_get_location(raster.depthCubeInst, uMatModel);
     r3d_shader_get_location(raster.depthCubeInst, uMatVP);
     r3d_shader_get_location(raster.depthCubeInst, uFar);
     r3d_shader_get_location(raster.depthCubeInst, uBillboardMode);
+    r3d_shader_get_location(raster.depthCubeInst, uTexCoordOffset);
+    r3d_shader_get_location(raster.depthCubeInst, uTexCoordScale);
+    r3d_shader_get_location(raster.depthCubeInst, uSpriteFrameCount);
     r3d_shader_get_location(raster.depthCubeInst, uAlpha);
     r3d_shader_get_location(raster.depthCubeInst, uTexAlbedo);
     r3d_shader_get_location(raster.depthCubeInst, uAlphaCutoff);
+
+    r3d_shader_enable(raster.depthCubeInst);
+    r3d_shader_set_samplerBuffer_slot(raster.depthCubeInst, uTexBoneMatrices, 8);
+    r3d_shader_set_samplerBuffer_slot(raster.depthCubeInst, uTexVertexAnim, 9);
+    r3d_shader_disable();
+}
+
+void r3d_shader_load_raster_skinning(void)
+{
+    // The varyings captured by transform feedback must be declared before linking,
+    // which is not possible through 'rlLoadShaderCode'
+    static const char* varyings[] = { "vPosition", "vNormal", "vTangent" };
+
+    unsigned int vs = rlCompileShader(SKINNING_VERT, GL_VERTEX_SHADER);
+    if (vs == 0) return;
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glTransformFeedbackVaryings(program, 3, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+    glDetachShader(program, vs);
+    glDeleteShader(vs);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        TraceLog(LOG_WARNING, "R3D: Failed to link the skinning shader; Pre-skinning will be unavailable");
+        glDeleteProgram(program);
+        return;
+    }
+
+    R3D.shader.raster.skinning.id = program;
+
+    r3d_shader_get_location(raster.skinning, uTexBoneMatrices);
+    r3d_shader_get_location(raster.skinning, uBoneOffset);
+
+    r3d_shader_enable(raster.skinning);
+    r3d_shader_set_samplerBuffer_slot(raster.skinning, uTexBoneMatrices, 8);
+    r3d_shader_disable();
+}
+
+void r3d_shader_load_raster_particles(void)
+{
+    // Same layout as the attributes, see 'R3D_ParticleGPU'
+    static const char* varyings[] = {
+        "vTransform0", "vTransform1", "vTransform2", "vTransform3",
+        "vColor", "vPositionLife", "vVelocity", "vBaseVelocity",
+        "vRotation", "vBaseAngularVelocity", "vBaseScaleOpacity"
+    };
+
+    unsigned int vs = rlCompileShader(PARTICLES_VERT, GL_VERTEX_SHADER);
+    if (vs == 0) return;
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glTransformFeedbackVaryings(program, 11, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+    glDetachShader(program, vs);
+    glDeleteShader(vs);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        TraceLog(LOG_WARNING, "R3D: Failed to link the particle shader; GPU particle systems will be unavailable");
+        glDeleteProgram(program);
+        return;
+    }
+
+    R3D.shader.raster.particles.id = program;
+
+    r3d_shader_get_location(raster.particles, uDeltaTime);
+    r3d_shader_get_location(raster.particles, uGravity);
+    r3d_shader_get_location(raster.particles, uCapacity);
+    r3d_shader_get_location(raster.particles, uEmitFirst);
+    r3d_shader_get_location(raster.particles, uEmitCount);
+    r3d_shader_get_location(raster.particles, uSeed);
+    r3d_shader_get_location(raster.particles, uPosition);
+    r3d_shader_get_location(raster.particles, uInitialScale);
+    r3d_shader_get_location(raster.particles, uScaleVariance);
+    r3d_shader_get_location(raster.particles, uInitialRotation);
+    r3d_shader_get_location(raster.particles, uRotationVariance);
+    r3d_shader_get_location(raster.particles, uInitialColor);
+    r3d_shader_get_location(raster.particles, uColorVariance);
+    r3d_shader_get_location(raster.particles, uInitialVelocity);
+    r3d_shader_get_location(raster.particles, uVelocityVariance);
+    r3d_shader_get_location(raster.particles, uInitialAngularVelocity);
+    r3d_shader_get_location(raster.particles, uAngularVelocityVariance);
+    r3d_shader_get_location(raster.particles, uLifetime);
+    r3d_shader_get_location(raster.particles, uLifetimeVariance);
+    r3d_shader_get_location(raster.particles, uSpreadAngle);
+    r3d_shader_get_location(raster.particles, uTexCurves);
+    r3d_shader_get_location(raster.particles, uCurveMask);
+
+    r3d_shader_enable(raster.particles);
+    r3d_shader_set_sampler1D_slot(raster.particles, uTexCurves, 0);
+    r3d_shader_disable();
+}
+
+void r3d_shader_load_raster_cull(void)
+{
+    // Compute shaders and the buffers they write require OpenGL 4.3
+    if (!GLAD_GL_VERSION_4_3) {
+        TraceLog(LOG_INFO, "R3D: OpenGL 4.3 is not supported; GPU instance culling will be unavailable");
+        return;
+    }
+
+    unsigned int cs = rlCompileShader(CULL_INSTANCES_COMP, GL_COMPUTE_SHADER);
+    if (cs == 0) return;
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, cs);
+    glLinkProgram(program);
+    glDetachShader(program, cs);
+    glDeleteShader(cs);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        TraceLog(LOG_WARNING, "R3D: Failed to link the culling shader; GPU instance culling will be unavailable");
+        glDeleteProgram(program);
+        return;
+    }
+
+    R3D.shader.raster.cull.id = program;
+
+    r3d_shader_get_location(raster.cull, uMatModel);
+    r3d_shader_get_location(raster.cull, uMatVP);
+    r3d_shader_get_location(raster.cull, uAabbMin);
+    r3d_shader_get_location(raster.cull, uAabbMax);
+    r3d_shader_get_location(raster.cull, uBillboard);
+    r3d_shader_get_location(raster.cull, uInstanceCount);
+    r3d_shader_get_location(raster.cull, uColorOffset);
+    r3d_shader_get_location(raster.cull, uParamsOffset);
 }
 
 void r3d_shader_load_screen_ssao(void)
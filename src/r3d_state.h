@@ -157,9 +157,17 @@ extern struct R3D_State {
         r3d_array_t aDrawForward;           //< Contains all forward draw calls
         r3d_array_t aDrawForwardInst;       //< Contains all forward instanced draw calls
 
+        r3d_array_t aDrawImpostor;          //< Contains all impostor draw calls (always deferred)
+        r3d_array_t aDrawImpostorInst;      //< Contains all impostor instanced draw calls (always deferred)
+
         r3d_registry_t rLights;             //< Contains all created lights
         r3d_array_t aLightBatch;            //< Contains all lights visible on screen
 
+        r3d_array_t aBonePalette;           //< Contains the skinning matrices of all animated models drawn this frame
+        r3d_array_t aInstanceAnim;          //< Contains the animation states of the instances drawn with baked animations this frame
+
+        r3d_array_t aSpriteBatch;           //< Contains the sprite batches, each gathering the sprites of one material drawn this frame
+
     } container;
 
     // Internal shaders
@@ -177,8 +185,10 @@ extern struct R3D_State {
 
         // Raster shaders
         struct {
-            r3d_shader_raster_geometry_t geometry;
+            r3d_shader_raster_geometry_t geometry[R3D_SHADER_GEOMETRY_VARIANT_COUNT];
             r3d_shader_raster_geometry_inst_t geometryInst;
+            r3d_shader_raster_impostor_t impostor;
+            r3d_shader_raster_impostor_inst_t impostorInst;
             r3d_shader_raster_forward_t forward;
             r3d_shader_raster_forward_inst_t forwardInst;
             r3d_shader_raster_skybox_t skybox;
@@ -187,6 +197,9 @@ extern struct R3D_State {
             r3d_shader_raster_depth_inst_t depthInst;
             r3d_shader_raster_depth_cube_t depthCube;
             r3d_shader_raster_depth_cube_inst_t depthCubeInst;
+            r3d_shader_raster_skinning_t skinning;
+            r3d_shader_raster_particles_t particles;
+            r3d_shader_raster_cull_t cull;
         } raster;
 
         // Screen shaders
@@ -280,6 +293,16 @@ extern struct R3D_State {
         r3d_primitive_t cube;
     } primitive;
 
+    // Skinning data shared by all passes
+    struct {
+        GLuint paletteBuffer;   //< Buffer storing 'aBonePalette' for the frame
+        GLuint paletteTexture;  //< RGBA32F or RGBA16F buffer texture over 'paletteBuffer', three texels per bone
+        size_t paletteCapacity; //< Capacity of 'paletteBuffer' in bones
+        bool paletteHalf;       //< Whether 'paletteBuffer' currently stores half floats
+        GLuint vertexBuffer;    //< Vertices skinned once per frame by transform feedback (see R3D_FLAG_PRESKINNING)
+        size_t vertexCapacity;  //< Capacity of 'vertexBuffer' in vertices
+    } skinning;
+
     // State data
     struct {
 
@@ -302,6 +325,22 @@ extern struct R3D_State {
             BoundingBox bounds;
         } scene;
 
+        // Level of detail selection
+        struct {
+            float threshold;    //< Maximum projected error in pixels
+            float fadeRange;    //< Cross-fade range relative to the threshold (0 = disabled)
+            int shadowBias;     //< Additional levels skipped in shadow passes
+        } lod;
+
+        // Level of detail of skeletal animations
+        struct {
+            float fullRatePixels;   //< Projected height below which animations are updated less often (0 = disabled)
+            int maxInterval;        //< Maximum number of frames between two updates
+            float reducedPixels;    //< Projected height below which leaf bones are frozen (0 = disabled)
+            int reducedLevels;      //< Number of bone levels, from the leaves, frozen by reduced skeletons
+            unsigned int tick;      //< Incremented every frame to stagger the updates of the models
+        } animLod;
+
         // Resolution
         struct {
             int width;
@@ -314,6 +353,10 @@ extern struct R3D_State {
         struct {
             struct aiPropertyStore* aiProps;   //< Assimp import properties (scale, etc.)
             TextureFilter textureFilter;       //< Texture filter used by R3D during model loading
+            bool mergeMeshes;                  //< Merge static meshes sharing the same material during model loading
+            bool buildMeshlets;                //< Partition loaded meshes into meshlets before uploading them
+            int lodCount;                      //< Number of levels of detail generated for loaded meshes
+            float animTolerance;               //< Maximum error of the keyframe reduction of loaded animations
         } loading;
 
         // Miscellaneous flags
@@ -368,6 +411,8 @@ void r3d_shader_load_generate_irradiance_convolution(void);
 void r3d_shader_load_generate_prefilter(void);
 void r3d_shader_load_raster_geometry(void);
 void r3d_shader_load_raster_geometry_inst(void);
+void r3d_shader_load_raster_impostor(void);
+void r3d_shader_load_raster_impostor_inst(void);
 void r3d_shader_load_raster_forward(void);
 void r3d_shader_load_raster_forward_inst(void);
 void r3d_shader_load_raster_skybox(void);
@@ -376,6 +421,9 @@ void r3d_shader_load_raster_depth(void);
 void r3d_shader_load_raster_depth_inst(void);
 void r3d_shader_load_raster_depth_cube(void);
 void r3d_shader_load_raster_depth_cube_inst(void);
+void r3d_shader_load_raster_skinning(void);
+void r3d_shader_load_raster_particles(void);
+void r3d_shader_load_raster_cull(void);
 void r3d_shader_load_screen_ssao(void);
 void r3d_shader_load_screen_ambient_ibl(void);
 void r3d_shader_load_screen_ambient(void);
@@ -463,6 +511,17 @@ do {
     }                                                                                           \
 } while(0)
 
+#define r3d_shader_set_samplerBuffer_slot(shader_name, uniform, value)                          \
+do {                                                                                            \
+    if (R3D.shader.shader_name.uniform.slotBuffer != (value)) {                                 \
+        R3D.shader.shader_name.uniform.slotBuffer = (value);                                    \
+        glUniform1i(                                                                            \
+            R3D.shader.shader_name.uniform.loc,                                                 \
+            R3D.shader.shader_name.uniform.slotBuffer                                           \
+        );                                                                                      \
+    }                                                                                           \
+} while(0)
+
 #define r3d_shader_bind_sampler1D(shader_name, uniform, texId)                                  \
 do {                                                                                            \
     glActiveTexture(GL_TEXTURE0 + R3D.shader.shader_name.uniform.slot1D);                       \
@@ -488,6 +547,12 @@ do {
     glBindTexture(GL_TEXTURE_CUBE_MAP, (texId));                                                \
 } while(0)
 
+#define r3d_shader_bind_samplerBuffer(shader_name, uniform, texId)                              \
+do {                                                                                            \
+    glActiveTexture(GL_TEXTURE0 + R3D.shader.shader_name.uniform.slotBuffer);                   \
+    glBindTexture(GL_TEXTURE_BUFFER, (texId));                                                  \
+} while(0)
+
 #define r3d_shader_unbind_sampler1D(shader_name, uniform)                                       \
 do {                                                                                            \
     glActiveTexture(GL_TEXTURE0 + R3D.shader.shader_name.uniform.slot1D);                       \